@@ -4,6 +4,7 @@
  *
  * Build: cd build && cmake .. && make guli_test
  * Run: ./bin/guli_test  (shaders copied to build/bin/shaders/)
+ *      ./bin/guli_test --check-reload  (OpenGL: exits 0 if editing a shader file hot-reloads it)
  */
  #include <guli/guli.h>
  #include <stdio.h>
@@ -11,21 +12,76 @@
  
  static const char* kWindowTitle = "Guli Ripple - SDF sinewave (ESC to close)";
  
- int main(void)
+#if defined(GULI_BACKEND_OPENGL)
+/* --check-reload: load a copy of the fragment shader with hot reload on, edit the copy,
+   and expect the shader to be rebuilt within a few frames. */
+static int CheckHotReload(const char* vertPath, const char* fragPath)
+{
+    const char* copyPath = "ripple_reload_check.frag.glsl";
+    char buf[4096];
+    size_t n = 0;
+    FILE* in = fopen(fragPath, "rb");
+    FILE* out = fopen(copyPath, "wb");
+    int ok = in && out;
+    while (ok && (n = fread(buf, 1, sizeof(buf), in)) > 0)
+        ok = fwrite(buf, 1, n, out) == n;
+    if (in) fclose(in);
+    if (out) fclose(out);
+
+    GuliShader* shader = NULL;
+    GuliShaderReloadStats stats = {0};
+    if (ok && GuliShaderHotReloadEnable())
+    {
+        shader = GuliShaderLoadFromFile(vertPath, copyPath);
+        GuliShaderHotReloadGetStats(&stats);
+        ok = shader && stats.watched == 1;
+    }
+    else ok = 0;
+
+    /* Growing the file changes its size, so the stat fallback sees it too */
+    out = ok ? fopen(copyPath, "ab") : NULL;
+    if (out)
+    {
+        fputs("\n// edited by --check-reload\n", out);
+        fclose(out);
+    }
+    for (int frame = 0; ok && frame < 120 && !stats.reloads; frame++)
+    {
+        GuliBeginDraw();
+        GuliEndDraw();
+        GuliShaderHotReloadGetStats(&stats);
+    }
+    printf("hot reload: watched %u, reloads %u, failures %u\n", stats.watched, stats.reloads, stats.failures);
+
+    if (shader) GuliShaderUnload(shader);
+    GuliShaderHotReloadDisable();
+    remove(copyPath);
+    return ok && stats.reloads > 0 && !stats.failures;
+}
+#endif
+
+ int main(int argc, char** argv)
  {
      GuliShader* shader = NULL;
      int exit_code = 1;
+     const int check_reload = argc > 1 && strcmp(argv[1], "--check-reload") == 0;
  
      if (GuliInit(800, 600, kWindowTitle) != GULI_ERROR_SUCCESS)
          return 1;
  
  #if defined(GULI_BACKEND_METAL)
+    (void)check_reload;
     // Expect shader next to executable: build/bin/shaders/ripple.metal
     const char* metalPath = "/Users/ulirodriguez/CodeProjects/MetalLib-1/examples/shaders/ripple.metal";
     shader = GuliShaderLoadFromFile(metalPath, NULL);
  #elif defined(GULI_BACKEND_OPENGL)
     const char* vertPath = "/Users/ulirodriguez/CodeProjects/MetalLib-1/examples/shaders/ripple.vert.glsl";
     const char* fragPath = "/Users/ulirodriguez/CodeProjects/MetalLib-1/examples/shaders/ripple.frag.glsl";
+    if (check_reload)
+    {
+        exit_code = CheckHotReload(vertPath, fragPath) ? 0 : 1;
+        goto cleanup;
+    }
     shader = GuliShaderLoadFromFile(vertPath, fragPath);
  #else
  #   error "Define one backend: GULI_BACKEND_METAL or GULI_BACKEND_OPENGL"
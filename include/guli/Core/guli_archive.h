@@ -0,0 +1,59 @@
+#ifndef GULI_ARCHIVE_H
+#define GULI_ARCHIVE_H
+
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Packed read-only asset archive (.gpak)
+ *
+ * One file holds many assets. The table of contents is sorted by name hash and
+ * searched with a binary search; entry data starts on 4 KiB boundaries. The
+ * reader maps the archive once and returns views straight into the mapping.
+ * Entries may be LZ4-compressed; those are decompressed on first access and
+ * kept until the archive is closed.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliArchive GuliArchive;
+typedef struct GuliArchiveBuilder GuliArchiveBuilder;
+
+/** Borrowed view of an entry. Valid until GuliArchiveClose. data[size] is always '\0',
+    so text entries (shader sources) can be used as C strings without a copy. */
+typedef struct {
+    const void* data;
+    size_t size;
+} GuliAssetView;
+
+/* Builder flags */
+#define GULI_ARCHIVE_COMPRESS 0x1u  /* LZ4-compress the entry (stored raw if it does not shrink) */
+
+/** Map an archive. Returns NULL on failure (missing file, bad header or table). */
+GuliArchive* GuliArchiveOpen(const char* path);
+
+/** Unmap the archive and free decompressed entries. Invalidates all views. */
+void GuliArchiveClose(GuliArchive* archive);
+
+/** Look up an entry by name. Returns 1 and fills out on success, 0 if not found or corrupt. Thread-safe. */
+int GuliArchiveFind(GuliArchive* archive, const char* name, GuliAssetView* out);
+
+/** Number of entries. */
+size_t GuliArchiveGetCount(const GuliArchive* archive);
+
+/** Name of entry index (table order). Returns NULL if out of range. */
+const char* GuliArchiveGetName(const GuliArchive* archive, size_t index);
+
+/** Start a new archive. Entries are buffered in memory until GuliArchiveBuilderWrite. */
+GuliArchiveBuilder* GuliArchiveBuilderCreate(void);
+
+/** Add an entry from memory (data is copied). Returns 1 on success, 0 on duplicate name or allocation failure. */
+int GuliArchiveBuilderAdd(GuliArchiveBuilder* builder, const char* name, const void* data, size_t size, unsigned int flags);
+
+/** Add an entry from a file on disk. */
+int GuliArchiveBuilderAddFile(GuliArchiveBuilder* builder, const char* name, const char* path, unsigned int flags);
+
+/** Write the archive (via a temp file and rename). Returns 1 on success. */
+int GuliArchiveBuilderWrite(GuliArchiveBuilder* builder, const char* path);
+
+/** Free the builder and all buffered entries. */
+void GuliArchiveBuilderDestroy(GuliArchiveBuilder* builder);
+
+#endif // GULI_ARCHIVE_H
@@ -3,6 +3,9 @@
 
 #include "guli_window_backend.h"
 #include "guli_error.h"
+#include "guli_memory.h"
+#include "guli_input.h"
+#include "guli_pacing.h"
 
 #define GULI_API __attribute__((visibility("default")))
 
@@ -36,10 +39,17 @@ struct GLState;  /* forward declaration; full def in guli_gl_defines.h */
 #include "Graphics/OpenGL/guli_gl_defines.h"
 #endif
 
+struct GuliInputQueue;  /* buffered input events; see guli_input.h */
+struct GuliFramePacer;  /* present mode and frame timing; see guli_pacing.h */
+struct GuliFrameArena;  /* per-frame bump allocator; see guli_memory.h */
+
 typedef struct
 {
     GuliWindow* window;
     GuliError error;
+    struct GuliInputQueue* input;
+    struct GuliFramePacer* pacer;
+    struct GuliFrameArena* arena;  /* NULL: the GuliInit context's static arena */
 #ifdef GULI_BACKEND_METAL
     struct MetalState* metal_s;
 #endif
@@ -48,8 +58,21 @@ typedef struct
 #endif
 } GuliState;
 
-// Global state
-extern GuliState G_State;
+/** A renderer instance: window (visible or hidden), error and backend state. */
+typedef GuliState GuliContext;
+
+/* State set up by GuliInit, and the context bound to the calling thread (NULL: the default) */
+extern GuliState G_DefaultState;
+extern _Thread_local GuliState* G_CurrentState;
+
+/** State of the calling thread's current context. */
+static inline GuliState* GuliCurrentState(void)
+{
+    return G_CurrentState ? G_CurrentState : &G_DefaultState;
+}
+
+// Global state: resolves to the calling thread's current context
+#define G_State (*GuliCurrentState())
 
 /* Window and event API (use G_State.window internally, no window parameter) */
 static inline int GuliGetKey(GuliKey key)
@@ -109,6 +132,44 @@ static inline void GuliWindowDestroy(void)
 
 GULI_API short GuliInit(uint32_t width, uint32_t height, const char* title);
 
+/** GuliInit with GULI_CONTEXT_* flags (e.g. GULI_CONTEXT_COMPUTE). */
+GULI_API short GuliInitEx(uint32_t width, uint32_t height, const char* title, unsigned int flags);
+
 GULI_API void GuliShutdown(void);
 
+/* -----------------------------------------------------------------------------
+ * Additional contexts. Each has its own window, backend state and state caches,
+ * so several can render from different threads. Create and destroy them on the
+ * main thread (after GuliInit); bind one to a thread with GuliContextMakeCurrent
+ * and the rest of the API then targets it on that thread.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_CONTEXT_HIDDEN 0x1u  /* no visible window: offscreen rendering target */
+#define GULI_CONTEXT_COMPUTE 0x2u /* OpenGL: request 4.3 core for compute shaders (3.3 if unavailable) */
+
+/** Create a context. It becomes current on the calling thread. Returns NULL on failure. */
+GULI_API GuliContext* GuliContextCreate(uint32_t width, uint32_t height, const char* title, unsigned int flags);
+
+/** Destroy a context created with GuliContextCreate (main thread; not current on other threads). */
+GULI_API void GuliContextDestroy(GuliContext* ctx);
+
+/** Bind ctx (NULL: the GuliInit context) and its graphics context to the calling thread. */
+GULI_API void GuliContextMakeCurrent(GuliContext* ctx);
+
+/** Unbind the calling thread's context so another thread can make it current. */
+GULI_API void GuliContextRelease(void);
+
+/** Context bound to the calling thread, or NULL for the GuliInit context. */
+GULI_API GuliContext* GuliContextGetCurrent(void);
+
+static inline int GuliContextWindowShouldClose(GuliContext* ctx)
+{
+    return GuliBackendWindowShouldClose((ctx ? ctx : &G_DefaultState)->window);
+}
+
+static inline void GuliContextGetFramebufferSize(GuliContext* ctx, int* width, int* height)
+{
+    GuliBackendGetFramebufferSize((ctx ? ctx : &G_DefaultState)->window, width, height);
+}
+
 #endif // GULI_CORE_H
@@ -0,0 +1,19 @@
+#ifndef GULI_CPU_H
+#define GULI_CPU_H
+
+/* Runtime CPU feature detection for SIMD kernel dispatch. */
+
+typedef struct {
+    int ssse3;
+    int sse41;
+    int avx2;     /* AVX2 with OS-enabled YMM state */
+    int f16c;
+    int fma;
+    int avx512f;  /* AVX-512F with OS-enabled ZMM state */
+    int neon;
+} GuliCpuFeatures;
+
+/** Detected features of the running CPU (computed once, then cached). */
+const GuliCpuFeatures* GuliGetCpuFeatures(void);
+
+#endif // GULI_CPU_H
@@ -1,6 +1,7 @@
 #ifndef GULI_ERROR_H
 #define GULI_ERROR_H
 
+#include "guli_log.h"
 #include <stdio.h>
 
 typedef enum {
@@ -16,7 +17,7 @@ typedef struct GuliError
     const char* message;
 } GuliError;
 
-#define GULI_PRINT_ERROR(result, msg) fprintf(stderr, "ERROR [%d]: %s\n", (int)(result), (msg) ? (msg) : "(null)")
+#define GULI_PRINT_ERROR(result, msg) GuliLog(GULI_LOG_ERROR, (int)(result), "%s", (msg) ? (msg) : "(null)")
 
 /* Fail, optionally set state->error, print, and return (for void functions) */
 #define GULI_FAIL_RETURN(state, type, msg) \
@@ -1,8 +1,22 @@
 #ifndef GULI_FILE_H
 #define GULI_FILE_H
 
-/* Load file contents as a null-terminated string. Returns malloc'd buffer; caller must free.
+#include <stddef.h>
+
+/* Load file contents as a null-terminated string. Returns a buffer the caller frees with GuliFree.
    Returns NULL on failure (file not found, read error, etc.). */
 char* GuliLoadFileText(const char* path);
 
+/** Read-only memory mapping of a whole file. */
+typedef struct {
+    const void* data;
+    size_t size;
+} GuliFileMapping;
+
+/** Map path read-only. Returns 1 on success, 0 on failure (missing or empty file). */
+int GuliFileMap(const char* path, GuliFileMapping* out);
+
+/** Unmap and zero the mapping. Safe to call on a zero-initialized mapping. */
+void GuliFileUnmap(GuliFileMapping* map);
+
 #endif // GULI_FILE_H
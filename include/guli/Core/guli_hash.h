@@ -1,6 +1,7 @@
 #ifndef GULI_HASH_H
 #define GULI_HASH_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 /** FNV-1a hash for string keys. Shared by Metal/OpenGL uniform lookup. */
@@ -12,4 +13,14 @@ static inline uint32_t GuliHashFNV1a(const char* name)
     return h;
 }
 
+/** 64-bit FNV-1a over a byte range. Used for cache keys and content dedup. */
+static inline uint64_t GuliHashFNV1a64(const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
 #endif // GULI_HASH_H
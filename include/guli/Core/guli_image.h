@@ -2,6 +2,7 @@
 #define GULI_IMAGE_H
 
 #include "guli_core.h"
+#include <stddef.h>
 
 /** Image data loaded from file. Free with GuliImageFree. */
 typedef struct {
@@ -14,7 +15,42 @@ typedef struct {
 /** Load image from file. Returns {0} on failure. Uses stb_image. */
 GuliImage GuliImageLoadFromFile(const char* path);
 
+/** Decode an encoded image (PNG, JPG, ...) held in memory. Returns {0} on failure. */
+GuliImage GuliImageLoadFromMemory(const void* data, size_t size);
+
+/** Load and convert to RGBA8 in one pass. flags are GULI_PIXEL_* (see Core/guli_pixel.h), e.g. FLIP_Y | PREMULTIPLY. */
+GuliImage GuliImageLoadFromFileEx(const char* path, unsigned int flags);
+
+/** In-memory variant of GuliImageLoadFromFileEx. Accepts GuliAssetView data/size directly. */
+GuliImage GuliImageLoadFromMemoryEx(const void* data, size_t size, unsigned int flags);
+
 /** Free image data. Safe to call on zero-initialized image. */
 void GuliImageFree(GuliImage* img);
 
+/* -----------------------------------------------------------------------------
+ * Batch decoding on the job system (Core/guli_job.h)
+ * ----------------------------------------------------------------------------- */
+
+/** One batch input: a file path, or an encoded blob when data is non-NULL. */
+typedef struct {
+    const char* path;
+    const void* data;
+    size_t size;
+} GuliImageSource;
+
+/** Completion callback, invoked on the calling thread as each image finishes (any order).
+    The callback owns image and must GuliImageFree it. image.data is NULL on decode failure. */
+typedef void (*GuliImageBatchCallback)(void* user, size_t index, GuliImage image);
+
+typedef struct {
+    int threads;                         /* max concurrent decodes on the job system; <= 0 = no cap */
+    size_t max_inflight_bytes;           /* cap on decoded pixels not yet handed over; 0 = unlimited */
+    GuliImageBatchCallback on_complete;  /* NULL: results are stored in order in out[] */
+    void* user;
+} GuliImageBatchDesc;
+
+/** Decode count sources in parallel. With on_complete == NULL, out[i] receives source i (caller frees each);
+    otherwise out may be NULL. desc may be NULL for defaults. Returns the number of images decoded. */
+size_t GuliImageLoadBatch(const GuliImageSource* sources, size_t count, GuliImage* out, const GuliImageBatchDesc* desc);
+
 #endif /* GULI_IMAGE_H */
@@ -0,0 +1,62 @@
+#ifndef GULI_INPUT_H
+#define GULI_INPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Buffered input events
+ *
+ * Window callbacks append typed, timestamped events to a single-producer /
+ * single-consumer lock-free ring. The producer is the thread pumping window
+ * events (GuliPollEvents); any one thread may drain the queue, so every
+ * high-rate sample (e.g. 1000 Hz mouse motion) is kept instead of only the
+ * state seen at poll time. When the ring is full new events are dropped and
+ * counted.
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GULI_EVENT_KEY = 1,
+    GULI_EVENT_MOUSE_BUTTON,
+    GULI_EVENT_MOUSE_MOVE,
+    GULI_EVENT_SCROLL,
+    GULI_EVENT_RESIZE,     /* framebuffer size in pixels */
+    GULI_EVENT_FOCUS,
+} GuliEventType;
+
+typedef struct {
+    GuliEventType type;
+    uint64_t time_ns;  /* monotonic, same clock as GuliInputGetTimeNs */
+    union {
+        struct { int key, scancode, action, mods; } key;       /* GuliKey, GuliAction, GuliMod */
+        struct { int button, action, mods; } button;           /* GuliMouseButton, GuliAction, GuliMod */
+        struct { double x, y; } move;                          /* cursor position in screen coordinates */
+        struct { double dx, dy; } scroll;
+        struct { int width, height; } resize;
+        struct { int focused; } focus;
+    };
+} GuliEvent;
+
+typedef struct GuliInputQueue GuliInputQueue;
+
+/** Start queuing events from the current context's window. capacity is rounded up to a power
+    of two (0 uses 1024). Callbacks set before this are chained; set GuliSetKeyCallback first,
+    since setting it afterwards replaces the queue's key hook. Returns the queue, or NULL on failure. */
+GuliInputQueue* GuliInputEnable(size_t capacity);
+
+/** Stop queuing and free the current context's queue. Called when the context shuts down. */
+void GuliInputDisable(void);
+
+/** Queue of the current context, or NULL if input queuing is off. */
+GuliInputQueue* GuliInputGetQueue(void);
+
+/** Move up to max events, oldest first, into events. Returns the number copied. Consumer only. */
+size_t GuliInputPoll(GuliInputQueue* queue, GuliEvent* events, size_t max);
+
+/** Events dropped because the queue was full. */
+uint64_t GuliInputGetDropped(const GuliInputQueue* queue);
+
+/** Current time on the event clock, in nanoseconds. */
+uint64_t GuliInputGetTimeNs(void);
+
+#endif // GULI_INPUT_H
@@ -0,0 +1,79 @@
+#ifndef GULI_IO_H
+#define GULI_IO_H
+
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Asynchronous file reads
+ *
+ * Reads are queued by priority and issued in batches: through io_uring on Linux
+ * (opens and reads submitted together, many files in flight), or through a small
+ * worker pool elsewhere. Completion callbacks run on the thread that calls
+ * GuliIoPoll, so they can upload to the GPU directly.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliIo GuliIo;
+typedef struct GuliIoRequest GuliIoRequest;
+
+typedef enum {
+    GULI_IO_PRIORITY_HIGH = 0,  /* visible / blocking assets */
+    GULI_IO_PRIORITY_NORMAL,
+    GULI_IO_PRIORITY_LOW,       /* prefetch */
+    GULI_IO_PRIORITY_COUNT
+} GuliIoPriority;
+
+typedef enum {
+    GULI_IO_PENDING = 0,
+    GULI_IO_DONE,
+    GULI_IO_FAILED,
+    GULI_IO_CANCELED,
+} GuliIoStatus;
+
+/** Completion callback (from GuliIoPoll). data is NUL-terminated and owned by the request
+    unless taken with GuliIoTakeData. Runs exactly once per request, whatever the status. */
+typedef void (*GuliIoCallback)(void* user, GuliIoRequest* request, GuliIoStatus status, const void* data, size_t size);
+
+typedef struct {
+    int threads;         /* fallback worker threads; <= 0 uses 4 */
+    int queue_depth;     /* io_uring submission entries; <= 0 uses 64 */
+    int disable_uring;   /* force the thread-pool backend */
+} GuliIoDesc;
+
+/** Start the I/O service. desc may be NULL for defaults. Returns NULL on failure. */
+GuliIo* GuliIoCreate(const GuliIoDesc* desc);
+
+/** Cancel queued reads, wait for in-flight ones, run remaining callbacks, and free the service.
+    Requests not yet released stay readable (status/data) but must not be canceled or waited on. */
+void GuliIoDestroy(GuliIo* io);
+
+/** "io_uring" or "threads". */
+const char* GuliIoGetBackendName(const GuliIo* io);
+
+/** Queue a whole-file read. callback may be NULL (poll the request instead).
+    The caller owns the returned request and must GuliIoRelease it. Returns NULL on failure. */
+GuliIoRequest* GuliIoRead(GuliIo* io, const char* path, GuliIoPriority priority, GuliIoCallback callback, void* user);
+
+/** Run callbacks for finished requests on this thread. Call regularly (e.g. once per frame).
+    Returns the number of requests dispatched. */
+size_t GuliIoPoll(GuliIo* io);
+
+/** Cancel a read. Queued reads never start; in-flight reads finish but their data is discarded.
+    Returns 1 if the request will complete as GULI_IO_CANCELED, 0 if it already finished. */
+int GuliIoCancel(GuliIoRequest* request);
+
+/** Current status (non-blocking). */
+GuliIoStatus GuliIoGetStatus(const GuliIoRequest* request);
+
+/** Block until the request leaves GULI_IO_PENDING and return its final status. */
+GuliIoStatus GuliIoWait(GuliIoRequest* request);
+
+/** File contents once GULI_IO_DONE (NUL-terminated), else NULL. */
+const void* GuliIoGetData(const GuliIoRequest* request, size_t* size);
+
+/** Take ownership of the data buffer (free with GuliFree()). The request no longer holds it. */
+void* GuliIoTakeData(GuliIoRequest* request, size_t* size);
+
+/** Drop the caller's reference. Cancels the read if it is still pending. */
+void GuliIoRelease(GuliIoRequest* request);
+
+#endif // GULI_IO_H
@@ -0,0 +1,66 @@
+#ifndef GULI_JOB_H
+#define GULI_JOB_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Work-stealing job system
+ *
+ * One worker per spare core, each with its own deque; idle workers steal from
+ * the others. Jobs signal completion through counters, which can also gate
+ * dependent work. Jobs touching the graphics context are pinned to the render
+ * thread and run there from GuliJobPumpRenderThread (called every GuliBeginDraw)
+ * or while that thread waits. Started lazily on first use; stopped by GuliShutdown.
+ * ----------------------------------------------------------------------------- */
+
+typedef void (*GuliJobFunc)(void* arg);
+
+/** Counts unfinished jobs. Zero-initialize; it must outlive the jobs that reference it. */
+typedef struct {
+    atomic_int value;
+} GuliJobCounter;
+
+typedef struct {
+    GuliJobFunc func;
+    void* arg;
+} GuliJobDecl;
+
+/** Parallel-for body: process items [begin, end). */
+typedef void (*GuliParallelForFunc)(void* user, size_t begin, size_t end);
+
+/** Start the workers explicitly. threads <= 0 uses one per core minus the caller. Returns 1 on success. */
+int GuliJobSystemInit(int threads);
+
+/** Finish queued jobs and stop the workers. A later job call restarts the system. */
+void GuliJobSystemShutdown(void);
+
+/** Number of worker threads (starts the system if needed). */
+int GuliJobGetWorkerCount(void);
+
+/** Index of the calling worker in [0, GuliJobGetWorkerCount()), or -1 on other threads. */
+int GuliJobGetWorkerIndex(void);
+
+/** Mark the calling thread as the one owning the graphics context. GuliInit does this. */
+void GuliJobSetRenderThread(void);
+
+/** Queue count jobs. counter (may be NULL) is raised by count and lowered as each finishes. */
+void GuliJobRun(const GuliJobDecl* jobs, int count, GuliJobCounter* counter);
+
+/** Queue count jobs to start once dependency reaches zero. */
+void GuliJobRunAfter(const GuliJobDecl* jobs, int count, GuliJobCounter* dependency, GuliJobCounter* counter);
+
+/** Queue count jobs that only the render thread may execute. */
+void GuliJobRunOnRenderThread(const GuliJobDecl* jobs, int count, GuliJobCounter* counter);
+
+/** Wait until counter reaches zero, executing other jobs meanwhile. */
+void GuliJobWait(GuliJobCounter* counter);
+
+/** Run the jobs pinned to the render thread (no-op elsewhere). Returns the number executed. */
+size_t GuliJobPumpRenderThread(void);
+
+/** Split [0, count) into ranges and run func on them in parallel; returns when all are done.
+    grain is the items per job; 0 picks about four ranges per thread. */
+void GuliParallelFor(size_t count, size_t grain, GuliParallelForFunc func, void* user);
+
+#endif // GULI_JOB_H
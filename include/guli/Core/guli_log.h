@@ -0,0 +1,64 @@
+#ifndef GULI_LOG_H
+#define GULI_LOG_H
+
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Asynchronous logging
+ *
+ * GuliLog formats into a slot of a lock-free multi-producer ring and returns; a
+ * background thread (started on first use) hands the records to the sink. A full
+ * ring drops the record instead of blocking. Identical messages are rate-limited:
+ * past the limit within a second they are counted, and the next one let through
+ * carries the number suppressed. GULI_PRINT_ERROR logs through here.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_LOG_MESSAGE_MAX 228  /* bytes per message, terminator included; longer ones are truncated */
+
+typedef enum {
+    GULI_LOG_DEBUG = 0,
+    GULI_LOG_INFO,
+    GULI_LOG_WARNING,
+    GULI_LOG_ERROR,
+    GULI_LOG_NONE,             /* as a level filter: log nothing */
+} GuliLogLevel;
+
+typedef struct {
+    uint64_t time_ns;          /* CLOCK_MONOTONIC when logged */
+    GuliLogLevel level;
+    int code;                  /* GULIResult for errors, else 0 */
+    uint32_t suppressed;       /* identical messages dropped by the rate limit just before this one */
+    const char* message;       /* valid only during the sink call */
+} GuliLogRecord;
+
+/** Receives records on the log thread, in order. */
+typedef void (*GuliLogSink)(void* user, const GuliLogRecord* record);
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GULI_LOG_FORMAT(fmt_index, args_index) __attribute__((format(printf, fmt_index, args_index)))
+#else
+#define GULI_LOG_FORMAT(fmt_index, args_index)
+#endif
+
+/** Queue a message. Safe from any thread; never waits on I/O. */
+void GuliLog(GuliLogLevel level, int code, const char* fmt, ...) GULI_LOG_FORMAT(3, 4);
+
+/** Drop messages below level (default GULI_LOG_INFO). */
+void GuliLogSetLevel(GuliLogLevel level);
+
+/** Route records to sink (NULL: stderr). Takes effect for records not yet written. */
+void GuliLogSetSink(GuliLogSink sink, void* user);
+
+/** Identical messages let through per second (0: no limit). Default 10. */
+void GuliLogSetRateLimit(uint32_t per_second);
+
+/** Block until every record queued so far has reached the sink. */
+void GuliLogFlush(void);
+
+/** Records lost to a full ring since startup. */
+uint64_t GuliLogGetDropped(void);
+
+/** Flush and stop the log thread (GuliShutdown and process exit). Later messages restart it. */
+void GuliLogShutdown(void);
+
+#endif // GULI_LOG_H
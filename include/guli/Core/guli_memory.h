@@ -0,0 +1,118 @@
+#ifndef GULI_MEMORY_H
+#define GULI_MEMORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Allocation
+ *
+ * Every heap allocation the library makes goes through one allocator (the C
+ * allocator unless replaced) and is counted. Transient per-frame data comes from
+ * a linear arena instead: a bump pointer per context, reset by that context's
+ * GuliBeginDraw. A frame that outgrows the arena spills into heap blocks; the arena
+ * is grown to the peak at the next reset, so steady-state frames allocate nothing.
+ * ----------------------------------------------------------------------------- */
+
+/** Allocator hook. Same contract as malloc/realloc/free; free must accept NULL. */
+typedef struct {
+    void* (*alloc)(void* user, size_t size);
+    void* (*realloc)(void* user, void* ptr, size_t size);
+    void (*free)(void* user, void* ptr);
+    void* user;
+} GuliAllocator;
+
+typedef struct {
+    uint64_t allocations;         /* heap allocations since startup (realloc of NULL included) */
+    uint64_t reallocations;
+    uint64_t frees;
+    uint64_t live;                /* allocations - frees */
+    uint64_t frame_allocations;   /* heap allocations + reallocations during the last frame */
+    size_t frame_arena_used;      /* arena bytes used by the last frame, spills included */
+    size_t frame_arena_peak;
+    size_t frame_arena_capacity;
+    uint64_t frame_arena_spills;  /* arena requests served from the heap since startup */
+} GuliMemoryStats;
+
+/** Route library allocations to allocator (NULL: the C allocator). Call before GuliInit;
+    fails (returns 0) while memory from the previous allocator is still live. */
+int GuliSetAllocator(const GuliAllocator* allocator);
+
+void* GuliMalloc(size_t size);
+void* GuliCalloc(size_t count, size_t size);
+void* GuliRealloc(void* ptr, size_t size);
+void GuliFree(void* ptr);
+char* GuliStrdup(const char* str);
+
+/** Allocation aligned to alignment (a power of two); release with GuliFreeAligned. */
+void* GuliMallocAligned(size_t size, size_t alignment);
+void GuliFreeAligned(void* ptr);
+
+/** Transient memory from the calling thread's current context, valid until that context's next
+    frame begins, 16-byte aligned. Thread-safe. */
+void* GuliFrameAlloc(size_t size);
+
+/** Pre-size the current context's frame arena (otherwise it grows to the observed peak). */
+void GuliFrameArenaReserve(size_t bytes);
+
+/** Recycle the current context's frame arena. Called by GuliBeginDraw; none of its frame memory may be in use. */
+void GuliFrameArenaReset(void);
+
+void GuliGetMemoryStats(GuliMemoryStats* stats);
+
+/* -----------------------------------------------------------------------------
+ * Resource accounting
+ *
+ * Resource memory is tracked by category: GPU objects at their estimated size in
+ * video memory (RGBA8 texels, buffer sizes, program binaries, the default
+ * framebuffer), CPU decode buffers at their heap size. Each category can have a
+ * budget; the budget callback fires on the allocating thread whenever a category
+ * crosses its budget upwards.
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GULI_MEMORY_TEXTURE = 0,   /* GPU: texture storage, mip levels included */
+    GULI_MEMORY_BUFFER,        /* GPU: vertex, index, uniform and storage buffers */
+    GULI_MEMORY_SHADER,        /* GPU: linked programs (binary size where the driver reports it) */
+    GULI_MEMORY_FRAMEBUFFER,   /* GPU: default framebuffer (double-buffered color + depth/stencil) */
+    GULI_MEMORY_DECODE,        /* CPU: decoded images (GuliImage) */
+    GULI_MEMORY_MESH,          /* reserved for mesh data */
+    GULI_MEMORY_CATEGORY_COUNT,
+} GuliMemoryCategory;
+
+typedef struct {
+    uint64_t bytes;            /* live */
+    uint64_t peak_bytes;
+    uint64_t count;            /* live objects */
+    uint64_t peak_count;
+    uint64_t budget;           /* 0: none */
+} GuliMemoryCategoryStats;
+
+typedef void (*GuliMemoryBudgetCallback)(void* user, GuliMemoryCategory category, uint64_t bytes, uint64_t budget);
+
+/** Record an object of bytes entering (GuliMemoryTrack) or leaving (GuliMemoryUntrack) a category. Thread-safe. */
+void GuliMemoryTrack(GuliMemoryCategory category, uint64_t bytes);
+void GuliMemoryUntrack(GuliMemoryCategory category, uint64_t bytes);
+
+/** Per-category budget in bytes (0 removes it). */
+void GuliSetMemoryBudget(GuliMemoryCategory category, uint64_t bytes);
+
+/** Called when a category goes over its budget (NULL: log a warning). */
+void GuliSetMemoryBudgetCallback(GuliMemoryBudgetCallback callback, void* user);
+
+void GuliGetMemoryCategoryStats(GuliMemoryCategory category, GuliMemoryCategoryStats* stats);
+
+/** Short lowercase name ("texture", "buffer", ...). */
+const char* GuliMemoryCategoryName(GuliMemoryCategory category);
+
+/** Video memory as reported by the driver, in KiB; -1 where unknown. See GuliGetVideoMemoryInfo. */
+typedef struct {
+    int64_t total_kb;          /* dedicated video memory */
+    int64_t available_kb;      /* currently free */
+} GuliVideoMemoryInfo;
+
+/* Called by the library */
+struct GuliFrameArena* GuliFrameArenaCreate(void);  /* arena of a GuliContextCreate context */
+void GuliFrameArenaRelease(void);  /* context shutdown: free the current context's arena */
+
+#endif // GULI_MEMORY_H
@@ -0,0 +1,87 @@
+#ifndef GULI_PACING_H
+#define GULI_PACING_H
+
+#include "guli_defines.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Frame pacing
+ *
+ * GuliPollEvents is the pacing point: it waits for the next frame slot, then
+ * samples input. Waits sleep on the monotonic clock (GuliInputGetTimeNs) and
+ * spin the last stretch, with the spin margin adapted to the observed sleep
+ * overshoot. Settings and statistics belong to the current context.
+ *
+ * In on-demand mode GuliPollEvents blocks until input arrives or something is
+ * invalidated; the loop draws only when GuliNeedsRedraw says so. The frame is
+ * scissored to the invalidated area (widened by the back buffer's age) and
+ * presented with damage rectangles where EGL supports it.
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GULI_PRESENT_UNCAPPED = 0,  /* swap interval 0, no waiting */
+    GULI_PRESENT_VSYNC,         /* swap interval 1 (default) */
+    GULI_PRESENT_ADAPTIVE,      /* late swaps tear instead of waiting a whole refresh; vsync if unsupported */
+    GULI_PRESENT_LIMITED,       /* swap interval 0, frames started at the target FPS */
+} GuliPresentMode;
+
+typedef struct {
+    GuliPresentMode mode;    /* requested mode */
+    int swap_interval;       /* interval applied to the swap chain */
+    double target_fps;       /* limiter target, or the display refresh rate when synced */
+    uint64_t frames;         /* frames paced since the last reset */
+    uint64_t late_frames;    /* frames started more than half a period after their deadline */
+    double frame_ms;         /* mean frame time over the recent window */
+    double min_ms, max_ms;
+    double jitter_ms;        /* standard deviation of the frame time over the recent window */
+    double work_ms;          /* smoothed time from input sampling to GuliEndDraw returning */
+    double spin_ms;          /* current spin margin ahead of each deadline */
+} GuliFrameStats;
+
+/** Select how frames are presented and paced. */
+void GuliSetPresentMode(GuliPresentMode mode);
+
+GuliPresentMode GuliGetPresentMode(void);
+
+/** Switch to GULI_PRESENT_LIMITED at fps frames per second; fps <= 0 selects GULI_PRESENT_UNCAPPED. */
+void GuliSetFPS(double fps);
+
+/** Low-latency mode: delay input sampling until just before the frame deadline, leaving room
+    for the measured frame work, so input is as fresh as possible when the frame is presented.
+    Most accurate without the render thread, where GuliEndDraw returns after the swap. */
+void GuliSetLowLatency(int enabled);
+
+void GuliGetFrameStats(GuliFrameStats* stats);
+void GuliResetFrameStats(void);
+
+/** Pump window events after waiting for the current frame slot. In on-demand mode, wait for
+    events instead while nothing is invalidated. */
+void GuliPollEvents(void);
+
+/** Redraw only when invalidated (or resized). Enabling invalidates the whole frame. */
+void GuliSetOnDemand(int enabled);
+
+int GuliIsOnDemand(void);
+
+/** Mark the whole frame for redraw. Safe from any thread (targets that thread's current
+    context); wakes a waiting GuliPollEvents. */
+void GuliInvalidate(void);
+
+/** Mark a framebuffer rectangle for redraw. Safe from any thread, like GuliInvalidate. */
+void GuliInvalidateRect(GuliRect rect);
+
+/** 1 if the loop should draw a frame: always outside on-demand mode, else when invalidated. */
+int GuliNeedsRedraw(void);
+
+/** Rectangles being redrawn by the current frame (between GuliBeginDraw and GuliEndDraw);
+    a full redraw reports one rectangle covering the framebuffer. Returns the count. */
+int GuliGetDirtyRects(GuliRect* rects, int max);
+
+/* Called by the library */
+void GuliFramePacingInit(void);                     /* context creation */
+void GuliFramePacingBeginFrame(void);               /* GuliBeginDraw: take the pending invalidations */
+int GuliFramePacingGetDamage(GuliRect* rects);      /* current frame's rects (GULI_MAX_DIRTY_RECTS); 0: full */
+void GuliFramePacingEndFrame(void);                 /* GuliEndDraw: frame work finished */
+void GuliFramePacingRelease(void);                  /* context shutdown */
+
+#endif // GULI_PACING_H
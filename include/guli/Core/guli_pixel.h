@@ -0,0 +1,39 @@
+#ifndef GULI_PIXEL_H
+#define GULI_PIXEL_H
+
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Pixel conversion between decode and upload. All requested transforms are fused
+ * into one pass over the image; kernels are picked at runtime (SSE4/AVX2/NEON).
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GULI_PIXEL_GRAY8 = 0,  /* 1 byte */
+    GULI_PIXEL_GRAYA8,     /* 2 bytes */
+    GULI_PIXEL_RGB8,       /* 3 bytes */
+    GULI_PIXEL_RGBA8,      /* 4 bytes */
+    GULI_PIXEL_BGRA8,      /* 4 bytes */
+    GULI_PIXEL_RGBA16F,    /* 4 x IEEE half */
+} GuliPixelFormat;
+
+/* Conversion flags. Applied in order: sRGB decode, premultiply, sRGB encode. */
+#define GULI_PIXEL_FLIP_Y          0x1u  /* reverse row order (GL bottom-left origin) */
+#define GULI_PIXEL_PREMULTIPLY     0x2u  /* multiply color by alpha */
+#define GULI_PIXEL_SRGB_TO_LINEAR  0x4u  /* decode sRGB-encoded color channels */
+#define GULI_PIXEL_LINEAR_TO_SRGB  0x8u  /* encode color channels to sRGB */
+
+/** Bytes per pixel of a format. */
+size_t GuliPixelFormatSize(GuliPixelFormat format);
+
+/** Convert width x height pixels. Strides are in bytes (0 = tightly packed).
+    In-place conversion is allowed when src == dst and both formats have the same size.
+    Destination must be RGBA8, BGRA8 or RGBA16F. Returns 1 on success, 0 on invalid arguments. */
+int GuliPixelConvert(const void* src, GuliPixelFormat srcFormat, size_t srcStride,
+    void* dst, GuliPixelFormat dstFormat, size_t dstStride,
+    int width, int height, unsigned int flags);
+
+/** Name of the kernel set selected for this CPU ("avx2", "sse4", "neon" or "scalar"). */
+const char* GuliPixelGetKernelName(void);
+
+#endif // GULI_PIXEL_H
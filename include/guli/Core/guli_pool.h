@@ -0,0 +1,83 @@
+#ifndef GULI_POOL_H
+#define GULI_POOL_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Generational object pools
+ *
+ * Objects of one type live densely in fixed-size pages that never move, so a
+ * pointer stays valid for the object's lifetime. Each slot has hot data (what
+ * draws touch) and optional cold data (debug names, reflection) kept in a
+ * parallel page so it does not dilute the hot cache lines. A 32-bit handle packs
+ * the slot index with the slot's generation: releasing a slot bumps the
+ * generation, so stale handles resolve to NULL instead of a reused object.
+ *
+ * Release and recycle are separate so a slot can stay reserved while the GPU may
+ * still reference what it described; GuliPoolFree does both at once.
+ * ----------------------------------------------------------------------------- */
+
+/** Generational handle: slot index in the low 20 bits, generation (never 0) above. 0 is null. */
+typedef uint32_t GuliHandle;
+
+#define GULI_HANDLE_NULL 0u
+#define GULI_HANDLE_INDEX_BITS 20
+#define GULI_HANDLE_INDEX_MASK ((1u << GULI_HANDLE_INDEX_BITS) - 1u)
+#define GULI_HANDLE_GEN_MASK 0xFFFu
+
+#define GULI_POOL_PAGE_SHIFT 8
+#define GULI_POOL_PAGE_SLOTS (1u << GULI_POOL_PAGE_SHIFT)
+#define GULI_POOL_MAX_PAGES ((GULI_HANDLE_INDEX_MASK + 1u) >> GULI_POOL_PAGE_SHIFT)
+
+/** Debug names stored in cold data are truncated to this many bytes (terminator included). */
+#define GULI_RESOURCE_NAME_MAX 64
+
+struct GuliPoolPage;
+
+/** A pool of hot_size-byte objects with cold_size bytes of side data each. Initialize with GULI_POOL_INIT. */
+typedef struct {
+    size_t hot_size;
+    size_t cold_size;
+    atomic_int lock;                      /* spin lock over allocation and the free list */
+    _Atomic(struct GuliPoolPage*) pages[GULI_POOL_MAX_PAGES];
+    atomic_uint high_water;               /* slots ever handed out; pages cover them */
+    uint32_t free_head;                   /* first free slot index + 1, 0 when empty */
+    atomic_uint live;                     /* allocated slots, released or not */
+} GuliPool;
+
+#define GULI_POOL_INIT(hot, cold) { .hot_size = (hot), .cold_size = (cold) }
+
+/** Visit callback for GuliPoolForEach. */
+typedef void (*GuliPoolVisitFunc)(void* user, GuliHandle handle, void* hot);
+
+/** Allocate a zeroed object (and zeroed cold data). Writes its handle; returns NULL when full or out of memory. */
+void* GuliPoolAlloc(GuliPool* pool, GuliHandle* handle);
+
+/** Object for handle, or NULL if the handle is null, stale or released. Lock-free. */
+void* GuliPoolGet(const GuliPool* pool, GuliHandle handle);
+
+/** Cold data for handle, or NULL (also NULL when the pool has no cold data). */
+void* GuliPoolGetCold(const GuliPool* pool, GuliHandle handle);
+
+/** Invalidate handle. The slot stays reserved (its memory untouched) until GuliPoolRecycle. */
+void GuliPoolRelease(GuliPool* pool, GuliHandle handle);
+
+/** Return a released slot to the free list. handle is the one passed to GuliPoolRelease; recycling
+    a slot that is alive or already recycled is reported and ignored. */
+void GuliPoolRecycle(GuliPool* pool, GuliHandle handle);
+
+/** Release and recycle at once. */
+void GuliPoolFree(GuliPool* pool, GuliHandle handle);
+
+/** Visit every live object in slot order. Must not run concurrently with allocation or release. */
+void GuliPoolForEach(GuliPool* pool, GuliPoolVisitFunc func, void* user);
+
+/** Slots currently allocated, counting released ones not yet recycled. */
+uint32_t GuliPoolGetCount(const GuliPool* pool);
+
+/** Free the pool's pages. Fails (returns 0) while any slot is allocated. */
+int GuliPoolDestroy(GuliPool* pool);
+
+#endif // GULI_POOL_H
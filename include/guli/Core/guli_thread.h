@@ -0,0 +1,103 @@
+#ifndef GULI_THREAD_H
+#define GULI_THREAD_H
+
+/* Minimal threading wrappers (pthreads). Single place to swap the threading backend. */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+typedef pthread_t GuliThread;
+typedef pthread_mutex_t GuliMutex;
+typedef pthread_cond_t GuliCond;
+
+typedef void* (*GuliThreadFunc)(void* arg);
+
+static inline int GuliThreadCreate(GuliThread* thread, GuliThreadFunc func, void* arg)
+{
+    return pthread_create(thread, NULL, func, arg) == 0;
+}
+
+static inline void GuliThreadJoin(GuliThread thread)
+{
+    pthread_join(thread, NULL);
+}
+
+static inline GuliThread GuliThreadSelf(void)
+{
+    return pthread_self();
+}
+
+static inline int GuliThreadEqual(GuliThread a, GuliThread b)
+{
+    return pthread_equal(a, b) != 0;
+}
+
+static inline void GuliThreadYield(void)
+{
+    sched_yield();
+}
+
+/** CPU hint for spin-wait loops. */
+static inline void GuliThreadPause(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static inline int GuliMutexInit(GuliMutex* mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static inline void GuliMutexDestroy(GuliMutex* mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+static inline void GuliMutexLock(GuliMutex* mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+static inline void GuliMutexUnlock(GuliMutex* mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+static inline int GuliCondInit(GuliCond* cond)
+{
+    return pthread_cond_init(cond, NULL) == 0;
+}
+
+static inline void GuliCondDestroy(GuliCond* cond)
+{
+    pthread_cond_destroy(cond);
+}
+
+static inline void GuliCondWait(GuliCond* cond, GuliMutex* mutex)
+{
+    pthread_cond_wait(cond, mutex);
+}
+
+static inline void GuliCondSignal(GuliCond* cond)
+{
+    pthread_cond_signal(cond);
+}
+
+static inline void GuliCondBroadcast(GuliCond* cond)
+{
+    pthread_cond_broadcast(cond);
+}
+
+/** Number of online CPU cores (at least 1). */
+static inline int GuliGetCpuCount(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+#endif // GULI_THREAD_H
@@ -0,0 +1,63 @@
+#ifndef GULI_TRANSFORM_H
+#define GULI_TRANSFORM_H
+
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Batch transforms. Per-object inputs are structure-of-arrays (one float array
+ * per component); matrices are column-major float[16] as the shader API takes
+ * them (a cglm mat4 passes as (const float*)m). Kernels are picked at runtime
+ * (AVX-512/AVX2/SSE4/NEON), and batches of GULI_TRANSFORM_PARALLEL_MIN or more
+ * are split across the job system.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_TRANSFORM_PARALLEL_MIN 16384  /* items below which a batch runs on the caller only */
+
+/** count floats per component. */
+typedef struct {
+    float* x;
+    float* y;
+    float* z;
+} GuliVec3Soa;
+
+typedef struct {
+    GuliVec3Soa min;
+    GuliVec3Soa max;
+} GuliAabbSoa;
+
+/** Translation, unit-quaternion rotation and scale per object. */
+typedef struct {
+    const float* tx;
+    const float* ty;
+    const float* tz;
+    const float* qx;
+    const float* qy;
+    const float* qz;
+    const float* qw;
+    const float* sx;
+    const float* sy;
+    const float* sz;
+} GuliTrsSoa;
+
+/** out[i] = m * (in[i], 1), the affine part of m (no perspective divide). out may equal in. */
+void GuliTransformPoints(const float m[16], const GuliVec3Soa* in, GuliVec3Soa* out, size_t count);
+
+/** Bounds of each box after transforming it by the affine part of m. out may equal in. */
+void GuliTransformAabbs(const float m[16], const GuliAabbSoa* in, GuliAabbSoa* out, size_t count);
+
+/** out[i] = a[i] * b[i] for count consecutive matrices. out may equal a or b. */
+void GuliMat4MulBatch(const float* a, const float* b, float* out, size_t count);
+
+/** out[i] = m * b[i]. out may equal b. */
+void GuliMat4MulBatchLeft(const float m[16], const float* b, float* out, size_t count);
+
+/** out[i] = translate * rotate * scale, one matrix per object. */
+void GuliComposeTrs(const GuliTrsSoa* trs, float* out, size_t count);
+
+/** out[i] = proj * view * models[i]. out may equal models. */
+void GuliBuildMvps(const float view[16], const float proj[16], const float* models, float* out, size_t count);
+
+/** Name of the kernel set selected for this CPU ("avx512", "avx2", "sse4", "neon" or "scalar"). */
+const char* GuliTransformGetKernelName(void);
+
+#endif // GULI_TRANSFORM_H
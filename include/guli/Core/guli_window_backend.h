@@ -266,6 +266,17 @@ static inline GuliWindow* GuliWindowCreate(int width, int height, const char* ti
     return glfwCreateWindow(width, height, title, NULL, NULL);
 }
 
+/* Bind window's graphics context to the calling thread (NULL releases it). OpenGL only. */
+static inline void GuliBackendMakeContextCurrent(GuliWindow* window)
+{
+    glfwMakeContextCurrent(window);
+}
+
+static inline GuliWindow* GuliBackendGetCurrentContext(void)
+{
+    return glfwGetCurrentContext();
+}
+
 static inline void GuliBackendWindowDestroy(GuliWindow* window)
 {
     glfwDestroyWindow(window);
@@ -301,6 +312,17 @@ static inline void GuliWindowPollEvents(void)
     glfwPollEvents();
 }
 
+static inline void GuliWindowWaitEvents(void)
+{
+    glfwWaitEvents();
+}
+
+/** Wake a thread blocked in GuliWindowWaitEvents. Callable from any thread. */
+static inline void GuliWindowPostEmptyEvent(void)
+{
+    glfwPostEmptyEvent();
+}
+
 static inline double GuliGetTime(void)
 {
     return glfwGetTime();
@@ -316,14 +338,13 @@ static inline void GuliBackendSwapBuffers(GuliWindow* window)
     glfwSwapBuffers(window);
 }
 
-static inline void GuliPollEvents(void)
-{
-    glfwPollEvents();
-}
-
-static inline void GuliSetFPS(int fps)
+/** Refresh rate in Hz of the window's monitor (primary monitor when windowed), or 0 if unknown. */
+static inline int GuliBackendGetRefreshRate(GuliWindow* window)
 {
-    glfwSwapInterval(fps);
+    GLFWmonitor* monitor = glfwGetWindowMonitor(window);
+    if (!monitor) monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : NULL;
+    return mode ? mode->refreshRate : 0;
 }
 
 static inline void GuliBackendSetKeyCallback(GuliWindow* window, void (*callback)(GuliWindow* window, int key, int scancode, int action, int mods))
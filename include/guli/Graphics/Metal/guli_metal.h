@@ -21,4 +21,10 @@ int MetalHasActiveFrame(void);
 // Clear color; only valid between MetalBeginDraw and MetalEndDraw
 void MetalClearColor(GULI_COLOR color);
 
+// Display sync on the layer: 0 presents immediately, anything else waits for vblank. Returns the interval applied.
+int MetalSetSwapInterval(int interval);
+
+// Device working-set limit and what is left of it. Returns 1 when known.
+int MetalGetVideoMemoryInfo(GuliVideoMemoryInfo* info);
+
 #endif // GULI_METAL_H
@@ -34,6 +34,7 @@ struct MetalState {
     // Size-dependent attachments (created on resize)
     id<MTLTexture> _msaaColor;
     id<MTLTexture> _depth;
+    size_t _framebufferBytes;  // drawables + attachments, counted under GULI_MEMORY_FRAMEBUFFER
 
     // Clear pipeline (fullscreen draw with color uniform)
     id<MTLRenderPipelineState> _clearPipeline;
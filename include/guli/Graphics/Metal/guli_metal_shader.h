@@ -14,6 +14,10 @@ GuliShader* MetalShaderLoadFromFile(const char* path, const char* unused);
 GuliShader* MetalShaderLoadFromFileEx(const char* path, const char* unused, const char* vertexName, const char* fragmentName);
 void MetalShaderUnload(GuliShader* shader);
 
+/* Metal cannot consume SPIR-V: always builds the desc's MSL fallback (vs_source) */
+GuliShader* MetalShaderLoadSpirv(const GuliShaderSpirvDesc* desc);
+int MetalShaderIsSpirvSupported(void);
+
 /* Validation / location */
 int MetalShaderIsValid(const GuliShader* shader);
 int MetalShaderGetLocation(const GuliShader* shader, const char* uniformName);
@@ -38,6 +42,12 @@ void MetalShaderSetVertexVec4(GuliShader* restrict shader, int loc, const float*
 void MetalShaderSetVertexInt(GuliShader* restrict shader, int loc, int value);
 void MetalShaderSetVertexMatrix4(GuliShader* restrict shader, int loc, const float* restrict m);
 
+/* Handles and debug names */
+GuliShaderHandle MetalShaderGetHandle(const GuliShader* shader);
+GuliShader* MetalShaderFromHandle(GuliShaderHandle handle);
+void MetalShaderSetName(GuliShader* shader, const char* name);
+const char* MetalShaderGetName(const GuliShader* shader);
+
 /** Returns the last shader compile/link error string, or NULL if none. */
 const char* MetalShaderGetCompileError(void);
 
@@ -2,6 +2,7 @@
 #define GULI_GL_H
 
 #include "Core/guli_core.h"
+#include "Core/guli_pool.h"
 #include "guli_defines.h"
 
 GULIResult GlInit(GuliState* state);
@@ -18,4 +19,44 @@ int GlHasActiveFrame(void);
 
 void GlDrawFullscreen(void);
 
+/* Swap interval for the context (on its owning thread). -1 requests late-swap tearing and falls
+   back to 1 without EXT_swap_control_tear. Returns the interval applied. */
+int GlSetSwapInterval(int interval);
+
+/* Driver-reported video memory (GL_NVX_gpu_memory_info, else GL_ATI_meminfo). Returns 1 when known. */
+int GlGetVideoMemoryInfo(GuliVideoMemoryInfo* info);
+
+/* Render-thread mode (guli_gl_render_thread.c): GL calls are recorded and replayed
+   one frame behind on a thread that owns the context */
+int GlRenderThreadStart(void);
+void GlRenderThreadStop(void);
+int GlRenderThreadIsActive(void);
+
+/* Frame recorder readback (guli_gl_recorder.c); capture is issued before each swap */
+void GlRecorderCapture(void);
+
+/* Partial-redraw state (guli_gl_damage.c) */
+void GlDamageFree(struct GLState* gl);
+
+/* Deferred destruction (guli_gl_retire.c). Unloaded objects' names are deleted in batches
+   once the frames in flight that may still use them have retired; their pool slots are
+   recycled at the same point. */
+typedef enum {
+    GL_RETIRE_TEXTURE = 0,
+    GL_RETIRE_BUFFER,
+    GL_RETIRE_PROGRAM,
+    GL_RETIRE_VERTEX_ARRAY,
+    GL_RETIRE_KIND_COUNT,
+} GlRetireKind;
+
+int GlRetireInit(struct GLState* gl);
+void GlRetireObject(GlRetireKind kind, unsigned int name, GuliPool* pool, GuliHandle handle);
+void GlRetireCollect(int all);  /* once per frame on the owning thread; all: flush everything */
+void GlRetireFree(struct GLState* gl);
+
+/* Shader hot reload (guli_gl_shader_reload.c): watched files are checked and finished
+   recompiles swapped in once per frame, on the drawing thread */
+void GlShaderReloadPoll(struct GLState* gl);
+void GlShaderReloadFree(struct GLState* gl);
+
 #endif /* GULI_GL_H */
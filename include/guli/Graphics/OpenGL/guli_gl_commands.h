@@ -0,0 +1,131 @@
+#ifndef GULI_GL_COMMANDS_H
+#define GULI_GL_COMMANDS_H
+
+#include "guli_defines.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Compact OpenGL command stream. Each command is an 8-byte header followed by a
+ * fixed payload holding GL object names (never GuliShader/GuliTexture pointers),
+ * so a recorded stream can be replayed after the objects' wrappers are gone.
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GL_CMD_BEGIN_FRAME = 1,   /* GlCmdFrame */
+    GL_CMD_END_FRAME,         /* no payload: readback + swap */
+    GL_CMD_CLEAR,             /* GlCmdClearColor */
+    GL_CMD_DRAW_FULLSCREEN,   /* no payload */
+    GL_CMD_USE_PROGRAM,       /* GlCmdObject */
+    GL_CMD_UNIFORM_F,         /* GlCmdUniformF (1-4 floats) */
+    GL_CMD_UNIFORM_I,         /* GlCmdUniformI */
+    GL_CMD_UNIFORM_MAT4,      /* GlCmdUniformMat4 */
+    GL_CMD_BIND_TEXTURE,      /* GlCmdBindTexture */
+    GL_CMD_DELETE_OBJECTS,    /* GlCmdDeleteList, then count GL names */
+    GL_CMD_BUFFER_DATA,       /* GlCmdBufferRange, then size bytes of data */
+    GL_CMD_WAIT_FENCE,        /* GlCmdFence: server-side wait, then delete */
+    GL_CMD_DISPATCH,          /* GlCmdDispatch */
+    GL_CMD_DISPATCH_INDIRECT, /* GlCmdDispatchIndirect */
+    GL_CMD_BIND_STORAGE,      /* GlCmdBindStorage */
+    GL_CMD_BIND_IMAGE,        /* GlCmdBindImage */
+    GL_CMD_MEMORY_BARRIER,    /* GlCmdBarrier */
+    GL_CMD_MULTI_DRAW_INDIRECT, /* GlCmdMultiDrawIndirect */
+} GlCmdOp;
+
+typedef struct {
+    uint32_t op;
+    uint32_t size;  /* header + payload, multiple of 8 */
+} GlCmdHeader;
+
+typedef struct { int width, height; int damage_count; int pad; GuliRect damage[GULI_MAX_DIRTY_RECTS]; } GlCmdFrame;  /* damage_count 0: full frame */
+typedef struct { float color[4]; } GlCmdClearColor;
+typedef struct { unsigned int id; } GlCmdObject;
+typedef struct { unsigned int program; int loc; int count; float v[4]; } GlCmdUniformF;
+typedef struct { unsigned int program; int loc; int value; } GlCmdUniformI;
+typedef struct { unsigned int program; int loc; float m[16]; } GlCmdUniformMat4;
+typedef struct { unsigned int program; int loc; int slot; unsigned int texture; } GlCmdBindTexture;
+typedef struct { unsigned int buffer; unsigned int pad; uint64_t offset; uint64_t size; } GlCmdBufferRange;
+typedef struct { uint64_t sync; } GlCmdFence;
+typedef struct { uint32_t kind; uint32_t count; } GlCmdDeleteList;  /* kind: GlRetireKind */
+typedef struct { unsigned int program; uint32_t x, y, z; } GlCmdDispatch;
+typedef struct { unsigned int program; unsigned int buffer; uint64_t offset; } GlCmdDispatchIndirect;
+typedef struct { unsigned int buffer; uint32_t binding; uint64_t offset; uint64_t size; } GlCmdBindStorage;  /* size 0: whole buffer */
+typedef struct { unsigned int texture; uint32_t unit; int32_t level; uint32_t access; uint32_t format; } GlCmdBindImage;  /* GL enums */
+typedef struct { uint32_t bits; } GlCmdBarrier;  /* GL barrier bits */
+typedef struct { unsigned int program; unsigned int vao; unsigned int commands; unsigned int draw_count; uint32_t max_draws; } GlCmdMultiDrawIndirect;  /* draw_count 0: max_draws draws */
+
+/** Growable byte buffer of commands. Zero-initialize. */
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+} GlCmdBuffer;
+
+/** Append a command and return its payload (payload bytes, zeroed), or NULL on allocation failure. */
+void* GlCmdPush(GlCmdBuffer* buf, GlCmdOp op, size_t payload);
+
+/** Append already-encoded commands (whole commands only). Returns 0 on allocation failure. */
+int GlCmdAppend(GlCmdBuffer* buf, const unsigned char* data, size_t size);
+
+void GlCmdBufferReset(GlCmdBuffer* buf);
+void GlCmdBufferFree(GlCmdBuffer* buf);
+
+/** Execute size bytes of commands on the thread owning the GL context. */
+void GlCmdReplay(const unsigned char* data, size_t size);
+
+/* Encoders */
+void GlCmdBeginFrame(GlCmdBuffer* buf, const GlCmdFrame* frame);
+void GlCmdEndFrame(GlCmdBuffer* buf);
+void GlCmdClear(GlCmdBuffer* buf, const float color[4]);
+void GlCmdDrawFullscreen(GlCmdBuffer* buf);
+void GlCmdUseProgram(GlCmdBuffer* buf, unsigned int program);
+void GlCmdUniformFloats(GlCmdBuffer* buf, unsigned int program, int loc, const float* v, int count);
+void GlCmdUniformInt(GlCmdBuffer* buf, unsigned int program, int loc, int value);
+void GlCmdUniformMatrix4(GlCmdBuffer* buf, unsigned int program, int loc, const float m[16]);
+void GlCmdBindTexture2D(GlCmdBuffer* buf, unsigned int program, int loc, int slot, unsigned int texture);
+void GlCmdDeleteObjects(GlCmdBuffer* buf, int kind, const unsigned int* names, int count);
+void GlCmdBufferData(GlCmdBuffer* buf, unsigned int buffer, size_t offset, const void* data, size_t size);
+void GlCmdWaitFence(GlCmdBuffer* buf, void* sync);
+void GlCmdDispatchCompute(GlCmdBuffer* buf, const GlCmdDispatch* dispatch);
+void GlCmdDispatchComputeIndirect(GlCmdBuffer* buf, const GlCmdDispatchIndirect* dispatch);
+void GlCmdBindStorageBuffer(GlCmdBuffer* buf, const GlCmdBindStorage* bind);
+void GlCmdBindImageTexture(GlCmdBuffer* buf, const GlCmdBindImage* bind);
+void GlCmdMemoryBarrier(GlCmdBuffer* buf, uint32_t bits);
+void GlCmdMultiDrawElementsIndirect(GlCmdBuffer* buf, const GlCmdMultiDrawIndirect* draw);
+
+/* Immediate paths shared by replay and the direct API */
+void GlBindProgram(unsigned int program);            /* guli_gl_shader.c: glUseProgram if it changed */
+void GlExecBeginFrame(const GlCmdFrame* frame);      /* guli_gl.c: frame slot wait + viewport + damage scissor */
+void GlExecEndFrame(void);                           /* guli_gl.c: recorder readback + swap */
+void GlExecDeleteObjects(int kind, const unsigned int* names, int count);  /* guli_gl_retire.c */
+
+/* Compute (guli_gl_compute.c) */
+void GlExecDispatch(const GlCmdDispatch* dispatch);
+void GlExecDispatchIndirect(const GlCmdDispatchIndirect* dispatch);
+void GlExecBindStorage(const GlCmdBindStorage* bind);
+void GlExecBindImage(const GlCmdBindImage* bind);
+void GlExecMultiDrawIndirect(const GlCmdMultiDrawIndirect* draw);  /* guli_gl_indirect.c */
+
+/* Partial redraw (guli_gl_damage.c), run where GL executes */
+void GlDamageBeginFrame(const GlCmdFrame* frame);    /* scissor to the damage widened by the buffer age */
+int GlDamageSwap(void);                              /* end scissoring; 1 if it presented with damage rects */
+
+/* Render-thread routing (guli_gl_render_thread.c) */
+
+/** Command buffer the calling thread should record into instead of calling GL, or NULL to call GL directly. */
+GlCmdBuffer* GlRenderThreadRecorder(void);
+
+/** Mark the calling thread as holding a GL context of its own (render or loader thread):
+    GL calls made there always execute directly. */
+void GlRenderThreadSetContextOwner(void);
+
+/** 1 if render-thread mode is on and the caller is not the render thread. */
+int GlRenderThreadIsRemote(void);
+
+/** Hand the recorded frame to the render thread (GlEndDraw). */
+void GlRenderThreadSubmit(void);
+
+/** Run func on the render thread between frames and wait for it (direct call when not remote). */
+void GlRenderThreadInvoke(void (*func)(void* arg), void* arg);
+
+#endif /* GULI_GL_COMMANDS_H */
@@ -11,11 +11,31 @@
 #define GL_SEM_POST(gl) sem_post(&(gl)->inflight_semaphore)
 #endif
 
+struct GlRecorderState;  /* frame readback ring; see guli_gl_recorder.c */
+struct GlRenderThread;   /* render-thread mode; see guli_gl_render_thread.c */
+struct GlLoader;         /* shared-context upload thread; see guli_gl_loader.c */
+struct GlDamage;         /* partial redraw and damage present; see guli_gl_damage.c */
+struct GlRetireQueue;    /* deferred object deletion; see guli_gl_retire.c */
+
 struct GLState {
     int has_active_frame;
     unsigned int frame_index;
     GuliSemaphore inflight_semaphore;
     unsigned int fullscreen_vao;  /* VAO for gl_VertexID fullscreen triangle (core profile) */
+    unsigned int current_program;  /* last glUseProgram on this context */
+    struct GlRecorderState* recorder;  /* non-NULL while a GuliRecorder is attached */
+    struct GlRenderThread* render_thread;  /* non-NULL while GL runs on a dedicated thread */
+    struct GlLoader* loader;  /* non-NULL while the loader thread runs */
+    int framebuffer_width;  /* size of the frame being rendered (set where GL executes) */
+    int framebuffer_height;
+    size_t framebuffer_bytes;  /* default framebuffer estimate counted under GULI_MEMORY_FRAMEBUFFER */
+    struct GlDamage* damage;  /* created by the first partial frame (context thread) */
+    struct GlRetireQueue* retire;  /* unloaded objects waiting for their frames to retire */
+    struct GlShaderReload* shader_reload;  /* non-NULL while shader hot reload is enabled */
+    int spirv_probed;
+    void (*specialize_shader)(void);  /* glSpecializeShader(ARB); NULL: no SPIR-V ingestion */
+    int indirect_count_probed;
+    void (*multi_draw_indirect_count)(void);  /* glMultiDrawElementsIndirectCount(ARB); NULL: fixed draw counts */
 };
 
 #endif /* GULI_GL_DEFINES_H */
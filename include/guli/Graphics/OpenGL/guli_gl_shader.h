@@ -16,12 +16,30 @@ GuliShader* GlShaderLoadFromFileEx(const char* vertPath, const char* fragPath,
     const char* vertexName, const char* fragmentName);
 void GlShaderUnload(GuliShader* shader);
 
+/* SPIR-V modules (GL 4.6 or GL_ARB_gl_spirv), else the desc's GLSL fallback */
+GuliShader* GlShaderLoadSpirv(const GuliShaderSpirvDesc* desc);
+int GlShaderIsSpirvSupported(void);
+
+/* Compute programs (GL 4.3): one GL_COMPUTE_SHADER stage */
+GuliShader* GlShaderLoadCompute(const char* csCode);
+GuliShader* GlShaderLoadComputeFromFile(const char* path);
+
+/** Work group size of a compute shader. Returns 0 (size zeroed) for other shaders. */
+int GlShaderGetLocalSize(const GuliShader* shader, int size[3]);
+
 /* Validation / location */
 int GlShaderIsValid(const GuliShader* shader);
 int GlShaderGetLocation(const GuliShader* shader, const char* uniformName);
 int GlShaderGetVertexLocation(const GuliShader* shader, const char* uniformName);
 int GlShaderGetDefaultLocation(GuliShader* shader, GuliShaderLocationIndex idx);
 
+/** GL uniform location behind loc (a cache slot for hot-reloadable shaders), or -1. For callers
+    that encode uniforms themselves, such as command lists. */
+int GlShaderResolveLocation(const GuliShader* shader, int loc);
+
+/** GL program name (0 if invalid). Immutable after load, so safe to read from any thread. */
+unsigned int GlShaderGetProgram(const GuliShader* shader);
+
 /* Use / set uniforms */
 void GlShaderUse(GuliShader* shader);
 void GlShaderSetFloat(GuliShader* restrict shader, int loc, float value);
@@ -34,6 +52,19 @@ void GlShaderSetColor(GuliShader* restrict shader, int loc, GULI_COLOR color);
 void GlShaderSetTexture(GuliShader* shader, int loc, GuliTexture* texture);
 void GlShaderSetTextureEx(GuliShader* restrict shader, int loc, GuliTexture* texture, int slot);
 
+/* Handles and debug names */
+GuliShaderHandle GlShaderGetHandle(const GuliShader* shader);
+GuliShader* GlShaderFromHandle(GuliShaderHandle handle);
+void GlShaderSetName(GuliShader* shader, const char* name);
+const char* GlShaderGetName(const GuliShader* shader);
+
+/* Hot reload (guli_gl_shader_reload.c). A reloadable shader hands out uniform cache slots as
+   locations, so they survive a program swap. ReplaceProgram moves src's program into dst,
+   retires dst's old one, re-resolves dst's locations and frees src. */
+void GlShaderReloadWatch(GuliShader* shader, const char* vertPath, const char* fragPath);
+void GlShaderMakeReloadable(GuliShader* shader);
+void GlShaderReplaceProgram(GuliShader* dst, GuliShader* src);
+
 /** Returns the last shader compile/link error string, or NULL if none. */
 const char* GlShaderGetCompileError(void);
 
@@ -0,0 +1,54 @@
+#ifndef GULI_BUFFER_H
+#define GULI_BUFFER_H
+
+#include "Core/guli_core.h"
+#include "Core/guli_pool.h"
+#include <stddef.h>
+
+typedef enum {
+    GULI_BUFFER_VERTEX = 0,
+    GULI_BUFFER_INDEX,
+    GULI_BUFFER_UNIFORM,
+    GULI_BUFFER_STORAGE,
+} GuliBufferType;
+
+/** GPU buffer handle. _backend is GLuint (OpenGL) or id<MTLBuffer> (Metal), stored as void*. */
+struct GuliBuffer {
+    void* _backend;
+    size_t size;
+    GuliBufferType type;
+    GuliHandle _handle;  /* slot in G_BufferPool */
+};
+typedef struct GuliBuffer GuliBuffer;
+
+/** Generational buffer reference: resolves to NULL once the buffer is unloaded. */
+typedef GuliHandle GuliBufferHandle;
+
+/** Pool holding every GuliBuffer (debug names as cold data). */
+extern GuliPool G_BufferPool;
+
+/** Create a buffer of size bytes, filled from data (may be NULL for uninitialized contents). */
+GuliBuffer* GuliBufferCreate(GuliBufferType type, const void* data, size_t size);
+
+/** Overwrite size bytes at offset. The range must lie inside the buffer. */
+void GuliBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size);
+
+/** Unload buffer and free resources. */
+void GuliBufferUnload(GuliBuffer* buffer);
+
+/** Check if buffer is valid (non-NULL and created). */
+int GuliBufferIsValid(const GuliBuffer* buffer);
+
+/** Handle of buffer (GULI_HANDLE_NULL for NULL). */
+GuliBufferHandle GuliBufferGetHandle(const GuliBuffer* buffer);
+
+/** Buffer a handle refers to, or NULL once it was unloaded. */
+GuliBuffer* GuliBufferFromHandle(GuliBufferHandle handle);
+
+/** Attach a debug name (truncated to GULI_RESOURCE_NAME_MAX - 1 bytes). */
+void GuliBufferSetName(GuliBuffer* buffer, const char* name);
+
+/** Debug name, or "" if none was set. */
+const char* GuliBufferGetName(const GuliBuffer* buffer);
+
+#endif /* GULI_BUFFER_H */
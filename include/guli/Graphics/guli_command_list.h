@@ -0,0 +1,50 @@
+#ifndef GULI_COMMAND_LIST_H
+#define GULI_COMMAND_LIST_H
+
+#include "guli_shader.h"
+#include "guli_texture.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Command lists for multi-threaded recording (OpenGL). Each list is filled by one
+ * thread at a time without touching the GL context; uniform data is copied into
+ * the list's own linear arena. Commands are grouped into packets, each with a sort
+ * key; GuliCommandListSubmit merges the packets of several lists into one ordered
+ * stream: ascending key, then list order, then record order, so the result does
+ * not depend on thread timing. State does not carry between packets after sorting,
+ * so every packet should set the shader and uniforms its draws need.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliCommandList GuliCommandList;
+
+/** Create an empty list. Returns NULL on failure. */
+GuliCommandList* GuliCommandListCreate(void);
+
+void GuliCommandListDestroy(GuliCommandList* list);
+
+/** Drop recorded commands, keeping the arena for the next frame. */
+void GuliCommandListReset(GuliCommandList* list);
+
+/** Start a new packet; commands recorded from here on are sorted by key. */
+void GuliCommandListSetKey(GuliCommandList* list, uint64_t key);
+
+/** Number of packets recorded since the last reset. */
+size_t GuliCommandListGetPacketCount(const GuliCommandList* list);
+
+/* Recording. Locations must come from GuliShaderGetLocation on the graphics thread beforehand. */
+void GuliCmdUseShader(GuliCommandList* list, GuliShader* shader);
+void GuliCmdSetFloat(GuliCommandList* list, GuliShader* shader, int loc, float value);
+void GuliCmdSetVec2(GuliCommandList* list, GuliShader* shader, int loc, const float v[2]);
+void GuliCmdSetVec3(GuliCommandList* list, GuliShader* shader, int loc, const float v[3]);
+void GuliCmdSetVec4(GuliCommandList* list, GuliShader* shader, int loc, const float v[4]);
+void GuliCmdSetInt(GuliCommandList* list, GuliShader* shader, int loc, int value);
+void GuliCmdSetMatrix4(GuliCommandList* list, GuliShader* shader, int loc, const float m[16]);
+void GuliCmdSetColor(GuliCommandList* list, GuliShader* shader, int loc, GULI_COLOR color);
+void GuliCmdSetTexture(GuliCommandList* list, GuliShader* shader, int loc, GuliTexture* texture, int slot);
+void GuliCmdDrawFullscreen(GuliCommandList* list);
+
+/** Merge and execute count lists on the graphics thread, between GuliBeginDraw and GuliEndDraw.
+    The lists are left intact; reset them before recording the next frame. */
+void GuliCommandListSubmit(GuliCommandList* const* lists, int count);
+
+#endif /* GULI_COMMAND_LIST_H */
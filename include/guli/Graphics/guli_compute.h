@@ -0,0 +1,69 @@
+#ifndef GULI_COMPUTE_H
+#define GULI_COMPUTE_H
+
+#include "guli_buffer.h"
+#include "guli_shader.h"
+#include "guli_texture.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Compute shaders (OpenGL 4.3; opt in with GuliInitEx(..., GULI_CONTEXT_COMPUTE)).
+ * A compute program is an ordinary GuliShader: locations, GuliShaderSet* and
+ * handles work as for graphics shaders. Bindings and barriers are context state,
+ * recorded like draws in render-thread mode.
+ *
+ * Images are the library's RGBA8 textures (declare them layout(rgba8) in GLSL);
+ * GuliTextureCreateFromPixels(w, h, NULL) gives an uninitialized target.
+ * Storage buffers are any GuliBuffer, GULI_BUFFER_STORAGE being the usual kind.
+ * ----------------------------------------------------------------------------- */
+
+typedef enum {
+    GULI_IMAGE_READ = 0,
+    GULI_IMAGE_WRITE,
+    GULI_IMAGE_READ_WRITE,
+} GuliImageAccess;
+
+/* GuliComputeMemoryBarrier bits: how later commands will read what compute wrote */
+#define GULI_BARRIER_STORAGE        0x001u  /* storage buffer access in shaders */
+#define GULI_BARRIER_IMAGE          0x002u  /* image load/store */
+#define GULI_BARRIER_TEXTURE_FETCH  0x004u  /* sampling with GuliShaderSetTexture */
+#define GULI_BARRIER_VERTEX         0x008u  /* vertex and index buffers */
+#define GULI_BARRIER_COMMAND        0x010u  /* indirect dispatch/draw arguments */
+#define GULI_BARRIER_UNIFORM        0x020u  /* uniform buffers */
+#define GULI_BARRIER_BUFFER_UPDATE  0x040u  /* GuliBufferUpdate and readbacks */
+#define GULI_BARRIER_FRAMEBUFFER    0x080u  /* rendering into a written texture */
+#define GULI_BARRIER_ALL            0xFFFFFFFFu
+
+/** 1 if the current context runs compute shaders (GL 4.3 or later). */
+int GuliComputeIsSupported(void);
+
+/** Compile a compute shader. Returns NULL on failure (GuliShaderGetCompileError has the log). */
+GuliShader* GuliShaderLoadCompute(const char* csCode);
+
+/** Same from a file, preprocessed like GuliShaderLoadFromFile (includes resolved). */
+GuliShader* GuliShaderLoadComputeFromFile(const char* path);
+
+/** Work group size declared by the shader (local_size_x/y/z). Returns 0 for non-compute shaders. */
+int GuliComputeGetLocalSize(const GuliShader* shader, int size[3]);
+
+/** Run groups_x * groups_y * groups_z work groups of shader. */
+void GuliComputeDispatch(GuliShader* shader, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z);
+
+/** Enough work groups to cover width x height x depth invocations (rounded up per axis). */
+void GuliComputeDispatchForSize(GuliShader* shader, uint32_t width, uint32_t height, uint32_t depth);
+
+/** Group counts read on the GPU from three uint32 at offset in buffer (offset a multiple of 4). */
+void GuliComputeDispatchIndirect(GuliShader* shader, GuliBuffer* buffer, size_t offset);
+
+/** Bind size bytes of buffer at offset (size 0: from offset to the end) to binding = N storage blocks.
+    NULL buffer unbinds. */
+void GuliComputeBindStorageBuffer(uint32_t binding, GuliBuffer* buffer, size_t offset, size_t size);
+
+/** Bind mip level of texture to image unit. NULL texture unbinds. */
+void GuliComputeBindImage(uint32_t unit, GuliTexture* texture, int level, GuliImageAccess access);
+
+/** Order the writes of earlier dispatches before the accesses named by bits (GULI_BARRIER_*). */
+void GuliComputeMemoryBarrier(uint32_t bits);
+
+#endif /* GULI_COMPUTE_H */
@@ -2,9 +2,33 @@
 #define GULI_GRAPHICS_H
 
 #include "Core/guli_core.h"
+#include "Core/guli_archive.h"
+#include "Core/guli_job.h"
 #include "guli_defines.h"
 #include "guli_shader.h"
 #include "guli_texture.h"
+#include "guli_buffer.h"
+#include "guli_recorder.h"
+#include "guli_render_thread.h"
+#ifdef GULI_BACKEND_OPENGL
+#include "guli_command_list.h"
+#include "guli_loader.h"
+#include "guli_shader_reload.h"
+#include "guli_compute.h"
+#include "guli_indirect.h"
+#endif
+#include "guli_texture_cache.h"
+#include "guli_resource_cache.h"
+#include "guli_shader_preprocess.h"
+
+/* Frame start shared by the backends: pinned jobs, then this context's frame arena,
+   then the invalidations this frame redraws */
+static inline void GuliBeginFrameCommon(void)
+{
+    GuliJobPumpRenderThread();
+    GuliFrameArenaReset();
+    GuliFramePacingBeginFrame();
+}
 
 /* Clear color; only valid between GuliBeginDraw and GuliEndDraw */
 #define GULI_CLEAR_COLOR_IMPL(CLEAR, HAS_ACTIVE) \
@@ -18,6 +42,8 @@
     static inline GuliShader* GuliShaderLoadFromMemoryEx(const char* vs, const char* fs, const char* vn, const char* fn) { return PREFIX##ShaderLoadFromMemoryEx(vs, fs, vn, fn); } \
     static inline GuliShader* GuliShaderLoadFromFile(const char* p1, const char* p2) { return PREFIX##ShaderLoadFromFile(p1, p2); } \
     static inline GuliShader* GuliShaderLoadFromFileEx(const char* p1, const char* p2, const char* vn, const char* fn) { return PREFIX##ShaderLoadFromFileEx(p1, p2, vn, fn); } \
+    static inline GuliShader* GuliShaderLoadSpirv(const GuliShaderSpirvDesc* d) { return PREFIX##ShaderLoadSpirv(d); } \
+    static inline int GuliShaderIsSpirvSupported(void) { return PREFIX##ShaderIsSpirvSupported(); } \
     static inline void GuliShaderUnload(GuliShader* s) { PREFIX##ShaderUnload(s); } \
     static inline int GuliShaderIsValid(const GuliShader* s) { return PREFIX##ShaderIsValid(s); } \
     static inline int GuliShaderGetLocation(const GuliShader* s, const char* n) { return PREFIX##ShaderGetLocation(s, n); } \
@@ -33,6 +59,10 @@
     static inline void GuliShaderSetColor(GuliShader* s, int l, GULI_COLOR c) { PREFIX##ShaderSetColor(s, l, c); } \
     static inline void GuliShaderSetTexture(GuliShader* s, int l, GuliTexture* t) { PREFIX##ShaderSetTexture(s, l, t); } \
     static inline void GuliShaderSetTextureEx(GuliShader* s, int l, GuliTexture* t, int slot) { PREFIX##ShaderSetTextureEx(s, l, t, slot); } \
+    static inline GuliShaderHandle GuliShaderGetHandle(const GuliShader* s) { return PREFIX##ShaderGetHandle(s); } \
+    static inline GuliShader* GuliShaderFromHandle(GuliShaderHandle h) { return PREFIX##ShaderFromHandle(h); } \
+    static inline void GuliShaderSetName(GuliShader* s, const char* n) { PREFIX##ShaderSetName(s, n); } \
+    static inline const char* GuliShaderGetName(const GuliShader* s) { return PREFIX##ShaderGetName(s); } \
     static inline const char* GuliShaderGetCompileError(void) { return PREFIX##ShaderGetCompileError(); }
 
 #define GULI_SHADER_API_METAL_VERTEX \
@@ -55,9 +85,10 @@
 #include "Metal/guli_metal.h"
 #include "Metal/guli_metal_shader.h"
 GULI_CLEAR_COLOR_IMPL(MetalClearColor, MetalHasActiveFrame)
-static inline void GuliBeginDraw(void) { MetalBeginDraw(); }
-static inline void GuliEndDraw(void) { MetalEndDraw(); }
+static inline void GuliBeginDraw(void) { GuliBeginFrameCommon(); MetalBeginDraw(); }
+static inline void GuliEndDraw(void) { MetalEndDraw(); GuliFramePacingEndFrame(); }
 static inline void GuliDrawFullscreen(void) { MetalDrawFullscreen(); }
+static inline int GuliGetVideoMemoryInfo(GuliVideoMemoryInfo* info) { return MetalGetVideoMemoryInfo(info); }
 GULI_SHADER_API_IMPL(Metal)
 GULI_SHADER_API_METAL_VERTEX
 #endif
@@ -66,15 +97,31 @@ GULI_SHADER_API_METAL_VERTEX
 #include "OpenGL/guli_gl.h"
 #include "OpenGL/guli_gl_shader.h"
 GULI_CLEAR_COLOR_IMPL(GlClearColor, GlHasActiveFrame)
-static inline void GuliBeginDraw(void) { GlBeginDraw(); }
-static inline void GuliEndDraw(void) { GlEndDraw(); }
+static inline void GuliBeginDraw(void) { GuliBeginFrameCommon(); GlBeginDraw(); }
+static inline void GuliEndDraw(void) { GlEndDraw(); GuliFramePacingEndFrame(); }
 static inline void GuliDrawFullscreen(void) { GlDrawFullscreen(); }
+static inline int GuliGetVideoMemoryInfo(GuliVideoMemoryInfo* info) { return GlGetVideoMemoryInfo(info); }
 GULI_SHADER_API_IMPL(Gl)
 GULI_SHADER_API_GL_VERTEX
 #endif
 
+/* Context-handle variants: bind ctx (NULL: the GuliInit context) to the calling thread, then forward */
+static inline void GuliContextBeginDraw(GuliContext* ctx) { GuliContextMakeCurrent(ctx); GuliBeginDraw(); }
+static inline void GuliContextEndDraw(GuliContext* ctx) { GuliContextMakeCurrent(ctx); GuliEndDraw(); }
+static inline void GuliContextClearColor(GuliContext* ctx, GULI_COLOR color) { GuliContextMakeCurrent(ctx); GuliClearColor(color); }
+static inline void GuliContextDrawFullscreen(GuliContext* ctx) { GuliContextMakeCurrent(ctx); GuliDrawFullscreen(); }
+
 /** Type-generic scalar uniform setter. Use for float or int based on value type. */
 #define GuliShaderSetScalar(shader, loc, value) \
     _Generic((value), float: GuliShaderSetFloat, int: GuliShaderSetInt)(shader, loc, value)
 
+/** Compile shader sources straight from archive views (no copy). Metal keeps both stages in vsName; fsName may be NULL. */
+static inline GuliShader* GuliShaderLoadFromArchive(GuliArchive* archive, const char* vsName, const char* fsName)
+{
+    GuliAssetView vs = {0}, fs = {0};
+    if (!GuliArchiveFind(archive, vsName, &vs)) return NULL;
+    if (fsName && !GuliArchiveFind(archive, fsName, &fs)) return NULL;
+    return GuliShaderLoadFromMemory((const char*)vs.data, (const char*)fs.data);
+}
+
 #endif // GULI_GRAPHICS_H
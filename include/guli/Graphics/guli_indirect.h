@@ -0,0 +1,86 @@
+#ifndef GULI_INDIRECT_H
+#define GULI_INDIRECT_H
+
+#include "guli_buffer.h"
+#include "guli_shader.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * GPU-driven drawing (OpenGL 4.3, see GULI_CONTEXT_COMPUTE). A scene keeps its
+ * objects (bounding sphere + mesh) in storage buffers. GuliIndirectSceneCull runs
+ * a compute pass that tests every object against the frustum and writes one
+ * DrawElementsIndirectCommand per visible object; GuliIndirectSceneDraw then
+ * submits them all with one glMultiDrawElementsIndirect. Where
+ * GL_ARB_indirect_parameters (or GL 4.6) is available the commands are compacted
+ * and the GPU supplies the draw count; elsewhere culled objects keep their
+ * command with zero instances.
+ *
+ * Each command's baseInstance is the object index, which the vertex shader
+ * receives as a per-instance attribute:
+ *
+ *     layout(location = GULI_INDIRECT_DRAW_ID_LOCATION) in uint guli_draw_id;
+ *
+ * and uses to index its own per-object storage buffer (transforms, materials),
+ * bound with GuliComputeBindStorageBuffer. Indices are 32-bit; vertex attributes
+ * are floats from one interleaved buffer.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_INDIRECT_DRAW_ID_LOCATION 15  /* vertex attributes must use lower locations */
+#define GULI_INDIRECT_CULL_GROUP_SIZE 64
+
+/** Range of the shared index buffer drawn for a mesh. */
+typedef struct {
+    uint32_t index_count;
+    uint32_t first_index;
+    int32_t base_vertex;
+    uint32_t _pad;
+} GuliIndirectMesh;
+
+/** Per-object culling data (std430 layout, 32 bytes). */
+typedef struct {
+    float sphere[4];         /* world-space center xyz, radius w */
+    uint32_t mesh;           /* index into the scene's meshes */
+    uint32_t _pad[3];
+} GuliIndirectObject;
+
+typedef struct {
+    uint32_t location;       /* < GULI_INDIRECT_DRAW_ID_LOCATION */
+    uint32_t components;     /* 1-4 floats */
+    uint32_t offset;         /* bytes into the vertex */
+} GuliVertexAttribute;
+
+typedef struct {
+    GuliBuffer* vertices;    /* interleaved vertices, stride bytes apart */
+    GuliBuffer* indices;     /* uint32 indices */
+    uint32_t stride;
+    const GuliVertexAttribute* attributes;
+    int attribute_count;
+    const GuliIndirectMesh* meshes;  /* copied */
+    uint32_t mesh_count;
+    uint32_t max_objects;
+} GuliIndirectSceneDesc;
+
+typedef struct GuliIndirectScene GuliIndirectScene;
+
+/** Create a scene. The vertex and index buffers stay owned by the caller. Returns NULL on failure. */
+GuliIndirectScene* GuliIndirectSceneCreate(const GuliIndirectSceneDesc* desc);
+
+void GuliIndirectSceneDestroy(GuliIndirectScene* scene);
+
+/** Upload count objects starting at index first. Returns 0 if the range or a mesh index is out of bounds. */
+int GuliIndirectSceneSetObjects(GuliIndirectScene* scene, uint32_t first, const GuliIndirectObject* objects, uint32_t count);
+
+/** Objects [0, count) take part in culling and drawing (count <= max_objects). */
+void GuliIndirectSceneSetObjectCount(GuliIndirectScene* scene, uint32_t count);
+
+/** Frustum-cull the objects against view_proj (column-major, clip space -w..w) and rebuild the draw
+    commands on the GPU. Rebinds storage buffer bindings 0-3. */
+void GuliIndirectSceneCull(GuliIndirectScene* scene, const float view_proj[16]);
+
+/** Draw the objects the last cull kept with shader, in one call. */
+void GuliIndirectSceneDraw(GuliIndirectScene* scene, GuliShader* shader);
+
+/** 1 if the GPU supplies the draw count (compacted commands). */
+int GuliIndirectSceneHasDrawCount(const GuliIndirectScene* scene);
+
+#endif /* GULI_INDIRECT_H */
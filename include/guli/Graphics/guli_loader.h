@@ -0,0 +1,60 @@
+#ifndef GULI_LOADER_H
+#define GULI_LOADER_H
+
+#include "guli_buffer.h"
+#include "guli_shader.h"
+#include "guli_texture.h"
+#include <stddef.h>
+
+/* -----------------------------------------------------------------------------
+ * Background resource creation (OpenGL). The loader thread owns a hidden window
+ * whose context shares objects with the main one (GLX/WGL/EGL, whichever GLFW
+ * created), so textures, buffers and programs are uploaded and compiled there.
+ * Each finished upload is fenced; polling hands the object over once the fence
+ * has signaled, so the drawing thread never waits on large uploads or compiles.
+ * Without a running loader the same calls complete synchronously.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliUpload GuliUpload;
+
+typedef enum {
+    GULI_UPLOAD_PENDING = 0,
+    GULI_UPLOAD_READY,
+    GULI_UPLOAD_FAILED,
+} GuliUploadStatus;
+
+/** Create the shared context and start the loader. Call after GuliInit and before
+    GuliRenderThreadStart, on the main thread. Returns 1 on success. */
+int GuliLoaderStart(void);
+
+/** Stop the loader; queued uploads fail. GuliShutdown calls this. */
+void GuliLoaderStop(void);
+
+/** 1 while the loader thread runs. */
+int GuliLoaderIsActive(void);
+
+/** Queue a texture upload. pixels (as for GuliTextureCreateFromLevels) must stay valid
+    until the upload leaves GULI_UPLOAD_PENDING. Returns NULL on failure. */
+GuliUpload* GuliUploadTexture(int width, int height, int levels, const unsigned char* const* pixels);
+
+/** Queue a shader compile. Sources are copied; NULL selects the default stage. */
+GuliUpload* GuliUploadShader(const char* vsCode, const char* fsCode);
+
+/** Queue a buffer upload. data must stay valid until the upload leaves GULI_UPLOAD_PENDING. */
+GuliUpload* GuliUploadBuffer(GuliBufferType type, const void* data, size_t size);
+
+/** Non-blocking check from the drawing thread. READY once the object can be used there. */
+GuliUploadStatus GuliUploadPoll(GuliUpload* upload);
+
+/** Block until the loader has finished the upload (the GPU-side wait stays asynchronous). */
+GuliUploadStatus GuliUploadWait(GuliUpload* upload);
+
+/** The created object once READY, else NULL. The caller owns it from then on. */
+GuliTexture* GuliUploadGetTexture(const GuliUpload* upload);
+GuliShader* GuliUploadGetShader(const GuliUpload* upload);
+GuliBuffer* GuliUploadGetBuffer(const GuliUpload* upload);
+
+/** Free the ticket. An object not yet READY is destroyed. */
+void GuliUploadRelease(GuliUpload* upload);
+
+#endif /* GULI_LOADER_H */
@@ -0,0 +1,55 @@
+#ifndef GULI_RECORDER_H
+#define GULI_RECORDER_H
+
+#include "Core/guli_core.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Frame-sequence recorder: captures every GuliEndDraw frame to disk.
+ * Readback is asynchronous (backend) and encoding runs on worker threads.
+ * ----------------------------------------------------------------------------- */
+
+/* Output format */
+typedef enum {
+    GULI_RECORD_QOI = 0,  /* lossless, one file per frame: <path>/frame_000000.qoi */
+    GULI_RECORD_Y4M,      /* raw YUV4MPEG2 4:4:4 stream in a single file at <path> */
+} GuliRecordFormat;
+
+typedef struct {
+    const char* path;         /* output directory (QOI) or file (Y4M) */
+    GuliRecordFormat format;
+    int workers;              /* encoder threads; <= 0 picks one per two cores (max 8) */
+    int queue_frames;         /* bounded frame queue depth; <= 0 defaults to 8 */
+    int drop_when_full;       /* 0: block GuliEndDraw until a slot frees (backpressure), 1: drop the frame */
+    int fps;                  /* Y4M header frame rate; <= 0 defaults to 60 */
+} GuliRecorderDesc;
+
+typedef struct {
+    uint64_t frames_captured;  /* frames read back from the GPU */
+    uint64_t frames_written;   /* frames encoded and written to disk */
+    uint64_t frames_dropped;   /* queue full (drop_when_full) or size change during Y4M */
+    uint64_t bytes_written;
+    uint32_t queue_high_water; /* max frames waiting for an encoder */
+    double stall_seconds;      /* time GuliEndDraw spent blocked on a full queue */
+} GuliRecorderStats;
+
+typedef struct GuliRecorder GuliRecorder;
+
+/** Start recording frames presented by GuliEndDraw. One recorder at a time. Returns NULL on failure. */
+GuliRecorder* GuliRecorderStart(const GuliRecorderDesc* desc);
+
+/** Flush pending readbacks, drain the queue, close output and free the recorder. */
+void GuliRecorderStop(GuliRecorder* recorder);
+
+/** Snapshot of recorder counters. Safe to call while recording. */
+void GuliRecorderGetStats(GuliRecorder* recorder, GuliRecorderStats* stats);
+
+/* Backend interface: called by the backend readback path on the render thread. */
+
+/** Reserve a queue slot for a width x height RGBA frame. Returns pixel storage or NULL when dropped. */
+unsigned char* GuliRecorderAcquireFrame(GuliRecorder* recorder, int width, int height);
+
+/** Hand the frame from GuliRecorderAcquireFrame to the encoders (NULL releases it). flipY: rows are bottom-up. */
+void GuliRecorderSubmitFrame(GuliRecorder* recorder, unsigned char* pixels, int flipY);
+
+#endif /* GULI_RECORDER_H */
@@ -0,0 +1,22 @@
+#ifndef GULI_RENDER_THREAD_H
+#define GULI_RENDER_THREAD_H
+
+/* -----------------------------------------------------------------------------
+ * Optional render-thread mode (OpenGL). Once started, drawing calls made on this
+ * thread are recorded into a compact command buffer and replayed one frame behind
+ * by a dedicated thread that owns the GL context, with two frames in the pipe.
+ * Resource creation and queries (shader/texture loads, uniform lookups) block
+ * until the render thread has run them; unloads are queued in order with drawing.
+ * Drawing calls must stay on the thread that started the mode.
+ * ----------------------------------------------------------------------------- */
+
+/** Move GL execution to a render thread. Call after GuliInit, outside a frame. Returns 1 on success. */
+int GuliRenderThreadStart(void);
+
+/** Flush recorded work, join the render thread and take the context back. GuliShutdown calls this. */
+void GuliRenderThreadStop(void);
+
+/** 1 while render-thread mode is on. */
+int GuliRenderThreadIsActive(void);
+
+#endif /* GULI_RENDER_THREAD_H */
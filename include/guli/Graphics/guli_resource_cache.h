@@ -0,0 +1,63 @@
+#ifndef GULI_RESOURCE_CACHE_H
+#define GULI_RESOURCE_CACHE_H
+
+#include "guli_shader.h"
+#include "guli_texture.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Shared resource cache. Textures and shaders are keyed by their canonical
+ * (realpath) source path(s) plus load parameters; acquiring the same key again returns the same
+ * object with its reference count raised. Objects nobody references stay cached
+ * on an LRU list and are unloaded, oldest first, while the cache is over its
+ * memory budget.
+ *
+ * The cache is single-threaded: acquires load on the calling thread, so it belongs
+ * to the drawing thread that creates it (the recording thread in render-thread
+ * mode). Acquire, trim, set the budget and destroy there; other threads fail with
+ * GULI_ERROR_ASSERTION_FAILED. Only retain and release may come from other
+ * threads; evictions a foreign release would trigger wait for the owner's next
+ * call. To load off the drawing thread, decode there and hand the data to
+ * guli_loader.h instead.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliResourceCache GuliResourceCache;
+
+typedef struct {
+    uint32_t entries;        /* cached objects */
+    uint32_t referenced;     /* entries with a reference count above zero */
+    uint64_t bytes;          /* GPU size of the cached textures, as counted under GULI_MEMORY_TEXTURE */
+    uint64_t budget;         /* 0: unlimited */
+    uint64_t hits;           /* acquires served from a loaded entry */
+    uint64_t misses;         /* acquires that loaded */
+    uint64_t evictions;
+} GuliResourceCacheStats;
+
+/** Create a cache owned by the calling thread. budget_bytes limits unreferenced textures kept around (0: never evict). */
+GuliResourceCache* GuliResourceCacheCreate(size_t budget_bytes);
+
+/** Unload every cached object. Objects still referenced are unloaded too (reported as leaks). */
+void GuliResourceCacheDestroy(GuliResourceCache* cache);
+
+/** Change the budget; evicts immediately if the cache is over it. */
+void GuliResourceCacheSetBudget(GuliResourceCache* cache, size_t budget_bytes);
+
+/** Shared texture for (path, GULI_PIXEL_* flags), loaded on first use. Returns NULL on failure. */
+GuliTexture* GuliResourceAcquireTexture(GuliResourceCache* cache, const char* path, unsigned int flags);
+
+/** Shared shader for (vertPath, fragPath), compiled on first use. Returns NULL on failure. */
+GuliShader* GuliResourceAcquireShader(GuliResourceCache* cache, const char* vertPath, const char* fragPath);
+
+/** Take another reference to an object returned by an acquire. */
+void GuliResourceRetain(GuliResourceCache* cache, const void* object);
+
+/** Drop a reference taken by an acquire or retain. At zero the object moves to the LRU list. */
+void GuliResourceRelease(GuliResourceCache* cache, const void* object);
+
+/** Unload unreferenced objects, oldest first, until the cache holds at most target_bytes. */
+void GuliResourceCacheTrim(GuliResourceCache* cache, size_t target_bytes);
+
+void GuliResourceCacheGetStats(GuliResourceCache* cache, GuliResourceCacheStats* stats);
+
+#endif /* GULI_RESOURCE_CACHE_H */
@@ -2,12 +2,16 @@
 #define GULI_SHADER_H
 
 #include "Core/guli_core.h"
+#include "Core/guli_pool.h"
 #include "guli_defines.h"
 
 /* Opaque shader handle. Backend-specific data inside. */
 struct GuliShader;
 typedef struct GuliShader GuliShader;
 
+/** Generational shader reference: resolves to NULL once the shader is unloaded. */
+typedef GuliHandle GuliShaderHandle;
+
 /* Uniform data types (matches GLSL/Metal scalar/vector types) */
 typedef enum {
     GULI_SHADER_UNIFORM_FLOAT,
@@ -26,6 +30,29 @@ typedef enum {
     GULI_SHADER_LOC_COUNT,
 } GuliShaderLocationIndex;
 
+/** Specialization constant: the SPIR-V constant_id and its raw 32-bit value (bool/int/uint; floats by bit pattern). */
+typedef struct {
+    uint32_t id;
+    uint32_t value;
+} GuliShaderSpecConstant;
+
+/* Offline-compiled SPIR-V modules plus the source to compile where SPIR-V cannot be
+   consumed (no GL 4.6 / GL_ARB_gl_spirv, or Metal). The fallback sees each constant as
+   "#define GULI_SPEC_CONSTANT_<id> <value>u". Uniform lookups by name need the modules
+   to keep their debug names (do not strip OpName). */
+typedef struct {
+    const void* vs_spirv;
+    size_t vs_size;                            /* bytes, multiple of 4 */
+    const void* fs_spirv;
+    size_t fs_size;
+    const char* vs_entry;                      /* NULL: "main" */
+    const char* fs_entry;
+    const GuliShaderSpecConstant* constants;
+    int constant_count;
+    const char* vs_source;                     /* fallback; Metal: both stages in vs_source */
+    const char* fs_source;
+} GuliShaderSpirvDesc;
+
 _Static_assert(GULI_SHADER_LOC_COUNT >= 2, "GULI_SHADER_LOC_COUNT must include color and MVP");
 
 #endif // GULI_SHADER_H
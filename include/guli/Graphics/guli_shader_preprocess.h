@@ -0,0 +1,76 @@
+#ifndef GULI_SHADER_PREPROCESS_H
+#define GULI_SHADER_PREPROCESS_H
+
+#include "guli_shader.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Shader preprocessing. Resolves #include "file" (relative to the including
+ * file; #include <file> too when such a file exists, else it is left for the
+ * compiler, e.g. <metal_stdlib>), honours #pragma once, and puts the #version
+ * line first with the requested #defines right after it; defines whose name
+ * appears nowhere in the source are left out. GLSL output (a
+ * #version is present) carries #line markers so compile errors point at the
+ * original file and line; the source-string number is the file's index in
+ * include order, 0 being the root.
+ *
+ * Processed files are cached by (path, version, define set) and revalidated
+ * against the modification time of every file they pulled in.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_SHADER_INCLUDE_DEPTH_MAX 16
+
+typedef struct {
+    const char* name;
+    const char* value;       /* NULL: defined as 1 */
+} GuliShaderDefine;
+
+/** Preprocess the file at path. version (e.g. "330 core") replaces the file's own #version; NULL keeps it.
+    Define order does not matter. Returns text to free with GuliFree, or NULL on failure. */
+char* GuliShaderPreprocess(const char* path, const char* version, const GuliShaderDefine* defines, int define_count);
+
+/** Same for in-memory source; includes resolve against include_dir (NULL: the working directory). Not cached. */
+char* GuliShaderPreprocessSource(const char* source, const char* include_dir, const char* version,
+    const GuliShaderDefine* defines, int define_count);
+
+/** Source with each constant injected as #define GULI_SPEC_CONSTANT_<id> <value>u (the SPIR-V fallback path). */
+char* GuliShaderPreprocessSpecConstants(const char* source, const GuliShaderSpecConstant* constants, int count);
+
+/** Call fn with each file the cached GuliShaderPreprocess(path, version, no defines) read, root first.
+    Returns the number of files (0: not cached). */
+int GuliShaderPreprocessForEachDependency(const char* path, const char* version,
+    void (*fn)(void* user, const char* file), void* user);
+
+/** Drop every cached processed file. */
+void GuliShaderPreprocessClearCache(void);
+
+/* -----------------------------------------------------------------------------
+ * Shader permutations. A variant set builds a shader per define set on first
+ * request. Define sets that preprocess to identical sources (e.g. defines the
+ * shader never tests) share one compiled shader, so the driver sees each
+ * distinct source once. Builds compile on the calling thread, so a set belongs
+ * to the drawing thread that creates it (the recording thread in render-thread
+ * mode); only GuliShaderVariantsGetStats may be called from other threads.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliShaderVariants GuliShaderVariants;
+
+typedef struct {
+    uint32_t variants;       /* define sets requested */
+    uint32_t shaders;        /* distinct shaders compiled */
+    uint32_t failures;       /* define sets that failed to preprocess or compile */
+} GuliShaderVariantStats;
+
+/** Variant set owned by the calling thread, over vertPath/fragPath (Metal: both stages in vertPath, fragPath NULL). version as for GuliShaderPreprocess. */
+GuliShaderVariants* GuliShaderVariantsCreate(const char* vertPath, const char* fragPath, const char* version);
+
+/** Unload every shader the set built. Owner thread only. */
+void GuliShaderVariantsDestroy(GuliShaderVariants* variants);
+
+/** Shader for a define set, built on first use and owned by the set. Returns NULL if it fails to build or
+    when called off the owner thread (GULI_ERROR_ASSERTION_FAILED). */
+GuliShader* GuliShaderVariantsGet(GuliShaderVariants* variants, const GuliShaderDefine* defines, int define_count);
+
+void GuliShaderVariantsGetStats(GuliShaderVariants* variants, GuliShaderVariantStats* stats);
+
+#endif // GULI_SHADER_PREPROCESS_H
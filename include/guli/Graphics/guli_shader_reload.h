@@ -0,0 +1,36 @@
+#ifndef GULI_SHADER_RELOAD_H
+#define GULI_SHADER_RELOAD_H
+
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Shader hot reload (OpenGL, development builds). While enabled, every shader
+ * loaded with GuliShaderLoadFromFile is watched together with the files it
+ * #includes (inotify on Linux, modification times elsewhere). An edit queues a
+ * recompile, on the loader's shared context when GuliLoaderStart has run, else
+ * on the drawing thread. Once the new program links, it replaces the old one
+ * behind the same GuliShader at the next GuliBeginDraw; a failed compile keeps
+ * the last good program.
+ *
+ * Locations returned for a watched shader are slots that stay valid across
+ * reloads; a uniform the current program lacks still gets one (setting it does
+ * nothing until a reload adds the uniform).
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t watched;        /* shaders being watched */
+    uint32_t reloads;        /* programs swapped in */
+    uint32_t failures;       /* edits that did not compile (the previous program stayed) */
+} GuliShaderReloadStats;
+
+/** Start watching shaders loaded from files from now on. Returns 1 on success. */
+int GuliShaderHotReloadEnable(void);
+
+/** Stop watching; shaders keep their current programs. Recompiles in flight are dropped. */
+void GuliShaderHotReloadDisable(void);
+
+int GuliShaderHotReloadIsEnabled(void);
+
+void GuliShaderHotReloadGetStats(GuliShaderReloadStats* stats);
+
+#endif /* GULI_SHADER_RELOAD_H */
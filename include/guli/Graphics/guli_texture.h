@@ -2,6 +2,8 @@
 #define GULI_TEXTURE_H
 
 #include "Core/guli_core.h"
+#include "Core/guli_archive.h"
+#include "Core/guli_pool.h"
 #include <stddef.h>
 
 /** Texture handle. _backend is GLuint (OpenGL) or id<MTLTexture> (Metal), stored as void*. */
@@ -9,15 +11,35 @@ struct GuliTexture {
     void* _backend;
     int width;
     int height;
+    GuliHandle _handle;  /* slot in G_TexturePool */
+    size_t _bytes;       /* storage counted under GULI_MEMORY_TEXTURE */
 };
 typedef struct GuliTexture GuliTexture;
 
+/** Generational texture reference: resolves to NULL once the texture is unloaded. */
+typedef GuliHandle GuliTextureHandle;
+
+/** Pool holding every GuliTexture (debug names as cold data). Backends allocate through GuliTextureAlloc. */
+extern GuliPool G_TexturePool;
+
 /** Create texture from RGBA pixel data (row-major, 4 bytes per pixel). */
 GuliTexture* GuliTextureCreateFromPixels(int width, int height, const unsigned char* pixels);
 
+/** Create mipmapped texture. pixels[i] is RGBA level i of size max(1, width >> i) x max(1, height >> i). */
+GuliTexture* GuliTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels);
+
 /** Load texture from file (PNG, JPG, BMP, TGA, etc. via stb_image). Returns NULL on failure. */
 GuliTexture* GuliTextureLoadFromFile(const char* path);
 
+/** Load texture from file, applying GULI_PIXEL_* conversion flags (e.g. FLIP_Y, PREMULTIPLY) before upload. */
+GuliTexture* GuliTextureLoadFromFileEx(const char* path, unsigned int flags);
+
+/** Decode an encoded image held in memory (e.g. a GuliAssetView) and upload it. */
+GuliTexture* GuliTextureLoadFromMemory(const void* data, size_t size, unsigned int flags);
+
+/** Load the named archive entry as a texture, decoding directly from the mapped view. */
+GuliTexture* GuliTextureLoadFromArchive(GuliArchive* archive, const char* name, unsigned int flags);
+
 /** Unload texture and free resources. */
 void GuliTextureUnload(GuliTexture* texture);
 
@@ -27,6 +49,21 @@ void GuliTextureGetSize(const GuliTexture* texture, int* width, int* height);
 /** Check if texture is valid (non-NULL and loaded). */
 int GuliTextureIsValid(const GuliTexture* texture);
 
+/** Handle of texture (GULI_HANDLE_NULL for NULL). */
+GuliTextureHandle GuliTextureGetHandle(const GuliTexture* texture);
+
+/** Texture a handle refers to, or NULL once it was unloaded. */
+GuliTexture* GuliTextureFromHandle(GuliTextureHandle handle);
+
+/** Attach a debug name (truncated to GULI_RESOURCE_NAME_MAX - 1 bytes). */
+void GuliTextureSetName(GuliTexture* texture, const char* name);
+
+/** Debug name, or "" if none was set. */
+const char* GuliTextureGetName(const GuliTexture* texture);
+
+/** Zeroed pooled texture object with its handle set (backend use). */
+GuliTexture* GuliTextureAlloc(void);
+
 _Static_assert(sizeof(GuliTexture) >= 12, "GuliTexture must hold backend ptr and dimensions");
 _Static_assert(offsetof(GuliTexture, width) >= sizeof(void*), "GuliTexture layout");
 
@@ -0,0 +1,37 @@
+#ifndef GULI_TEXTURE_CACHE_H
+#define GULI_TEXTURE_CACHE_H
+
+#include "guli_texture.h"
+#include <stdint.h>
+
+/* -----------------------------------------------------------------------------
+ * Pre-decoded texture cache. Each source image is decoded once into an aligned
+ * .gtc container (keyed by source path, size and mtime); later loads mmap the
+ * container and upload straight from the mapped pages.
+ * ----------------------------------------------------------------------------- */
+
+/* Load flags (part of the cache key) */
+#define GULI_TEXTURE_CACHE_MIPMAPS 0x1u  /* store and upload a full box-filtered mip chain */
+
+typedef struct GuliTextureCache GuliTextureCache;
+
+typedef struct {
+    uint32_t hits;        /* loaded from a valid cache entry */
+    uint32_t misses;      /* no entry: decoded and written */
+    uint32_t stale;       /* entry rejected (source changed or bad header) and rebuilt */
+    uint64_t bytes_mapped;
+} GuliTextureCacheStats;
+
+/** Open (and create if needed) a cache directory. Returns NULL on failure. */
+GuliTextureCache* GuliTextureCacheOpen(const char* dir);
+
+/** Close the cache. Textures already loaded stay valid. */
+void GuliTextureCacheClose(GuliTextureCache* cache);
+
+/** Load a texture through the cache. Decodes and writes the entry on a miss. Returns NULL on failure. */
+GuliTexture* GuliTextureCacheLoad(GuliTextureCache* cache, const char* path, unsigned int flags);
+
+/** Cache hit/miss counters. */
+void GuliTextureCacheGetStats(const GuliTextureCache* cache, GuliTextureCacheStats* stats);
+
+#endif /* GULI_TEXTURE_CACHE_H */
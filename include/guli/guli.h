@@ -2,6 +2,8 @@
 #define GULI_H
 
 #include "Core/guli_core.h"
+#include "Core/guli_pixel.h"
+#include "Core/guli_transform.h"
 #include "Graphics/guli_graphics.h"
 
 #endif /* GULI_H */
@@ -8,6 +8,14 @@
 
 typedef vec4 GULI_COLOR;
 
+/** Rectangle in framebuffer pixels, origin at the top-left. */
+typedef struct {
+    int x, y, width, height;
+} GuliRect;
+
+/* Dirty rectangles tracked per frame before they are merged into one */
+#define GULI_MAX_DIRTY_RECTS 8
+
 // Colors
 #define GULI_COLOR_WHITE (GULI_COLOR){1.0f, 1.0f, 1.0f, 1.0f}
 #define GULI_COLOR_BLACK (GULI_COLOR){0.0f, 0.0f, 0.0f, 1.0f}
@@ -0,0 +1,562 @@
+#include "Core/guli_archive.h"
+#include "Core/guli_error.h"
+#include "Core/guli_file.h"
+#include "Core/guli_hash.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_thread.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* -----------------------------------------------------------------------------
+ * Archive container (.gpak)
+ *
+ *   [GpakHeader][GpakEntry x count][names, NUL-terminated] ... pad ...
+ *   [entry 0 @ 4 KiB][0] ... pad ... [entry 1 @ 4 KiB][0] ...
+ *
+ * The table is sorted by (hash, name). Every entry is followed by at least one
+ * zero byte so raw views double as C strings.
+ * ----------------------------------------------------------------------------- */
+
+#define GPAK_MAGIC 0x4b415047u  /* "GPAK" */
+#define GPAK_VERSION 1u
+#define GPAK_ALIGN 4096u
+#define GPAK_ENTRY_LZ4 0x1u
+#define GPAK_PATH_MAX 4096
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t names_size;
+    uint64_t file_size;
+} GpakHeader;
+
+typedef struct {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t stored_size;
+    uint64_t size;         /* decompressed size */
+    uint32_t name_offset;  /* into the name block */
+    uint32_t flags;
+} GpakEntry;
+
+struct GuliArchive {
+    GuliFileMapping map;
+    const GpakHeader* header;
+    const GpakEntry* toc;
+    const char* names;
+    GuliMutex lock;
+    unsigned char** decoded;  /* per entry, LZ4 entries only; filled on first access */
+};
+
+static uint64_t GpakAlignUp(uint64_t v, uint64_t a)
+{
+    return (v + a - 1) & ~(a - 1);
+}
+
+static uint64_t GpakHashName(const char* name)
+{
+    return GuliHashFNV1a64(name, strlen(name));
+}
+
+/* -----------------------------------------------------------------------------
+ * LZ4 block format (greedy single-probe compressor, bounds-checked decoder)
+ * ----------------------------------------------------------------------------- */
+
+#define LZ4_HASH_BITS 16
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_MAX_OFFSET 65535u
+
+static uint32_t Lz4Read32(const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static size_t Lz4Bound(size_t n)
+{
+    return n + n / 255 + 16;
+}
+
+static unsigned char* Lz4WriteLength(unsigned char* op, size_t len)
+{
+    for (; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+/* dst must hold Lz4Bound(n) bytes. Returns the compressed size. */
+static size_t Lz4Compress(const unsigned char* src, size_t n, unsigned char* dst, uint32_t* table)
+{
+    unsigned char* op = dst;
+    size_t anchor = 0;
+    size_t ip = 0;
+
+    memset(table, 0, sizeof(uint32_t) << LZ4_HASH_BITS);
+    if (n >= LZ4_MF_LIMIT + 1)
+    {
+        const size_t limit = n - LZ4_MF_LIMIT;
+        const size_t matchLimit = n - LZ4_LAST_LITERALS;
+        while (ip < limit)
+        {
+            const uint32_t seq = Lz4Read32(src + ip);
+            const uint32_t h = (seq * 2654435761u) >> (32 - LZ4_HASH_BITS);
+            const uint32_t slot = table[h];  /* position + 1; 0 = empty */
+            table[h] = (uint32_t)(ip + 1);
+
+            if (!slot || ip - (slot - 1) > LZ4_MAX_OFFSET || Lz4Read32(src + slot - 1) != seq)
+            {
+                ip++;
+                continue;
+            }
+
+            const size_t ref = slot - 1;
+            size_t len = LZ4_MIN_MATCH;
+            while (ip + len < matchLimit && src[ref + len] == src[ip + len]) len++;
+
+            const size_t lit = ip - anchor;
+            const size_t ml = len - LZ4_MIN_MATCH;
+            unsigned char* token = op++;
+            *token = (unsigned char)(((lit < 15 ? lit : 15) << 4) | (ml < 15 ? ml : 15));
+            if (lit >= 15) op = Lz4WriteLength(op, lit - 15);
+            memcpy(op, src + anchor, lit);
+            op += lit;
+            const size_t off = ip - ref;
+            *op++ = (unsigned char)(off & 0xff);
+            *op++ = (unsigned char)(off >> 8);
+            if (ml >= 15) op = Lz4WriteLength(op, ml - 15);
+
+            ip += len;
+            anchor = ip;
+        }
+    }
+
+    const size_t lit = n - anchor;
+    *op++ = (unsigned char)((lit < 15 ? lit : 15) << 4);
+    if (lit >= 15) op = Lz4WriteLength(op, lit - 15);
+    memcpy(op, src + anchor, lit);
+    op += lit;
+    return (size_t)(op - dst);
+}
+
+/* Returns 1 if src decodes to exactly dstSize bytes. */
+static int Lz4Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize)
+{
+    size_t ip = 0, op = 0;
+    while (ip < srcSize)
+    {
+        const unsigned int token = src[ip++];
+        size_t lit = token >> 4;
+        if (lit == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= srcSize) return 0;
+                b = src[ip++];
+                lit += b;
+            } while (b == 255);
+        }
+        if (lit > srcSize - ip || lit > dstSize - op) return 0;
+        memcpy(dst + op, src + ip, lit);
+        ip += lit;
+        op += lit;
+        if (ip == srcSize) break;  /* last sequence carries literals only */
+
+        if (srcSize - ip < 2) return 0;
+        const size_t off = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+        if (off == 0 || off > op) return 0;
+
+        size_t ml = token & 15;
+        if (ml == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= srcSize) return 0;
+                b = src[ip++];
+                ml += b;
+            } while (b == 255);
+        }
+        ml += LZ4_MIN_MATCH;
+        if (ml > dstSize - op) return 0;
+
+        const unsigned char* ref = dst + op - off;
+        if (off >= ml)
+        {
+            memcpy(dst + op, ref, ml);
+        }
+        else
+        {
+            for (size_t i = 0; i < ml; i++) dst[op + i] = ref[i];  /* overlapping run */
+        }
+        op += ml;
+    }
+    return op == dstSize;
+}
+
+/* -----------------------------------------------------------------------------
+ * Reader
+ * ----------------------------------------------------------------------------- */
+
+static int GpakValidate(const GuliFileMapping* map)
+{
+    if (map->size < sizeof(GpakHeader)) return 0;
+    const GpakHeader* h = (const GpakHeader*)map->data;
+    if (h->magic != GPAK_MAGIC || h->version != GPAK_VERSION || h->file_size != map->size) return 0;
+
+    const uint64_t tableEnd = sizeof(GpakHeader) + (uint64_t)h->count * sizeof(GpakEntry) + h->names_size;
+    if (tableEnd > map->size) return 0;
+    if (h->count && (h->names_size == 0 || ((const char*)map->data)[tableEnd - 1] != '\0')) return 0;
+
+    const GpakEntry* toc = (const GpakEntry*)((const char*)map->data + sizeof(GpakHeader));
+    for (uint32_t i = 0; i < h->count; i++)
+    {
+        const GpakEntry* e = &toc[i];
+        if (e->name_offset >= h->names_size) return 0;
+        if (e->offset > map->size || e->stored_size >= map->size - e->offset) return 0;  /* room for trailing NUL */
+        if (!(e->flags & GPAK_ENTRY_LZ4) && e->stored_size != e->size) return 0;
+        /* LZ4 expands at most 255x (+16): bounds the decode buffer and keeps size + 1 from wrapping */
+        if ((e->flags & GPAK_ENTRY_LZ4) && (e->size >= SIZE_MAX || e->size > e->stored_size * 255 + 16)) return 0;
+    }
+    return 1;
+}
+
+GuliArchive* GuliArchiveOpen(const char* path)
+{
+    GuliFileMapping map;
+    if (!GuliFileMap(path, &map)) return NULL;
+
+    if (!GpakValidate(&map))
+    {
+        GuliFileUnmap(&map);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Invalid asset archive");
+        return NULL;
+    }
+
+    GuliArchive* archive = (GuliArchive*)GuliCalloc(1, sizeof(GuliArchive));
+    if (!archive)
+    {
+        GuliFileUnmap(&map);
+        return NULL;
+    }
+    archive->map = map;
+    archive->header = (const GpakHeader*)map.data;
+    archive->toc = (const GpakEntry*)((const char*)map.data + sizeof(GpakHeader));
+    archive->names = (const char*)(archive->toc + archive->header->count);
+    if (archive->header->count)
+    {
+        archive->decoded = (unsigned char**)GuliCalloc(archive->header->count, sizeof(unsigned char*));
+        if (!archive->decoded)
+        {
+            GuliFileUnmap(&archive->map);
+            GuliFree(archive);
+            return NULL;
+        }
+    }
+    GuliMutexInit(&archive->lock);
+    return archive;
+}
+
+void GuliArchiveClose(GuliArchive* archive)
+{
+    if (!archive) return;
+    for (uint32_t i = 0; archive->decoded && i < archive->header->count; i++)
+        GuliFree(archive->decoded[i]);
+    GuliFree(archive->decoded);
+    GuliMutexDestroy(&archive->lock);
+    GuliFileUnmap(&archive->map);
+    GuliFree(archive);
+}
+
+static const GpakEntry* GpakLookup(const GuliArchive* archive, const char* name)
+{
+    const uint64_t hash = GpakHashName(name);
+    size_t lo = 0, hi = archive->header->count;
+    while (lo < hi)
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (archive->toc[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    for (; lo < archive->header->count && archive->toc[lo].hash == hash; lo++)
+    {
+        if (strcmp(archive->names + archive->toc[lo].name_offset, name) == 0)
+            return &archive->toc[lo];
+    }
+    return NULL;
+}
+
+int GuliArchiveFind(GuliArchive* archive, const char* name, GuliAssetView* out)
+{
+    if (!archive || !name || !out) return 0;
+
+    const GpakEntry* e = GpakLookup(archive, name);
+    if (!e) return 0;
+
+    const unsigned char* stored = (const unsigned char*)archive->map.data + e->offset;
+    if (!(e->flags & GPAK_ENTRY_LZ4))
+    {
+        out->data = stored;
+        out->size = (size_t)e->size;
+        return 1;
+    }
+
+    const size_t index = (size_t)(e - archive->toc);
+    GuliMutexLock(&archive->lock);
+    unsigned char* buf = archive->decoded[index];
+    if (!buf)
+    {
+        buf = (unsigned char*)GuliMalloc((size_t)e->size + 1);
+        if (buf && Lz4Decompress(stored, (size_t)e->stored_size, buf, (size_t)e->size))
+        {
+            buf[e->size] = '\0';
+            archive->decoded[index] = buf;
+        }
+        else
+        {
+            GuliFree(buf);
+            buf = NULL;
+        }
+    }
+    GuliMutexUnlock(&archive->lock);
+
+    if (!buf)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to decompress archive entry");
+        return 0;
+    }
+    out->data = buf;
+    out->size = (size_t)e->size;
+    return 1;
+}
+
+size_t GuliArchiveGetCount(const GuliArchive* archive)
+{
+    return archive ? archive->header->count : 0;
+}
+
+const char* GuliArchiveGetName(const GuliArchive* archive, size_t index)
+{
+    if (!archive || index >= archive->header->count) return NULL;
+    return archive->names + archive->toc[index].name_offset;
+}
+
+/* -----------------------------------------------------------------------------
+ * Builder
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    char* name;
+    uint64_t hash;
+    unsigned char* data;  /* stored bytes (compressed when lz4) */
+    size_t stored_size;
+    size_t size;
+    int lz4;
+} GpakPending;
+
+struct GuliArchiveBuilder {
+    GpakPending* entries;
+    size_t count;
+    size_t capacity;
+    uint32_t* lz4_table;
+};
+
+GuliArchiveBuilder* GuliArchiveBuilderCreate(void)
+{
+    return (GuliArchiveBuilder*)GuliCalloc(1, sizeof(GuliArchiveBuilder));
+}
+
+void GuliArchiveBuilderDestroy(GuliArchiveBuilder* builder)
+{
+    if (!builder) return;
+    for (size_t i = 0; i < builder->count; i++)
+    {
+        GuliFree(builder->entries[i].name);
+        GuliFree(builder->entries[i].data);
+    }
+    GuliFree(builder->entries);
+    GuliFree(builder->lz4_table);
+    GuliFree(builder);
+}
+
+int GuliArchiveBuilderAdd(GuliArchiveBuilder* builder, const char* name, const void* data, size_t size, unsigned int flags)
+{
+    if (!builder || !name || !name[0] || (!data && size)) return 0;
+
+    const uint64_t hash = GpakHashName(name);
+    for (size_t i = 0; i < builder->count; i++)
+    {
+        if (builder->entries[i].hash == hash && strcmp(builder->entries[i].name, name) == 0)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Duplicate archive entry name");
+            return 0;
+        }
+    }
+
+    if (builder->count == builder->capacity)
+    {
+        const size_t cap = builder->capacity ? builder->capacity * 2 : 16;
+        GpakPending* grown = (GpakPending*)GuliRealloc(builder->entries, cap * sizeof(GpakPending));
+        if (!grown) return 0;
+        builder->entries = grown;
+        builder->capacity = cap;
+    }
+
+    GpakPending p;
+    memset(&p, 0, sizeof(p));
+    p.hash = hash;
+    p.size = size;
+    p.name = GuliStrdup(name);
+    if (!p.name) return 0;
+
+    if ((flags & GULI_ARCHIVE_COMPRESS) && size > 0)
+    {
+        if (!builder->lz4_table)
+            builder->lz4_table = (uint32_t*)GuliMalloc(sizeof(uint32_t) << LZ4_HASH_BITS);
+        unsigned char* packed = builder->lz4_table ? (unsigned char*)GuliMalloc(Lz4Bound(size)) : NULL;
+        if (packed)
+        {
+            const size_t n = Lz4Compress((const unsigned char*)data, size, packed, builder->lz4_table);
+            if (n < size)
+            {
+                p.data = packed;
+                p.stored_size = n;
+                p.lz4 = 1;
+            }
+            else
+            {
+                GuliFree(packed);
+            }
+        }
+    }
+
+    if (!p.lz4)
+    {
+        p.data = (unsigned char*)GuliMalloc(size ? size : 1);
+        if (!p.data)
+        {
+            GuliFree(p.name);
+            return 0;
+        }
+        if (size) memcpy(p.data, data, size);
+        p.stored_size = size;
+    }
+
+    builder->entries[builder->count++] = p;
+    return 1;
+}
+
+int GuliArchiveBuilderAddFile(GuliArchiveBuilder* builder, const char* name, const char* path, unsigned int flags)
+{
+    GuliFileMapping map;
+    if (!GuliFileMap(path, &map))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to read archive input file");
+        return 0;
+    }
+    const int ok = GuliArchiveBuilderAdd(builder, name, map.data, map.size, flags);
+    GuliFileUnmap(&map);
+    return ok;
+}
+
+static int GpakWriteZeros(FILE* out, uint64_t count)
+{
+    static const unsigned char zeros[GPAK_ALIGN];
+    while (count > 0)
+    {
+        const size_t n = (size_t)(count < GPAK_ALIGN ? count : GPAK_ALIGN);
+        if (fwrite(zeros, 1, n, out) != n) return 0;
+        count -= n;
+    }
+    return 1;
+}
+
+static int GpakPendingCompare(const void* a, const void* b)
+{
+    const GpakPending* pa = (const GpakPending*)a;
+    const GpakPending* pb = (const GpakPending*)b;
+    if (pa->hash != pb->hash) return pa->hash < pb->hash ? -1 : 1;
+    return strcmp(pa->name, pb->name);
+}
+
+int GuliArchiveBuilderWrite(GuliArchiveBuilder* builder, const char* path)
+{
+    if (!builder || !path || strlen(path) >= GPAK_PATH_MAX) return 0;
+
+    qsort(builder->entries, builder->count, sizeof(GpakPending), GpakPendingCompare);
+
+    size_t namesSize = 0;
+    for (size_t i = 0; i < builder->count; i++)
+        namesSize += strlen(builder->entries[i].name) + 1;
+    if (namesSize > UINT32_MAX || builder->count > UINT32_MAX) return 0;
+
+    const size_t tableSize = sizeof(GpakHeader) + builder->count * sizeof(GpakEntry) + namesSize;
+    unsigned char* table = (unsigned char*)GuliCalloc(1, tableSize);
+    if (!table) return 0;
+
+    GpakHeader* h = (GpakHeader*)table;
+    GpakEntry* toc = (GpakEntry*)(table + sizeof(GpakHeader));
+    char* names = (char*)(toc + builder->count);
+    h->magic = GPAK_MAGIC;
+    h->version = GPAK_VERSION;
+    h->count = (uint32_t)builder->count;
+    h->names_size = (uint32_t)namesSize;
+
+    uint64_t offset = GpakAlignUp(tableSize, GPAK_ALIGN);
+    uint32_t nameOffset = 0;
+    for (size_t i = 0; i < builder->count; i++)
+    {
+        const GpakPending* p = &builder->entries[i];
+        const size_t len = strlen(p->name) + 1;
+        memcpy(names + nameOffset, p->name, len);
+        toc[i].hash = p->hash;
+        toc[i].offset = offset;
+        toc[i].stored_size = p->stored_size;
+        toc[i].size = p->size;
+        toc[i].name_offset = nameOffset;
+        toc[i].flags = p->lz4 ? GPAK_ENTRY_LZ4 : 0;
+        nameOffset += (uint32_t)len;
+        offset = GpakAlignUp(offset + p->stored_size + 1, GPAK_ALIGN);  /* +1 keeps a NUL after the data */
+    }
+    h->file_size = offset;
+
+    char tmpPath[GPAK_PATH_MAX + 64];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%ld.tmp", path, (long)getpid());
+    FILE* out = fopen(tmpPath, "wb");
+    if (!out)
+    {
+        GuliFree(table);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create asset archive");
+        return 0;
+    }
+
+    int ok = fwrite(table, 1, tableSize, out) == tableSize;
+    uint64_t written = tableSize;
+    for (size_t i = 0; ok && i < builder->count; i++)
+    {
+        const GpakPending* p = &builder->entries[i];
+        ok = GpakWriteZeros(out, toc[i].offset - written);
+        if (ok && p->stored_size) ok = fwrite(p->data, 1, p->stored_size, out) == p->stored_size;
+        written = toc[i].offset + p->stored_size;
+    }
+    if (ok) ok = GpakWriteZeros(out, h->file_size - written);
+
+    const int closed = fclose(out) == 0;
+    GuliFree(table);
+    if (!ok || !closed || rename(tmpPath, path) != 0)
+    {
+        remove(tmpPath);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to write asset archive");
+        return 0;
+    }
+    return 1;
+}
@@ -1,4 +1,5 @@
 #include "Core/guli_core.h"
+#include "Core/guli_job.h"
 #ifdef GULI_BACKEND_METAL
 #include "Graphics/Metal/guli_metal.h"
 #endif
@@ -6,65 +7,198 @@
 #include "Graphics/OpenGL/guli_gl.h"
 #endif
 
-GuliState G_State;
+#include <stdlib.h>
 
-short GuliInit(uint32_t width, uint32_t height, const char* title)
-{
-    if (!GuliBackendInit())
-    {
-        GuliSetError(&G_State.error, GULI_ERROR_FAILED, "Failed to initialize Guli");
-        GULI_PRINT_ERROR(G_State.error.result, G_State.error.message);
-        return G_State.error.result;
-    }
+GuliState G_DefaultState;
+_Thread_local GuliState* G_CurrentState;
 
+/* Create the window and backend for the calling thread's current state. */
+static short GuliStateInit(uint32_t width, uint32_t height, const char* title, unsigned int flags)
+{
 #ifdef GULI_BACKEND_METAL
     GuliWindowHint(GULI_CLIENT_API, GULI_NO_API);
 #else
     GuliWindowHint(GULI_CLIENT_API, GULI_OPENGL_API);
-    GuliWindowHint(GULI_CONTEXT_VERSION_MAJOR, 3);
+    GuliWindowHint(GULI_CONTEXT_VERSION_MAJOR, (flags & GULI_CONTEXT_COMPUTE) ? 4 : 3);
     GuliWindowHint(GULI_CONTEXT_VERSION_MINOR, 3);
     GuliWindowHint(GULI_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 #endif
+    GuliWindowHint(GULI_VISIBLE, (flags & GULI_CONTEXT_HIDDEN) ? GULI_FALSE : GULI_TRUE);
 
     G_State.window = GuliWindowCreate(width, height, title);
+#ifdef GULI_BACKEND_OPENGL
+    if (!G_State.window && (flags & GULI_CONTEXT_COMPUTE))
+    {
+        /* Drivers without 4.3 still get a window; GuliComputeIsSupported reports 0 */
+        GuliLog(GULI_LOG_WARNING, 0, "OpenGL 4.3 context unavailable; falling back to 3.3 without compute");
+        GuliWindowHint(GULI_CONTEXT_VERSION_MAJOR, 3);
+        G_State.window = GuliWindowCreate(width, height, title);
+    }
+#endif
+    GuliWindowHint(GULI_VISIBLE, GULI_TRUE);
     if (!G_State.window)
     {
         GuliSetError(&G_State.error, GULI_ERROR_FAILED, "Failed to create window");
         GULI_PRINT_ERROR(G_State.error.result, G_State.error.message);
-        GuliTerminate();
         return G_State.error.result;
     }
 
 #ifdef GULI_BACKEND_METAL
     if (MetalInit(&G_State) != GULI_ERROR_SUCCESS)
         return G_State.error.result;
-    fprintf(stdout, "Guli: using Metal backend\n");
 #endif
 #ifdef GULI_BACKEND_OPENGL
     if (GlInit(&G_State) != GULI_ERROR_SUCCESS)
         return G_State.error.result;
-    fprintf(stdout, "Guli: using OpenGL backend\n");
 #endif
+    GuliFramePacingInit();
 
     GuliSetError(&G_State.error, GULI_ERROR_SUCCESS, NULL);
     return GULI_ERROR_SUCCESS;
 }
 
-void GuliShutdown(void)
+/* Shut down the backend and destroy the window of the calling thread's current state. */
+static void GuliStateShutdown(void)
 {
-    if (G_State.window)
-    {
+    if (!G_State.window) return;
+
+    GuliInputDisable();
+    GuliFramePacingRelease();
 #ifdef GULI_BACKEND_METAL
-        MetalShutdown(&G_State);
+    MetalShutdown(&G_State);
 #endif
 #ifdef GULI_BACKEND_OPENGL
-        GlShutdown(&G_State);
+    GlShutdown(&G_State);
 #endif
-        GuliWindowDestroy();
-        G_State.window = NULL;
+    GuliWindowDestroy();
+    G_State.window = NULL;
+}
+
+/* Make state's graphics context current here, unless a render thread owns it. */
+static void GuliBindGraphicsContext(GuliState* state)
+{
+#ifdef GULI_BACKEND_OPENGL
+    if (state->gl_s && state->gl_s->render_thread) return;
+    if (GuliBackendGetCurrentContext() != state->window)
+        GuliBackendMakeContextCurrent(state->window);
+#else
+    (void)state;
+#endif
+}
+
+short GuliInit(uint32_t width, uint32_t height, const char* title)
+{
+    return GuliInitEx(width, height, title, 0);
+}
+
+short GuliInitEx(uint32_t width, uint32_t height, const char* title, unsigned int flags)
+{
+    G_CurrentState = NULL;
+
+    if (!GuliBackendInit())
+    {
+        GuliSetError(&G_State.error, GULI_ERROR_FAILED, "Failed to initialize Guli");
+        GULI_PRINT_ERROR(G_State.error.result, G_State.error.message);
+        return G_State.error.result;
     }
 
+    if (GuliStateInit(width, height, title, flags) != GULI_ERROR_SUCCESS)
+    {
+        if (!G_State.window)
+            GuliTerminate();
+        return G_State.error.result;
+    }
+#ifdef GULI_BACKEND_METAL
+    GuliLog(GULI_LOG_INFO, 0, "Guli: using Metal backend");
+#endif
+#ifdef GULI_BACKEND_OPENGL
+    GuliLog(GULI_LOG_INFO, 0, "Guli: using OpenGL backend");
+#endif
+
+    GuliJobSetRenderThread();
+
+    GuliSetError(&G_State.error, GULI_ERROR_SUCCESS, NULL);
+    return GULI_ERROR_SUCCESS;
+}
+
+void GuliShutdown(void)
+{
+    GuliJobSystemShutdown();
+
+    G_CurrentState = NULL;
+    GuliBindGraphicsContext(&G_DefaultState);
+    GuliStateShutdown();
+
     GuliTerminate();
+    GuliFrameArenaRelease();
+    GuliLogShutdown();
 
     GuliSetError(&G_State.error, GULI_ERROR_SUCCESS, "Guli shutdown successfully");
 }
+
+GuliContext* GuliContextCreate(uint32_t width, uint32_t height, const char* title, unsigned int flags)
+{
+    if (!GuliBackendInit())
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to initialize Guli");
+        return NULL;
+    }
+
+    GuliContext* ctx = GuliCalloc(1, sizeof(GuliContext));
+    if (!ctx)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate context");
+        return NULL;
+    }
+
+    GuliState* previous = G_CurrentState;
+    G_CurrentState = ctx;
+    ctx->arena = GuliFrameArenaCreate();
+    if (!ctx->arena || GuliStateInit(width, height, title, flags) != GULI_ERROR_SUCCESS)
+    {
+        GuliStateShutdown();
+        GuliFrameArenaRelease();
+        G_CurrentState = previous;
+        GuliBindGraphicsContext(GuliCurrentState());
+        GuliFree(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+void GuliContextDestroy(GuliContext* ctx)
+{
+    if (!ctx || ctx == &G_DefaultState) return;
+
+    GuliState* previous = (G_CurrentState == ctx) ? NULL : G_CurrentState;
+    G_CurrentState = ctx;
+    GuliBindGraphicsContext(ctx);
+    GuliStateShutdown();
+    GuliFrameArenaRelease();
+
+    G_CurrentState = previous;
+    if (GuliCurrentState()->window)
+        GuliBindGraphicsContext(GuliCurrentState());
+    GuliFree(ctx);
+}
+
+void GuliContextMakeCurrent(GuliContext* ctx)
+{
+    G_CurrentState = (ctx == &G_DefaultState) ? NULL : ctx;
+    if (G_State.window)
+        GuliBindGraphicsContext(&G_State);
+}
+
+void GuliContextRelease(void)
+{
+#ifdef GULI_BACKEND_OPENGL
+    if (GuliBackendGetCurrentContext())
+        GuliBackendMakeContextCurrent(NULL);
+#endif
+    G_CurrentState = NULL;
+}
+
+GuliContext* GuliContextGetCurrent(void)
+{
+    return G_CurrentState;
+}
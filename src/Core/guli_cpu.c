@@ -0,0 +1,67 @@
+#include "Core/guli_cpu.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+
+static unsigned long long GuliXgetbv(void)
+{
+    unsigned int eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+}
+
+static void GuliDetectCpu(GuliCpuFeatures* f)
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return;
+
+    f->ssse3 = (ecx >> 9) & 1;
+    f->sse41 = (ecx >> 19) & 1;
+    const int osxsave = (ecx >> 27) & 1;
+    const int avx = (ecx >> 28) & 1;
+    const int f16c = (ecx >> 29) & 1;
+    const int fma = (ecx >> 12) & 1;
+
+    unsigned long long xcr0 = osxsave ? GuliXgetbv() : 0;
+    const int ymm = (xcr0 & 0x6) == 0x6;      /* XMM + YMM state */
+    const int zmm = (xcr0 & 0xe6) == 0xe6;    /* + opmask + ZMM state */
+
+    unsigned int ebx7 = 0;
+    if (__get_cpuid_max(0, NULL) >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx7, ecx, edx);
+    }
+
+    f->avx2 = avx && ymm && ((ebx7 >> 5) & 1);
+    f->f16c = avx && ymm && f16c;
+    f->fma = avx && ymm && fma;
+    f->avx512f = zmm && ((ebx7 >> 16) & 1);
+}
+#else
+static void GuliDetectCpu(GuliCpuFeatures* f)
+{
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    f->neon = 1;
+#endif
+    (void)f;
+}
+#endif
+
+static GuliCpuFeatures g_cpu_features;
+static atomic_int g_cpu_detected;
+
+const GuliCpuFeatures* GuliGetCpuFeatures(void)
+{
+    if (!atomic_load_explicit(&g_cpu_detected, memory_order_acquire))
+    {
+        /* Detection is idempotent; racing threads write the same values. */
+        GuliCpuFeatures f = {0};
+        GuliDetectCpu(&f);
+        g_cpu_features = f;
+        atomic_store_explicit(&g_cpu_detected, 1, memory_order_release);
+    }
+    return &g_cpu_features;
+}
@@ -1,39 +1,78 @@
 #include "Core/guli_file.h"
-#include <stdio.h>
+#include "Core/guli_memory.h"
+#include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 char* GuliLoadFileText(const char* path)
 {
     if (!path) return NULL;
 
-    FILE* f = fopen(path, "rb");
-    if (!f) return NULL;
+    /* open + fstat + one read: no stdio buffering and no seek round trips. */
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
 
-    if (fseek(f, 0, SEEK_END) != 0)
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
     {
-        fclose(f);
+        close(fd);
         return NULL;
     }
 
-    long size = ftell(f);
-    if (size <= 0)
+    const size_t size = (size_t)st.st_size;
+    char* buf = (char*)GuliMalloc(size + 1);
+    if (!buf)
     {
-        fclose(f);
+        close(fd);
         return NULL;
     }
 
-    rewind(f);
-
-    char* buf = (char*)malloc((size_t)size + 1);
-    if (!buf)
+    size_t n = 0;
+    while (n < size)
     {
-        fclose(f);
-        return NULL;
+        ssize_t r = read(fd, buf + n, size - n);
+        if (r <= 0) break;
+        n += (size_t)r;
     }
-
-    size_t n = fread(buf, 1, (size_t)size, f);
     buf[n] = '\0';
-    fclose(f);
+    close(fd);
 
     return buf;
 }
+
+int GuliFileMap(const char* path, GuliFileMapping* out)
+{
+    if (!out) return 0;
+    out->data = NULL;
+    out->size = 0;
+    if (!path) return 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* the mapping keeps the file referenced */
+    if (data == MAP_FAILED) return 0;
+
+    out->data = data;
+    out->size = (size_t)st.st_size;
+    return 1;
+}
+
+void GuliFileUnmap(GuliFileMapping* map)
+{
+    if (!map) return;
+    if (map->data)
+        munmap((void*)map->data, map->size);
+    map->data = NULL;
+    map->size = 0;
+}
@@ -1,34 +1,100 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "Core/guli_image.h"
+#include "Core/guli_error.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_pixel.h"
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* stb_image from assimp - add include path in CMake */
+/* stb_image from assimp - add include path in CMake. Decodes allocate through the library allocator. */
+#define STBI_MALLOC(size) GuliMalloc(size)
+#define STBI_REALLOC(ptr, size) GuliRealloc(ptr, size)
+#define STBI_FREE(ptr) GuliFree(ptr)
 #include <stb_image.h>
 
-GuliImage GuliImageLoadFromFile(const char* path)
+static const GuliPixelFormat k_channel_formats[5] = {
+    GULI_PIXEL_RGBA8, GULI_PIXEL_GRAY8, GULI_PIXEL_GRAYA8, GULI_PIXEL_RGB8, GULI_PIXEL_RGBA8,
+};
+
+/* Takes ownership of decoded pixels (native channel count) and produces RGBA8 in one pass. */
+static GuliImage GuliImageFinish(unsigned char* pixels, int w, int h, int ch, unsigned int flags)
 {
     GuliImage img = {0};
-    if (!path) return img;
+    if (!pixels || w <= 0 || h <= 0 || ch < 1 || ch > 4)
+    {
+        if (pixels) stbi_image_free(pixels);
+        return img;
+    }
 
-    int w = 0, h = 0, ch = 0;
-    unsigned char* data = stbi_load(path, &w, &h, &ch, 4);
-    if (!data || w <= 0 || h <= 0) return img;
+    unsigned char* rgba = pixels;
+    if (ch != 4)
+    {
+        rgba = (unsigned char*)GuliMalloc((size_t)w * (size_t)h * 4);
+        if (!rgba)
+        {
+            stbi_image_free(pixels);
+            return img;
+        }
+    }
 
-    img.data = data;
+    const int converted = (ch == 4 && !flags) ||
+        GuliPixelConvert(pixels, k_channel_formats[ch], 0, rgba, GULI_PIXEL_RGBA8, 0, w, h, flags);
+    if (rgba != pixels) stbi_image_free(pixels);
+    if (!converted)
+    {
+        GuliFree(rgba);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to convert decoded image to RGBA8");
+        return img;
+    }
+
+    img.data = rgba;
     img.width = w;
     img.height = h;
     img.channels = 4;
+    GuliMemoryTrack(GULI_MEMORY_DECODE, (uint64_t)w * (uint64_t)h * 4);
     return img;
 }
 
+GuliImage GuliImageLoadFromFileEx(const char* path, unsigned int flags)
+{
+    GuliImage img = {0};
+    if (!path) return img;
+
+    int w = 0, h = 0, ch = 0;
+    unsigned char* data = stbi_load(path, &w, &h, &ch, 0);
+    return GuliImageFinish(data, w, h, ch, flags);
+}
+
+GuliImage GuliImageLoadFromMemoryEx(const void* data, size_t size, unsigned int flags)
+{
+    GuliImage img = {0};
+    if (!data || size == 0 || size > INT_MAX) return img;
+
+    int w = 0, h = 0, ch = 0;
+    unsigned char* pixels = stbi_load_from_memory((const stbi_uc*)data, (int)size, &w, &h, &ch, 0);
+    return GuliImageFinish(pixels, w, h, ch, flags);
+}
+
+GuliImage GuliImageLoadFromFile(const char* path)
+{
+    return GuliImageLoadFromFileEx(path, 0);
+}
+
+GuliImage GuliImageLoadFromMemory(const void* data, size_t size)
+{
+    return GuliImageLoadFromMemoryEx(data, size, 0);
+}
+
 void GuliImageFree(GuliImage* img)
 {
     if (!img) return;
     if (img->data)
     {
+        /* stb_image allocates through GuliMalloc, so converted buffers free the same way. */
         stbi_image_free(img->data);
         img->data = NULL;
+        GuliMemoryUntrack(GULI_MEMORY_DECODE, (uint64_t)img->width * (uint64_t)img->height * 4);
     }
     img->width = img->height = img->channels = 0;
 }
@@ -0,0 +1,251 @@
+#include "Core/guli_image.h"
+#include "Core/guli_job.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_thread.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stb_image.h>
+
+/* -----------------------------------------------------------------------------
+ * Parallel batch image decoding
+ *
+ * Each source becomes a job on the shared job system. A job reads the file,
+ * reserves its decoded size against the memory budget, decodes, and pushes the
+ * index onto a completion queue. Over budget, it hands the index back instead of
+ * blocking a worker. The calling thread submits jobs, drains completions
+ * (callbacks run there) and returns budget as images leave.
+ * ----------------------------------------------------------------------------- */
+
+/* Per-worker scratch for encoded file bytes, reused across decodes. */
+typedef struct {
+    unsigned char* data;
+    size_t capacity;
+} ImageScratch;
+
+typedef struct ImageBatch ImageBatch;
+
+typedef struct {
+    ImageBatch* batch;
+    size_t index;
+} ImageBatchTask;
+
+struct ImageBatch {
+    const GuliImageSource* sources;
+    size_t count;
+    GuliImage* results;
+    size_t* reserved;     /* bytes reserved per index (released when handed over) */
+    ImageBatchTask* tasks;
+    ImageScratch* scratch; /* one per job worker */
+    int scratch_count;
+
+    GuliMutex lock;
+    GuliCond cond_done;
+
+    size_t* done;         /* completion queue (indices), count entries */
+    size_t done_head;
+    size_t done_tail;
+    size_t* bounced;      /* indices handed back over budget (stack), count entries */
+    size_t bounced_count;
+    size_t bounced_new;   /* bounces not yet seen by the caller */
+    size_t budget_cap;
+    size_t budget_used;
+};
+
+static const unsigned char* ImageBatchReadFile(const char* path, ImageScratch* scratch, size_t* size)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    long len = -1;
+    if (fseek(f, 0, SEEK_END) == 0) len = ftell(f);
+    if (len <= 0 || len > INT_MAX || fseek(f, 0, SEEK_SET) != 0)
+    {
+        fclose(f);
+        return NULL;
+    }
+
+    if ((size_t)len > scratch->capacity)
+    {
+        unsigned char* grown = (unsigned char*)GuliRealloc(scratch->data, (size_t)len);
+        if (!grown)
+        {
+            fclose(f);
+            return NULL;
+        }
+        scratch->data = grown;
+        scratch->capacity = (size_t)len;
+    }
+
+    *size = fread(scratch->data, 1, (size_t)len, f);
+    fclose(f);
+    return (*size == (size_t)len) ? scratch->data : NULL;
+}
+
+static void ImageBatchDecodeOne(ImageBatch* b, size_t i, ImageScratch* scratch)
+{
+    const GuliImageSource* src = &b->sources[i];
+    const unsigned char* bytes = (const unsigned char*)src->data;
+    size_t size = src->size;
+    if (!bytes && src->path)
+        bytes = ImageBatchReadFile(src->path, scratch, &size);
+
+    /* Reserve the decoded size before decoding so the budget bounds peak memory. */
+    size_t need = 0;
+    int w = 0, h = 0, ch = 0;
+    if (bytes && size > 0 && size <= INT_MAX && stbi_info_from_memory(bytes, (int)size, &w, &h, &ch))
+        need = (size_t)w * (size_t)h * 4;
+
+    GuliMutexLock(&b->lock);
+    if (b->budget_cap && b->budget_used > 0 && b->budget_used + need > b->budget_cap)
+    {
+        b->bounced[b->bounced_count++] = i;
+        b->bounced_new++;
+        GuliCondSignal(&b->cond_done);
+        GuliMutexUnlock(&b->lock);
+        return;
+    }
+    b->budget_used += need;
+    b->reserved[i] = need;
+    GuliMutexUnlock(&b->lock);
+
+    GuliImage img = {0};
+    if (need)
+        img = GuliImageLoadFromMemory(bytes, size);
+
+    GuliMutexLock(&b->lock);
+    b->results[i] = img;
+    b->done[b->done_tail++] = i;
+    GuliCondSignal(&b->cond_done);
+    GuliMutexUnlock(&b->lock);
+}
+
+static void ImageBatchJob(void* arg)
+{
+    const ImageBatchTask* task = (const ImageBatchTask*)arg;
+    ImageBatch* b = task->batch;
+    const int worker = GuliJobGetWorkerIndex();
+
+    if (worker >= 0 && worker < b->scratch_count)
+    {
+        ImageBatchDecodeOne(b, task->index, &b->scratch[worker]);
+    }
+    else
+    {
+        /* Not a pool worker (a thread helping in GuliJobWait): use private scratch. */
+        ImageScratch scratch = {0};
+        ImageBatchDecodeOne(b, task->index, &scratch);
+        GuliFree(scratch.data);
+    }
+}
+
+size_t GuliImageLoadBatch(const GuliImageSource* sources, size_t count, GuliImage* out, const GuliImageBatchDesc* desc)
+{
+    if (!sources || count == 0) return 0;
+
+    const GuliImageBatchDesc defaults = {0};
+    if (!desc) desc = &defaults;
+    if (!desc->on_complete && !out) return 0;
+
+    ImageBatch b;
+    memset(&b, 0, sizeof(b));
+    b.sources = sources;
+    b.count = count;
+    b.budget_cap = desc->max_inflight_bytes;
+    b.scratch_count = GuliJobGetWorkerCount();
+    b.results = desc->on_complete ? (GuliImage*)GuliCalloc(count, sizeof(GuliImage)) : out;
+    b.reserved = (size_t*)GuliCalloc(count, sizeof(size_t));
+    b.done = (size_t*)GuliCalloc(count, sizeof(size_t));
+    b.bounced = (size_t*)GuliCalloc(count, sizeof(size_t));
+    b.tasks = (ImageBatchTask*)GuliCalloc(count, sizeof(ImageBatchTask));
+    b.scratch = (ImageScratch*)GuliCalloc((size_t)b.scratch_count + 1, sizeof(ImageScratch));
+    if (!b.results || !b.reserved || !b.done || !b.bounced || !b.tasks || !b.scratch)
+    {
+        if (desc->on_complete) GuliFree(b.results);
+        GuliFree(b.reserved);
+        GuliFree(b.done);
+        GuliFree(b.bounced);
+        GuliFree(b.tasks);
+        GuliFree(b.scratch);
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate image batch");
+        return 0;
+    }
+    if (!desc->on_complete)
+        memset(out, 0, count * sizeof(GuliImage));
+
+    GuliMutexInit(&b.lock);
+    GuliCondInit(&b.cond_done);
+
+    /* threads caps how many decodes run at once; the pool itself is shared. */
+    const size_t limit = desc->threads > 0 ? (size_t)desc->threads : count;
+    GuliJobCounter counter = {0};
+    size_t next = 0, running = 0, handed = 0;
+    int retry = 0;
+
+    GuliMutexLock(&b.lock);
+    while (handed < count)
+    {
+        while (running < limit)
+        {
+            size_t i;
+            if (b.bounced_count && (retry || b.budget_used == 0)) i = b.bounced[--b.bounced_count];
+            else if (next < count) i = next++;
+            else break;
+
+            running++;
+            b.tasks[i].batch = &b;
+            b.tasks[i].index = i;
+            const GuliJobDecl job = { ImageBatchJob, &b.tasks[i] };
+            GuliMutexUnlock(&b.lock);
+            if (b.scratch_count > 0) GuliJobRun(&job, 1, &counter);
+            else ImageBatchJob(job.arg);  /* no workers could start: decode here */
+            GuliMutexLock(&b.lock);
+        }
+        retry = 0;
+
+        while (b.done_head == b.done_tail && b.bounced_new == 0)
+            GuliCondWait(&b.cond_done, &b.lock);
+
+        running -= b.bounced_new;
+        b.bounced_new = 0;
+
+        while (b.done_head < b.done_tail)
+        {
+            const size_t i = b.done[b.done_head++];
+            running--;
+            handed++;
+            if (desc->on_complete)
+            {
+                GuliImage img = b.results[i];
+                GuliMutexUnlock(&b.lock);
+                desc->on_complete(desc->user, i, img);
+                GuliMutexLock(&b.lock);
+            }
+            b.budget_used -= b.reserved[i];
+            retry = 1;
+        }
+    }
+    GuliMutexUnlock(&b.lock);
+
+    /* Jobs signal before they return; make sure none still touches b. */
+    GuliJobWait(&counter);
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; i++)
+        if (b.results[i].data) decoded++;
+
+    for (int t = 0; t <= b.scratch_count; t++)
+        GuliFree(b.scratch[t].data);
+    GuliCondDestroy(&b.cond_done);
+    GuliMutexDestroy(&b.lock);
+    if (desc->on_complete) GuliFree(b.results);
+    GuliFree(b.reserved);
+    GuliFree(b.done);
+    GuliFree(b.bounced);
+    GuliFree(b.tasks);
+    GuliFree(b.scratch);
+    return decoded;
+}
@@ -0,0 +1,213 @@
+#include "Core/guli_input.h"
+#include "Core/guli_core.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* -----------------------------------------------------------------------------
+ * SPSC event ring fed by GLFW callbacks
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_INPUT_DEFAULT_CAPACITY 1024
+#define GULI_INPUT_CACHE_LINE 64
+
+struct GuliInputQueue {
+    _Alignas(GULI_INPUT_CACHE_LINE) atomic_size_t head;  /* next event to read (consumer) */
+    _Alignas(GULI_INPUT_CACHE_LINE) atomic_size_t tail;  /* next slot to write (producer) */
+    _Alignas(GULI_INPUT_CACHE_LINE) atomic_uint_fast64_t dropped;
+    size_t mask;
+    GuliWindow* window;
+    GLFWkeyfun prev_key;
+    GLFWmousebuttonfun prev_button;
+    GLFWcursorposfun prev_move;
+    GLFWscrollfun prev_scroll;
+    GLFWframebuffersizefun prev_resize;
+    GLFWwindowfocusfun prev_focus;
+    GuliEvent* events;
+};
+
+uint64_t GuliInputGetTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void GuliInputPush(GuliInputQueue* q, GuliEvent* e)
+{
+    e->time_ns = GuliInputGetTimeNs();
+    const size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    const size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail - head > q->mask)
+    {
+        atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    q->events[tail & q->mask] = *e;
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+static GuliInputQueue* GuliInputFromWindow(GLFWwindow* window)
+{
+    GuliState* state = glfwGetWindowUserPointer(window);
+    return state ? state->input : NULL;
+}
+
+static void GuliInputKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_KEY };
+    e.key.key = key;
+    e.key.scancode = scancode;
+    e.key.action = action;
+    e.key.mods = mods;
+    GuliInputPush(q, &e);
+    if (q->prev_key) q->prev_key(window, key, scancode, action, mods);
+}
+
+static void GuliInputButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_MOUSE_BUTTON };
+    e.button.button = button;
+    e.button.action = action;
+    e.button.mods = mods;
+    GuliInputPush(q, &e);
+    if (q->prev_button) q->prev_button(window, button, action, mods);
+}
+
+static void GuliInputMoveCallback(GLFWwindow* window, double x, double y)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_MOUSE_MOVE };
+    e.move.x = x;
+    e.move.y = y;
+    GuliInputPush(q, &e);
+    if (q->prev_move) q->prev_move(window, x, y);
+}
+
+static void GuliInputScrollCallback(GLFWwindow* window, double dx, double dy)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_SCROLL };
+    e.scroll.dx = dx;
+    e.scroll.dy = dy;
+    GuliInputPush(q, &e);
+    if (q->prev_scroll) q->prev_scroll(window, dx, dy);
+}
+
+static void GuliInputResizeCallback(GLFWwindow* window, int width, int height)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_RESIZE };
+    e.resize.width = width;
+    e.resize.height = height;
+    GuliInputPush(q, &e);
+    if (q->prev_resize) q->prev_resize(window, width, height);
+}
+
+static void GuliInputFocusCallback(GLFWwindow* window, int focused)
+{
+    GuliInputQueue* q = GuliInputFromWindow(window);
+    if (!q) return;
+    GuliEvent e = { .type = GULI_EVENT_FOCUS };
+    e.focus.focused = focused;
+    GuliInputPush(q, &e);
+    if (q->prev_focus) q->prev_focus(window, focused);
+}
+
+GuliInputQueue* GuliInputEnable(size_t capacity)
+{
+    GuliState* state = &G_State;
+    if (!state->window)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliInputEnable requires a window");
+        return NULL;
+    }
+    if (state->input) return state->input;
+
+    size_t n = 1;
+    while (n < (capacity ? capacity : GULI_INPUT_DEFAULT_CAPACITY))
+        n <<= 1;
+
+    GuliInputQueue* q = GuliMallocAligned(sizeof(GuliInputQueue), GULI_INPUT_CACHE_LINE);
+    GuliEvent* events = GuliMalloc(n * sizeof(GuliEvent));
+    if (!q || !events)
+    {
+        GuliFreeAligned(q);
+        GuliFree(events);
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate input queue");
+        return NULL;
+    }
+    memset(q, 0, sizeof(*q));
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->dropped, 0);
+    q->mask = n - 1;
+    q->events = events;
+    q->window = state->window;
+
+    state->input = q;
+    glfwSetWindowUserPointer(state->window, state);
+    q->prev_key = glfwSetKeyCallback(state->window, GuliInputKeyCallback);
+    q->prev_button = glfwSetMouseButtonCallback(state->window, GuliInputButtonCallback);
+    q->prev_move = glfwSetCursorPosCallback(state->window, GuliInputMoveCallback);
+    q->prev_scroll = glfwSetScrollCallback(state->window, GuliInputScrollCallback);
+    q->prev_resize = glfwSetFramebufferSizeCallback(state->window, GuliInputResizeCallback);
+    q->prev_focus = glfwSetWindowFocusCallback(state->window, GuliInputFocusCallback);
+    return q;
+}
+
+void GuliInputDisable(void)
+{
+    GuliState* state = &G_State;
+    GuliInputQueue* q = state->input;
+    if (!q) return;
+
+    /* Put back the callbacks we chained. */
+    glfwSetKeyCallback(q->window, q->prev_key);
+    glfwSetMouseButtonCallback(q->window, q->prev_button);
+    glfwSetCursorPosCallback(q->window, q->prev_move);
+    glfwSetScrollCallback(q->window, q->prev_scroll);
+    glfwSetFramebufferSizeCallback(q->window, q->prev_resize);
+    glfwSetWindowFocusCallback(q->window, q->prev_focus);
+    state->input = NULL;
+
+    GuliFree(q->events);
+    GuliFreeAligned(q);
+}
+
+GuliInputQueue* GuliInputGetQueue(void)
+{
+    return G_State.input;
+}
+
+size_t GuliInputPoll(GuliInputQueue* queue, GuliEvent* events, size_t max)
+{
+    if (!queue || !events || max == 0) return 0;
+
+    const size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    size_t n = tail - head;
+    if (n > max) n = max;
+
+    const size_t start = head & queue->mask;
+    const size_t first = (n < queue->mask + 1 - start) ? n : queue->mask + 1 - start;
+    memcpy(events, queue->events + start, first * sizeof(GuliEvent));
+    memcpy(events + first, queue->events, (n - first) * sizeof(GuliEvent));
+
+    atomic_store_explicit(&queue->head, head + n, memory_order_release);
+    return n;
+}
+
+uint64_t GuliInputGetDropped(const GuliInputQueue* queue)
+{
+    return queue ? atomic_load_explicit(&((GuliInputQueue*)queue)->dropped, memory_order_relaxed) : 0;
+}
@@ -0,0 +1,714 @@
+#include "Core/guli_io.h"
+#include "Core/guli_error.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_thread.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define GULI_IO_URING 1
+#endif
+
+#define GULI_IO_MAX_THREADS 32
+#define GULI_IO_READ_CHUNK (1u << 30)
+
+struct GuliIoRequest {
+    GuliIo* io;
+    GuliIoRequest* next;  /* pending queue or completion list */
+    GuliIoRequest* prev;  /* pending queue only */
+    char* path;
+    GuliIoPriority priority;
+    GuliIoCallback callback;
+    void* user;
+    atomic_int status;    /* GuliIoStatus */
+    atomic_int cancel;
+    atomic_int refs;      /* caller + service */
+    int queued;           /* in a pending queue (io->lock) */
+    int fd;
+    unsigned char* data;
+    size_t size;
+    size_t done;
+};
+
+#if GULI_IO_URING
+typedef struct {
+    int fd;
+    unsigned entries;
+    unsigned inflight;    /* SQEs submitted without a reaped CQE */
+    unsigned to_submit;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_ptr;
+    size_t sq_len;
+    void* cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+} IoRing;
+#endif
+
+struct GuliIo {
+    GuliMutex lock;
+    GuliCond cond_work;
+    GuliCond cond_done;
+    GuliIoRequest* pending_head[GULI_IO_PRIORITY_COUNT];
+    GuliIoRequest* pending_tail[GULI_IO_PRIORITY_COUNT];
+    GuliIoRequest* done_head;
+    GuliIoRequest* done_tail;
+    int shutdown;
+    int thread_count;
+    GuliThread threads[GULI_IO_MAX_THREADS];
+    int use_ring;
+#if GULI_IO_URING
+    IoRing ring;
+    int wake_fd;
+#endif
+};
+
+/* -----------------------------------------------------------------------------
+ * Request bookkeeping
+ * ----------------------------------------------------------------------------- */
+
+static void IoRequestUnref(GuliIoRequest* req)
+{
+    if (atomic_fetch_sub_explicit(&req->refs, 1, memory_order_acq_rel) != 1) return;
+    GuliFree(req->data);
+    GuliFree(req->path);
+    GuliFree(req);
+}
+
+/* Caller holds io->lock. */
+static GuliIoRequest* IoPopPending(GuliIo* io)
+{
+    for (int p = 0; p < GULI_IO_PRIORITY_COUNT; p++)
+    {
+        GuliIoRequest* req = io->pending_head[p];
+        if (!req) continue;
+        io->pending_head[p] = req->next;
+        if (req->next) req->next->prev = NULL;
+        else io->pending_tail[p] = NULL;
+        req->next = req->prev = NULL;
+        req->queued = 0;
+        return req;
+    }
+    return NULL;
+}
+
+/* Caller holds io->lock. */
+static void IoPushDone(GuliIo* io, GuliIoRequest* req, GuliIoStatus status)
+{
+    if (status != GULI_IO_DONE)
+    {
+        GuliFree(req->data);
+        req->data = NULL;
+        req->size = 0;
+    }
+    req->next = NULL;
+    if (io->done_tail) io->done_tail->next = req;
+    else io->done_head = req;
+    io->done_tail = req;
+    atomic_store_explicit(&req->status, (int)status, memory_order_release);
+    GuliCondBroadcast(&io->cond_done);
+}
+
+static void IoFinish(GuliIo* io, GuliIoRequest* req, int ok)
+{
+    if (req->fd >= 0)
+    {
+        close(req->fd);
+        req->fd = -1;
+    }
+    GuliIoStatus status = ok ? GULI_IO_DONE : GULI_IO_FAILED;
+    if (status == GULI_IO_DONE)
+    {
+        req->size = req->done;
+        req->data[req->size] = '\0';
+    }
+
+    GuliMutexLock(&io->lock);
+    /* Checked under the lock GuliIoCancel sets it under: a cancel that returned 1 always discards the data */
+    if (atomic_load_explicit(&req->cancel, memory_order_acquire)) status = GULI_IO_CANCELED;
+    IoPushDone(io, req, status);
+    GuliMutexUnlock(&io->lock);
+}
+
+/* Size the buffer after open. Returns 0 on failure. */
+static int IoPrepareBuffer(GuliIoRequest* req)
+{
+    struct stat st;
+    if (fstat(req->fd, &st) != 0 || st.st_size < 0) return 0;
+    req->size = (size_t)st.st_size;
+    req->done = 0;
+    req->data = (unsigned char*)GuliMalloc(req->size + 1);
+    return req->data != NULL;
+}
+
+/* -----------------------------------------------------------------------------
+ * Thread-pool backend
+ * ----------------------------------------------------------------------------- */
+
+static int IoReadSync(GuliIoRequest* req)
+{
+    req->fd = open(req->path, O_RDONLY | O_CLOEXEC);
+    if (req->fd < 0 || !IoPrepareBuffer(req)) return 0;
+
+    while (req->done < req->size)
+    {
+        if (atomic_load_explicit(&req->cancel, memory_order_acquire)) return 0;
+        const ssize_t r = pread(req->fd, req->data + req->done, req->size - req->done, (off_t)req->done);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return 0;
+        if (r == 0) break;  /* file shrank */
+        req->done += (size_t)r;
+    }
+    return 1;
+}
+
+static void* IoWorker(void* arg)
+{
+    GuliIo* io = (GuliIo*)arg;
+    for (;;)
+    {
+        GuliMutexLock(&io->lock);
+        GuliIoRequest* req;
+        while (!(req = IoPopPending(io)) && !io->shutdown)
+            GuliCondWait(&io->cond_work, &io->lock);
+        GuliMutexUnlock(&io->lock);
+        if (!req) break;
+
+        const int ok = !atomic_load_explicit(&req->cancel, memory_order_acquire) && IoReadSync(req);
+        IoFinish(io, req, ok);
+    }
+    return NULL;
+}
+
+/* -----------------------------------------------------------------------------
+ * io_uring backend (raw syscalls, no liburing)
+ *
+ * One ring thread owns the ring. Each request is an OPENAT, then fstat on the
+ * ring thread (inode already cached), then READs until the file is consumed.
+ * An eventfd poll wakes the ring when new work arrives.
+ * ----------------------------------------------------------------------------- */
+
+#if GULI_IO_URING
+#define IO_TAG_OPEN 1u
+#define IO_TAG_READ 2u
+#define IO_TAG_MASK 3u
+#define IO_WAKE_DATA 0u
+
+static int IoRingEnter(IoRing* ring, unsigned submit, unsigned wait)
+{
+    for (;;)
+    {
+        const long r = syscall(__NR_io_uring_enter, ring->fd, submit, wait, wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (r >= 0) return (int)r;
+        if (errno != EINTR) return -1;
+    }
+}
+
+static int IoRingSupports(int fd, const int* ops, int count)
+{
+    const size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*)GuliCalloc(1, size);
+    if (!probe) return 0;
+    int ok = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, 256) >= 0;
+    for (int i = 0; ok && i < count; i++)
+        ok = ops[i] <= probe->last_op && (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED);
+    GuliFree(probe);
+    return ok;
+}
+
+static void IoRingDestroy(IoRing* ring)
+{
+    if (ring->sqes) munmap(ring->sqes, ring->sqes_len);
+    if (ring->cq_ptr && ring->cq_ptr != ring->sq_ptr) munmap(ring->cq_ptr, ring->cq_len);
+    if (ring->sq_ptr) munmap(ring->sq_ptr, ring->sq_len);
+    if (ring->fd >= 0) close(ring->fd);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+static int IoRingInit(IoRing* ring, unsigned entries)
+{
+    memset(ring, 0, sizeof(*ring));
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (ring->fd < 0) return 0;
+
+    static const int ops[] = { IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_POLL_ADD };
+    if (!IoRingSupports(ring->fd, ops, (int)(sizeof(ops) / sizeof(ops[0]))))
+    {
+        IoRingDestroy(ring);
+        return 0;
+    }
+
+    ring->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ring->cq_len > ring->sq_len) ring->sq_len = ring->cq_len;
+        ring->cq_len = ring->sq_len;
+    }
+
+    void* sq = mmap(NULL, ring->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED)
+    {
+        IoRingDestroy(ring);
+        return 0;
+    }
+    ring->sq_ptr = sq;
+
+    void* cq = sq;
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        cq = mmap(NULL, ring->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED)
+        {
+            IoRingDestroy(ring);
+            return 0;
+        }
+    }
+    ring->cq_ptr = cq;
+
+    ring->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        IoRingDestroy(ring);
+        return 0;
+    }
+    ring->sqes = (struct io_uring_sqe*)sqes;
+
+    unsigned char* s = (unsigned char*)sq;
+    unsigned char* c = (unsigned char*)cq;
+    ring->sq_head = (unsigned*)(s + p.sq_off.head);
+    ring->sq_tail = (unsigned*)(s + p.sq_off.tail);
+    ring->sq_mask = (unsigned*)(s + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned*)(s + p.sq_off.array);
+    ring->cq_head = (unsigned*)(c + p.cq_off.head);
+    ring->cq_tail = (unsigned*)(c + p.cq_off.tail);
+    ring->cq_mask = (unsigned*)(c + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(c + p.cq_off.cqes);
+    ring->entries = p.sq_entries;
+    return 1;
+}
+
+/* Caller guarantees a free slot (inflight < entries). */
+static struct io_uring_sqe* IoRingGetSqe(IoRing* ring, uint64_t userData)
+{
+    const unsigned tail = *ring->sq_tail;
+    const unsigned idx = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = userData;
+    ring->sq_array[idx] = idx;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+    ring->inflight++;
+    return sqe;
+}
+
+static void IoRingArmWake(GuliIo* io)
+{
+    struct io_uring_sqe* sqe = IoRingGetSqe(&io->ring, IO_WAKE_DATA);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = io->wake_fd;
+    sqe->poll32_events = POLLIN;
+}
+
+static void IoRingQueueRead(IoRing* ring, GuliIoRequest* req)
+{
+    const size_t left = req->size - req->done;
+    struct io_uring_sqe* sqe = IoRingGetSqe(ring, (uint64_t)(uintptr_t)req | IO_TAG_READ);
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = req->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(req->data + req->done);
+    sqe->len = (unsigned)(left < GULI_IO_READ_CHUNK ? left : GULI_IO_READ_CHUNK);
+    sqe->off = req->done;
+}
+
+static void IoRingComplete(GuliIo* io, uint64_t userData, int res)
+{
+    IoRing* ring = &io->ring;
+    if (userData == IO_WAKE_DATA)
+    {
+        uint64_t v;
+        if (read(io->wake_fd, &v, sizeof(v)) < 0) { /* counter already drained */ }
+        IoRingArmWake(io);
+        return;
+    }
+
+    GuliIoRequest* req = (GuliIoRequest*)(uintptr_t)(userData & ~(uint64_t)IO_TAG_MASK);
+    const unsigned tag = (unsigned)(userData & IO_TAG_MASK);
+    const int canceled = atomic_load_explicit(&req->cancel, memory_order_acquire);
+
+    if (tag == IO_TAG_OPEN)
+    {
+        if (res < 0 || canceled)
+        {
+            if (res >= 0) req->fd = res;
+            IoFinish(io, req, 0);
+            return;
+        }
+        req->fd = res;
+        if (!IoPrepareBuffer(req))
+        {
+            IoFinish(io, req, 0);
+            return;
+        }
+        if (req->size == 0)
+        {
+            IoFinish(io, req, 1);
+            return;
+        }
+        IoRingQueueRead(ring, req);
+        return;
+    }
+
+    if (res == -EINTR || res == -EAGAIN)
+    {
+        if (!canceled)
+        {
+            IoRingQueueRead(ring, req);
+            return;
+        }
+    }
+    if (res < 0 || canceled)
+    {
+        IoFinish(io, req, 0);
+        return;
+    }
+    req->done += (size_t)res;
+    if (res == 0 || req->done >= req->size)
+    {
+        IoFinish(io, req, 1);
+        return;
+    }
+    IoRingQueueRead(ring, req);
+}
+
+static void* IoRingThread(void* arg)
+{
+    GuliIo* io = (GuliIo*)arg;
+    IoRing* ring = &io->ring;
+    IoRingArmWake(io);
+
+    for (;;)
+    {
+        /* Start as many queued requests as the ring can hold; each needs one slot at a time. */
+        GuliMutexLock(&io->lock);
+        GuliIoRequest* start = NULL;
+        GuliIoRequest** link = &start;
+        unsigned room = ring->entries - ring->inflight;
+        GuliIoRequest* req;
+        while (room > 0 && (req = IoPopPending(io)))
+        {
+            *link = req;
+            link = &req->next;
+            room--;
+        }
+        const int shutdown = io->shutdown;
+        GuliMutexUnlock(&io->lock);
+
+        while (start)
+        {
+            req = start;
+            start = req->next;
+            req->next = NULL;
+            if (atomic_load_explicit(&req->cancel, memory_order_acquire))
+            {
+                IoFinish(io, req, 0);
+                continue;
+            }
+            struct io_uring_sqe* sqe = IoRingGetSqe(ring, (uint64_t)(uintptr_t)req | IO_TAG_OPEN);
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (uint64_t)(uintptr_t)req->path;
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        }
+
+        if (shutdown && ring->inflight <= 1)  /* only the wake poll left */
+            break;
+
+        if (IoRingEnter(ring, ring->to_submit, 1) < 0)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "io_uring_enter failed");
+            break;
+        }
+        ring->to_submit = 0;
+
+        unsigned head = *ring->cq_head;
+        const unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++)
+        {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+            const uint64_t userData = cqe->user_data;
+            const int res = cqe->res;
+            __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+            ring->inflight--;
+            IoRingComplete(io, userData, res);
+        }
+    }
+    return NULL;
+}
+
+static void IoWake(GuliIo* io)
+{
+    if (!io->use_ring) return;
+    const uint64_t one = 1;
+    if (write(io->wake_fd, &one, sizeof(one)) < 0) { /* counter saturated; ring is awake anyway */ }
+}
+#else
+static void IoWake(GuliIo* io)
+{
+    (void)io;
+}
+#endif /* GULI_IO_URING */
+
+/* -----------------------------------------------------------------------------
+ * Public API
+ * ----------------------------------------------------------------------------- */
+
+GuliIo* GuliIoCreate(const GuliIoDesc* desc)
+{
+    const GuliIoDesc defaults = {0};
+    if (!desc) desc = &defaults;
+
+    GuliIo* io = (GuliIo*)GuliCalloc(1, sizeof(GuliIo));
+    if (!io) return NULL;
+    GuliMutexInit(&io->lock);
+    GuliCondInit(&io->cond_work);
+    GuliCondInit(&io->cond_done);
+
+#if GULI_IO_URING
+    io->wake_fd = -1;
+    io->ring.fd = -1;
+    if (!desc->disable_uring)
+    {
+        const unsigned depth = desc->queue_depth > 0 ? (unsigned)desc->queue_depth : 64u;
+        io->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (io->wake_fd >= 0 && IoRingInit(&io->ring, depth))
+        {
+            io->use_ring = 1;
+            if (GuliThreadCreate(&io->threads[0], IoRingThread, io))
+            {
+                io->thread_count = 1;
+                return io;
+            }
+            IoRingDestroy(&io->ring);
+            io->use_ring = 0;
+        }
+        if (io->wake_fd >= 0) close(io->wake_fd);
+        io->wake_fd = -1;
+    }
+#endif
+
+    int threads = desc->threads > 0 ? desc->threads : 4;
+    if (threads > GULI_IO_MAX_THREADS) threads = GULI_IO_MAX_THREADS;
+    for (int t = 0; t < threads; t++)
+    {
+        if (!GuliThreadCreate(&io->threads[t], IoWorker, io)) break;
+        io->thread_count++;
+    }
+    if (io->thread_count == 0)
+    {
+        GuliCondDestroy(&io->cond_done);
+        GuliCondDestroy(&io->cond_work);
+        GuliMutexDestroy(&io->lock);
+        GuliFree(io);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to start I/O threads");
+        return NULL;
+    }
+    return io;
+}
+
+void GuliIoDestroy(GuliIo* io)
+{
+    if (!io) return;
+
+    GuliMutexLock(&io->lock);
+    GuliIoRequest* req;
+    while ((req = IoPopPending(io)))
+    {
+        atomic_store_explicit(&req->cancel, 1, memory_order_release);
+        IoPushDone(io, req, GULI_IO_CANCELED);
+    }
+    io->shutdown = 1;
+    GuliCondBroadcast(&io->cond_work);
+    GuliMutexUnlock(&io->lock);
+    IoWake(io);
+
+    for (int t = 0; t < io->thread_count; t++)
+        GuliThreadJoin(io->threads[t]);
+
+    /* Everything is final now, so Cancel/Wait on surviving requests never touch io again. */
+    GuliIoPoll(io);
+
+#if GULI_IO_URING
+    if (io->use_ring) IoRingDestroy(&io->ring);
+    if (io->wake_fd >= 0) close(io->wake_fd);
+#endif
+    GuliCondDestroy(&io->cond_done);
+    GuliCondDestroy(&io->cond_work);
+    GuliMutexDestroy(&io->lock);
+    GuliFree(io);
+}
+
+const char* GuliIoGetBackendName(const GuliIo* io)
+{
+    if (!io) return NULL;
+    return io->use_ring ? "io_uring" : "threads";
+}
+
+GuliIoRequest* GuliIoRead(GuliIo* io, const char* path, GuliIoPriority priority, GuliIoCallback callback, void* user)
+{
+    if (!io || !path) return NULL;
+    if ((int)priority < 0 || priority >= GULI_IO_PRIORITY_COUNT) priority = GULI_IO_PRIORITY_NORMAL;
+
+    GuliIoRequest* req = (GuliIoRequest*)GuliCalloc(1, sizeof(GuliIoRequest));
+    if (!req) return NULL;
+    req->path = GuliStrdup(path);
+    if (!req->path)
+    {
+        GuliFree(req);
+        return NULL;
+    }
+    req->io = io;
+    req->priority = priority;
+    req->callback = callback;
+    req->user = user;
+    req->fd = -1;
+    atomic_init(&req->status, GULI_IO_PENDING);
+    atomic_init(&req->cancel, 0);
+    atomic_init(&req->refs, 2);
+
+    GuliMutexLock(&io->lock);
+    req->queued = 1;
+    req->prev = io->pending_tail[priority];
+    if (req->prev) req->prev->next = req;
+    else io->pending_head[priority] = req;
+    io->pending_tail[priority] = req;
+    GuliCondSignal(&io->cond_work);
+    GuliMutexUnlock(&io->lock);
+    IoWake(io);
+    return req;
+}
+
+size_t GuliIoPoll(GuliIo* io)
+{
+    if (!io) return 0;
+
+    GuliMutexLock(&io->lock);
+    GuliIoRequest* list = io->done_head;
+    io->done_head = io->done_tail = NULL;
+    GuliMutexUnlock(&io->lock);
+
+    size_t n = 0;
+    while (list)
+    {
+        GuliIoRequest* req = list;
+        list = req->next;
+        req->next = NULL;
+        if (req->callback)
+        {
+            const GuliIoStatus status = (GuliIoStatus)atomic_load_explicit(&req->status, memory_order_acquire);
+            req->callback(req->user, req, status, req->data, req->size);
+        }
+        IoRequestUnref(req);
+        n++;
+    }
+    return n;
+}
+
+int GuliIoCancel(GuliIoRequest* req)
+{
+    if (!req || GuliIoGetStatus(req) != GULI_IO_PENDING) return 0;
+    GuliIo* io = req->io;
+
+    GuliMutexLock(&io->lock);
+    int result = 0;
+    if (atomic_load_explicit(&req->status, memory_order_acquire) == GULI_IO_PENDING)
+    {
+        atomic_store_explicit(&req->cancel, 1, memory_order_release);
+        if (req->queued)
+        {
+            const int p = (int)req->priority;
+            if (req->prev) req->prev->next = req->next;
+            else io->pending_head[p] = req->next;
+            if (req->next) req->next->prev = req->prev;
+            else io->pending_tail[p] = req->prev;
+            req->next = req->prev = NULL;
+            req->queued = 0;
+            IoPushDone(io, req, GULI_IO_CANCELED);
+        }
+        result = 1;
+    }
+    GuliMutexUnlock(&io->lock);
+    return result;
+}
+
+GuliIoStatus GuliIoGetStatus(const GuliIoRequest* req)
+{
+    if (!req) return GULI_IO_FAILED;
+    return (GuliIoStatus)atomic_load_explicit(&((GuliIoRequest*)req)->status, memory_order_acquire);
+}
+
+GuliIoStatus GuliIoWait(GuliIoRequest* req)
+{
+    if (!req) return GULI_IO_FAILED;
+    GuliIoStatus status = GuliIoGetStatus(req);
+    if (status != GULI_IO_PENDING) return status;
+
+    GuliIo* io = req->io;
+    GuliMutexLock(&io->lock);
+    while ((status = GuliIoGetStatus(req)) == GULI_IO_PENDING)
+        GuliCondWait(&io->cond_done, &io->lock);
+    GuliMutexUnlock(&io->lock);
+    return status;
+}
+
+const void* GuliIoGetData(const GuliIoRequest* req, size_t* size)
+{
+    if (size) *size = 0;
+    if (GuliIoGetStatus(req) != GULI_IO_DONE) return NULL;
+    if (size) *size = req->size;
+    return req->data;
+}
+
+void* GuliIoTakeData(GuliIoRequest* req, size_t* size)
+{
+    if (size) *size = 0;
+    if (GuliIoGetStatus(req) != GULI_IO_DONE) return NULL;
+    void* data = req->data;
+    if (size) *size = req->size;
+    req->data = NULL;
+    req->size = 0;
+    return data;
+}
+
+void GuliIoRelease(GuliIoRequest* req)
+{
+    if (!req) return;
+    if (GuliIoGetStatus(req) == GULI_IO_PENDING)
+        GuliIoCancel(req);
+    IoRequestUnref(req);
+}
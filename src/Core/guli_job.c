@@ -0,0 +1,693 @@
+#include "Core/guli_job.h"
+#include "Core/guli_error.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_thread.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GULI_JOB_MAX_WORKERS 64
+#define GULI_JOB_DEQUE_SIZE 4096  /* power of two */
+#define GULI_JOB_SPIN 64
+#define GULI_JOB_BATCH_CLASSES 7     /* pooled batch capacities: 1, 2, 4, ... 64 jobs */
+#define GULI_JOB_BATCH_POOL_MAX 32   /* cached batches per capacity */
+#define GULI_JOB_FOR_STACK 64        /* parallel-for ranges kept on the stack */
+
+typedef struct JobBatch JobBatch;
+
+typedef struct Job {
+    GuliJobFunc func;
+    void* arg;
+    GuliJobCounter* counter;
+    JobBatch* batch;
+    struct Job* next;  /* injection / render queues */
+} Job;
+
+/* One batch per submit, recycled through a per-capacity pool when its last job finishes. */
+struct JobBatch {
+    atomic_int remaining;
+    int pinned;
+    int size_class;                /* pool class, or -1 when too large to pool */
+    GuliJobCounter* dependency;    /* GuliJobRunAfter: held back until this reaches zero */
+    JobBatch* next;                /* deferred list or pool free list */
+    Job jobs[];
+};
+
+/* Chase-Lev deque: the owner pushes/pops at bottom, thieves take from top. */
+typedef struct {
+    _Atomic(int64_t) top;
+    _Atomic(int64_t) bottom;
+    _Atomic(Job*) slots[GULI_JOB_DEQUE_SIZE];
+} JobDeque;
+
+typedef struct {
+    JobDeque deque;
+    GuliThread thread;
+} JobWorker;
+
+typedef struct {
+    Job* head;
+    Job* tail;
+} JobQueue;
+
+static struct {
+    atomic_int state;          /* 0 stopped, 1 starting, 2 running */
+    int worker_count;
+    JobWorker* workers;
+
+    GuliMutex lock;            /* injection queue, render queue, deferred list, sleep */
+    GuliCond cond_work;
+    JobQueue inject;
+    JobQueue render;
+    atomic_int inject_count;   /* lock-free emptiness hints for the queues above */
+    atomic_int render_count;
+    JobBatch* deferred;
+    atomic_int deferred_count;
+    atomic_int queued;         /* runnable jobs not yet taken by a worker */
+    atomic_int sleepers;
+    int shutdown;
+
+    GuliThread render_thread;
+    atomic_int has_render_thread;
+
+    atomic_int pool_lock;      /* spin lock over the batch pool (usable before init) */
+    JobBatch* pool[GULI_JOB_BATCH_CLASSES];
+    int pool_count[GULI_JOB_BATCH_CLASSES];
+} g_jobs;
+
+static _Thread_local int t_worker_index = -1;
+static _Thread_local uint32_t t_rng = 0;
+
+/* -----------------------------------------------------------------------------
+ * Deque
+ * ----------------------------------------------------------------------------- */
+
+static int JobDequePush(JobDeque* d, Job* job)
+{
+    const int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    const int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= GULI_JOB_DEQUE_SIZE) return 0;
+    atomic_store_explicit(&d->slots[b & (GULI_JOB_DEQUE_SIZE - 1)], job, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return 1;
+}
+
+static Job* JobDequePop(JobDeque* d)
+{
+    const int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b)
+    {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    Job* job = atomic_load_explicit(&d->slots[b & (GULI_JOB_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (t == b)
+    {
+        /* Last item: race thieves for it. */
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+            job = NULL;
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return job;
+}
+
+static Job* JobDequeSteal(JobDeque* d)
+{
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+
+    Job* job = atomic_load_explicit(&d->slots[t & (GULI_JOB_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return job;
+}
+
+/* -----------------------------------------------------------------------------
+ * Scheduling
+ * ----------------------------------------------------------------------------- */
+
+static void JobQueuePush(JobQueue* q, Job* job)
+{
+    job->next = NULL;
+    if (q->tail) q->tail->next = job;
+    else q->head = job;
+    q->tail = job;
+}
+
+static Job* JobQueuePop(JobQueue* q)
+{
+    Job* job = q->head;
+    if (!job) return NULL;
+    q->head = job->next;
+    if (!q->head) q->tail = NULL;
+    job->next = NULL;
+    return job;
+}
+
+static int JobIsRenderThread(void)
+{
+    return atomic_load_explicit(&g_jobs.has_render_thread, memory_order_acquire) &&
+        GuliThreadEqual(g_jobs.render_thread, GuliThreadSelf());
+}
+
+static void JobWake(int count)
+{
+    if (atomic_load(&g_jobs.sleepers) == 0) return;
+    GuliMutexLock(&g_jobs.lock);
+    if (count > 1) GuliCondBroadcast(&g_jobs.cond_work);
+    else GuliCondSignal(&g_jobs.cond_work);
+    GuliMutexUnlock(&g_jobs.lock);
+}
+
+static Job* JobFind(void)
+{
+    const int self = t_worker_index;
+    Job* job = NULL;
+
+    if (self >= 0)
+        job = JobDequePop(&g_jobs.workers[self].deque);
+
+    if (!job && atomic_load_explicit(&g_jobs.inject_count, memory_order_relaxed) > 0)
+    {
+        GuliMutexLock(&g_jobs.lock);
+        job = JobQueuePop(&g_jobs.inject);
+        if (job) atomic_fetch_sub(&g_jobs.inject_count, 1);
+        GuliMutexUnlock(&g_jobs.lock);
+    }
+
+    if (!job && g_jobs.worker_count > 0)
+    {
+        if (!t_rng) t_rng = (uint32_t)(uintptr_t)&t_rng | 1u;
+        t_rng ^= t_rng << 13;
+        t_rng ^= t_rng >> 17;
+        t_rng ^= t_rng << 5;
+        const int start = (int)(t_rng % (uint32_t)g_jobs.worker_count);
+        for (int i = 0; i < g_jobs.worker_count && !job; i++)
+        {
+            const int victim = (start + i) % g_jobs.worker_count;
+            if (victim != self)
+                job = JobDequeSteal(&g_jobs.workers[victim].deque);
+        }
+    }
+
+    if (job) atomic_fetch_sub(&g_jobs.queued, 1);
+    return job;
+}
+
+static void JobSubmitBatch(JobBatch* batch, int count);
+
+static void JobPoolLock(void)
+{
+    int expected = 0;
+    while (!atomic_compare_exchange_weak_explicit(&g_jobs.pool_lock, &expected, 1, memory_order_acquire, memory_order_relaxed))
+    {
+        expected = 0;
+        GuliThreadPause();
+    }
+}
+
+static void JobPoolUnlock(void)
+{
+    atomic_store_explicit(&g_jobs.pool_lock, 0, memory_order_release);
+}
+
+static JobBatch* JobBatchAlloc(int count)
+{
+    int size_class = 0;
+    while (size_class < GULI_JOB_BATCH_CLASSES && (1 << size_class) < count)
+        size_class++;
+
+    JobBatch* batch = NULL;
+    if (size_class < GULI_JOB_BATCH_CLASSES)
+    {
+        JobPoolLock();
+        batch = g_jobs.pool[size_class];
+        if (batch)
+        {
+            g_jobs.pool[size_class] = batch->next;
+            g_jobs.pool_count[size_class]--;
+        }
+        JobPoolUnlock();
+        if (!batch) batch = (JobBatch*)GuliMalloc(sizeof(JobBatch) + ((size_t)1 << size_class) * sizeof(Job));
+    }
+    else
+    {
+        size_class = -1;
+        batch = (JobBatch*)GuliMalloc(sizeof(JobBatch) + (size_t)count * sizeof(Job));
+    }
+    if (batch) batch->size_class = size_class;
+    return batch;
+}
+
+static void JobBatchRelease(JobBatch* batch)
+{
+    const int size_class = batch->size_class;
+    if (size_class >= 0)
+    {
+        JobPoolLock();
+        if (g_jobs.pool_count[size_class] < GULI_JOB_BATCH_POOL_MAX)
+        {
+            batch->next = g_jobs.pool[size_class];
+            g_jobs.pool[size_class] = batch;
+            g_jobs.pool_count[size_class]++;
+            batch = NULL;
+        }
+        JobPoolUnlock();
+    }
+    GuliFree(batch);
+}
+
+static void JobCounterRelease(GuliJobCounter* counter)
+{
+    if (atomic_fetch_sub(&counter->value, 1) != 1) return;
+    if (atomic_load(&g_jobs.deferred_count) == 0) return;
+
+    /* Counter hit zero: release batches waiting on it. */
+    JobBatch* ready = NULL;
+    GuliMutexLock(&g_jobs.lock);
+    for (JobBatch** link = &g_jobs.deferred; *link; )
+    {
+        JobBatch* d = *link;
+        if (d->dependency == counter)
+        {
+            *link = d->next;
+            d->next = ready;
+            ready = d;
+            atomic_fetch_sub(&g_jobs.deferred_count, 1);
+        }
+        else
+        {
+            link = &d->next;
+        }
+    }
+    GuliMutexUnlock(&g_jobs.lock);
+
+    while (ready)
+    {
+        JobBatch* d = ready;
+        ready = d->next;
+        JobSubmitBatch(d, atomic_load(&d->remaining));
+    }
+}
+
+static void JobExecute(Job* job)
+{
+    job->func(job->arg);
+    if (job->counter) JobCounterRelease(job->counter);
+    JobBatch* batch = job->batch;
+    if (atomic_fetch_sub(&batch->remaining, 1) == 1)
+        JobBatchRelease(batch);
+}
+
+static void JobSubmitBatch(JobBatch* batch, int count)
+{
+    if (batch->pinned)
+    {
+        GuliMutexLock(&g_jobs.lock);
+        for (int i = 0; i < count; i++)
+            JobQueuePush(&g_jobs.render, &batch->jobs[i]);
+        atomic_fetch_add(&g_jobs.render_count, count);
+        GuliMutexUnlock(&g_jobs.lock);
+        return;
+    }
+
+    const int self = t_worker_index;
+    int i = 0;
+    atomic_fetch_add(&g_jobs.queued, count);
+    if (self >= 0)
+    {
+        for (; i < count; i++)
+            if (!JobDequePush(&g_jobs.workers[self].deque, &batch->jobs[i])) break;
+    }
+    if (i < count)
+    {
+        GuliMutexLock(&g_jobs.lock);
+        atomic_fetch_add(&g_jobs.inject_count, count - i);
+        for (; i < count; i++)
+            JobQueuePush(&g_jobs.inject, &batch->jobs[i]);
+        GuliMutexUnlock(&g_jobs.lock);
+    }
+    JobWake(count);
+}
+
+static void* JobWorkerMain(void* arg)
+{
+    t_worker_index = (int)(intptr_t)arg;
+
+    for (;;)
+    {
+        Job* job = JobFind();
+        for (int spin = 0; !job && spin < GULI_JOB_SPIN; spin++)
+        {
+            GuliThreadYield();
+            job = JobFind();
+        }
+        if (job)
+        {
+            JobExecute(job);
+            continue;
+        }
+
+        GuliMutexLock(&g_jobs.lock);
+        atomic_fetch_add(&g_jobs.sleepers, 1);
+        while (atomic_load(&g_jobs.queued) == 0 && !g_jobs.shutdown)
+            GuliCondWait(&g_jobs.cond_work, &g_jobs.lock);
+        atomic_fetch_sub(&g_jobs.sleepers, 1);
+        const int stop = g_jobs.shutdown && atomic_load(&g_jobs.queued) == 0;
+        GuliMutexUnlock(&g_jobs.lock);
+        if (stop) break;
+    }
+    return NULL;
+}
+
+/* -----------------------------------------------------------------------------
+ * Lifetime
+ * ----------------------------------------------------------------------------- */
+
+static int JobStart(int threads)
+{
+    if (threads <= 0) threads = GuliGetCpuCount() - 1;
+    if (threads < 1) threads = 1;
+    if (threads > GULI_JOB_MAX_WORKERS) threads = GULI_JOB_MAX_WORKERS;
+
+    g_jobs.workers = (JobWorker*)GuliCalloc((size_t)threads, sizeof(JobWorker));
+    if (!g_jobs.workers)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate job workers");
+        return 0;
+    }
+    GuliMutexInit(&g_jobs.lock);
+    GuliCondInit(&g_jobs.cond_work);
+    g_jobs.shutdown = 0;
+    g_jobs.worker_count = threads;
+
+    for (int i = 0; i < threads; i++)
+    {
+        if (!GuliThreadCreate(&g_jobs.workers[i].thread, JobWorkerMain, (void*)(intptr_t)i))
+        {
+            /* Run with the workers we have; thieves only look at started deques. */
+            g_jobs.worker_count = i;
+            break;
+        }
+    }
+    if (g_jobs.worker_count == 0)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to start job workers; jobs run on waiting threads");
+    }
+    return 1;
+}
+
+static int JobEnsure(int threads)
+{
+    for (;;)
+    {
+        int state = atomic_load(&g_jobs.state);
+        if (state == 2) return 1;
+        if (state == 0 && atomic_compare_exchange_strong(&g_jobs.state, &state, 1))
+        {
+            const int ok = JobStart(threads);
+            atomic_store(&g_jobs.state, ok ? 2 : 0);
+            return ok;
+        }
+        GuliThreadYield();
+    }
+}
+
+int GuliJobSystemInit(int threads)
+{
+    return JobEnsure(threads);
+}
+
+void GuliJobSystemShutdown(void)
+{
+    int state = 2;
+    if (!atomic_compare_exchange_strong(&g_jobs.state, &state, 1)) return;
+
+    /* Pinned jobs can only run here; drain them so their counters settle. */
+    GuliJobPumpRenderThread();
+
+    GuliMutexLock(&g_jobs.lock);
+    g_jobs.shutdown = 1;
+    GuliCondBroadcast(&g_jobs.cond_work);
+    GuliMutexUnlock(&g_jobs.lock);
+
+    for (int i = 0; i < g_jobs.worker_count; i++)
+        GuliThreadJoin(g_jobs.workers[i].thread);
+
+    /* No workers left: run anything still queued (e.g. when no worker could start). */
+    Job* job;
+    while ((job = JobFind()))
+        JobExecute(job);
+
+    while (g_jobs.deferred)
+    {
+        JobBatch* d = g_jobs.deferred;
+        g_jobs.deferred = d->next;
+        GuliFree(d);
+    }
+    atomic_store(&g_jobs.deferred_count, 0);
+
+    for (int c = 0; c < GULI_JOB_BATCH_CLASSES; c++)
+    {
+        while (g_jobs.pool[c])
+        {
+            JobBatch* b = g_jobs.pool[c];
+            g_jobs.pool[c] = b->next;
+            GuliFree(b);
+        }
+        g_jobs.pool_count[c] = 0;
+    }
+
+    GuliCondDestroy(&g_jobs.cond_work);
+    GuliMutexDestroy(&g_jobs.lock);
+    GuliFree(g_jobs.workers);
+    g_jobs.workers = NULL;
+    g_jobs.worker_count = 0;
+    atomic_store(&g_jobs.state, 0);
+}
+
+int GuliJobGetWorkerCount(void)
+{
+    JobEnsure(0);
+    return g_jobs.worker_count;
+}
+
+int GuliJobGetWorkerIndex(void)
+{
+    return t_worker_index;
+}
+
+void GuliJobSetRenderThread(void)
+{
+    g_jobs.render_thread = GuliThreadSelf();
+    atomic_store_explicit(&g_jobs.has_render_thread, 1, memory_order_release);
+}
+
+/* -----------------------------------------------------------------------------
+ * Submission and waiting
+ * ----------------------------------------------------------------------------- */
+
+static JobBatch* JobBatchCreate(const GuliJobDecl* jobs, int count, GuliJobCounter* counter, int pinned)
+{
+    JobBatch* batch = JobBatchAlloc(count);
+    if (!batch)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate jobs");
+        return NULL;
+    }
+    atomic_init(&batch->remaining, count);
+    batch->pinned = pinned;
+    batch->dependency = NULL;
+    batch->next = NULL;
+    for (int i = 0; i < count; i++)
+    {
+        batch->jobs[i].func = jobs[i].func;
+        batch->jobs[i].arg = jobs[i].arg;
+        batch->jobs[i].counter = counter;
+        batch->jobs[i].batch = batch;
+        batch->jobs[i].next = NULL;
+    }
+    if (counter) atomic_fetch_add(&counter->value, count);
+    return batch;
+}
+
+/* Allocation failure: run inline so counters still reach zero. */
+static void JobRunInline(const GuliJobDecl* jobs, int count)
+{
+    for (int i = 0; i < count; i++)
+        jobs[i].func(jobs[i].arg);
+}
+
+void GuliJobRun(const GuliJobDecl* jobs, int count, GuliJobCounter* counter)
+{
+    if (!jobs || count <= 0) return;
+    JobEnsure(0);
+    JobBatch* batch = JobBatchCreate(jobs, count, counter, 0);
+    if (!batch)
+    {
+        JobRunInline(jobs, count);
+        return;
+    }
+    JobSubmitBatch(batch, count);
+}
+
+void GuliJobRunOnRenderThread(const GuliJobDecl* jobs, int count, GuliJobCounter* counter)
+{
+    if (!jobs || count <= 0) return;
+    JobEnsure(0);
+    JobBatch* batch = JobBatchCreate(jobs, count, counter, 1);
+    if (!batch)
+    {
+        JobRunInline(jobs, count);
+        return;
+    }
+    JobSubmitBatch(batch, count);
+}
+
+void GuliJobRunAfter(const GuliJobDecl* jobs, int count, GuliJobCounter* dependency, GuliJobCounter* counter)
+{
+    if (!jobs || count <= 0) return;
+    if (!dependency)
+    {
+        GuliJobRun(jobs, count, counter);
+        return;
+    }
+    JobEnsure(0);
+
+    JobBatch* batch = JobBatchCreate(jobs, count, counter, 0);
+    if (!batch)
+    {
+        GuliJobWait(dependency);
+        JobRunInline(jobs, count);
+        return;
+    }
+    batch->dependency = dependency;
+
+    /* Publish first, then check: a concurrent release either sees the entry or we see zero. */
+    GuliMutexLock(&g_jobs.lock);
+    atomic_fetch_add(&g_jobs.deferred_count, 1);
+    const int ready = atomic_load(&dependency->value) == 0;
+    if (ready)
+    {
+        atomic_fetch_sub(&g_jobs.deferred_count, 1);
+    }
+    else
+    {
+        batch->next = g_jobs.deferred;
+        g_jobs.deferred = batch;
+    }
+    GuliMutexUnlock(&g_jobs.lock);
+
+    if (ready)
+        JobSubmitBatch(batch, count);
+}
+
+size_t GuliJobPumpRenderThread(void)
+{
+    if (atomic_load(&g_jobs.state) == 0) return 0;
+    /* Other threads may draw to their own contexts (GuliContextBeginDraw); pinned jobs stay here. */
+    if (atomic_load_explicit(&g_jobs.has_render_thread, memory_order_acquire) && !JobIsRenderThread()) return 0;
+
+    size_t n = 0;
+    for (;;)
+    {
+        GuliMutexLock(&g_jobs.lock);
+        Job* job = JobQueuePop(&g_jobs.render);
+        if (job) atomic_fetch_sub(&g_jobs.render_count, 1);
+        GuliMutexUnlock(&g_jobs.lock);
+        if (!job) break;
+        JobExecute(job);
+        n++;
+    }
+    return n;
+}
+
+void GuliJobWait(GuliJobCounter* counter)
+{
+    if (!counter) return;
+    const int render = JobIsRenderThread();
+    while (atomic_load(&counter->value) > 0)
+    {
+        if (render && atomic_load_explicit(&g_jobs.render_count, memory_order_relaxed) > 0 &&
+            GuliJobPumpRenderThread() > 0)
+            continue;
+        Job* job = JobFind();
+        if (job) JobExecute(job);
+        else GuliThreadYield();
+    }
+}
+
+/* -----------------------------------------------------------------------------
+ * Parallel for
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    GuliParallelForFunc func;
+    void* user;
+    size_t begin;
+    size_t end;
+} ForRange;
+
+static void ForRangeRun(void* arg)
+{
+    const ForRange* r = (const ForRange*)arg;
+    r->func(r->user, r->begin, r->end);
+}
+
+void GuliParallelFor(size_t count, size_t grain, GuliParallelForFunc func, void* user)
+{
+    if (!func || count == 0) return;
+
+    if (grain == 0)
+    {
+        const size_t threads = (size_t)GuliJobGetWorkerCount() + 1;
+        const size_t chunks = threads * 4;
+        grain = (count + chunks - 1) / chunks;
+    }
+    if (grain >= count)
+    {
+        func(user, 0, count);
+        return;
+    }
+
+    const size_t jobs = (count + grain - 1) / grain;
+    ForRange stack_ranges[GULI_JOB_FOR_STACK];
+    GuliJobDecl stack_decls[GULI_JOB_FOR_STACK];
+    ForRange* ranges = stack_ranges;
+    GuliJobDecl* decls = stack_decls;
+    if (jobs > GULI_JOB_FOR_STACK)
+    {
+        ranges = (jobs <= INT32_MAX) ? (ForRange*)GuliMalloc(jobs * (sizeof(ForRange) + sizeof(GuliJobDecl))) : NULL;
+        if (!ranges)
+        {
+            func(user, 0, count);
+            return;
+        }
+        decls = (GuliJobDecl*)(ranges + jobs);
+    }
+    for (size_t i = 0; i < jobs; i++)
+    {
+        ranges[i].func = func;
+        ranges[i].user = user;
+        ranges[i].begin = i * grain;
+        ranges[i].end = (i + 1) * grain < count ? (i + 1) * grain : count;
+        decls[i].func = ForRangeRun;
+        decls[i].arg = &ranges[i];
+    }
+
+    /* Keep the first range for this thread; it would otherwise sit idle in Wait. */
+    GuliJobCounter counter = {0};
+    GuliJobRun(decls + 1, (int)(jobs - 1), &counter);
+    ForRangeRun(&ranges[0]);
+    GuliJobWait(&counter);
+    if (ranges != stack_ranges) GuliFree(ranges);
+}
@@ -0,0 +1,319 @@
+#include "Core/guli_log.h"
+#include "Core/guli_hash.h"
+#include "Core/guli_thread.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* -----------------------------------------------------------------------------
+ * Bounded MPSC ring (sequence-numbered slots). A producer claims a position with
+ * a CAS on the head, fills the slot and publishes it by storing pos + 1 into the
+ * slot's sequence; the log thread consumes in order and hands the slot back with
+ * pos + capacity. Producers only take the lock to wake the log thread when it
+ * sleeps on an empty ring.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_LOG_CAPACITY 1024        /* slots, power of two */
+#define GULI_LOG_RATE_SLOTS 256       /* rate-limit table entries, power of two */
+#define GULI_LOG_RATE_WINDOW_NS 1000000000ull
+
+typedef struct {
+    _Alignas(64) atomic_size_t sequence;
+    uint64_t time_ns;
+    int32_t level;
+    int32_t code;
+    uint32_t suppressed;
+    char text[GULI_LOG_MESSAGE_MAX];
+} GuliLogSlot;
+
+/* Rate-limit entry. Replaced when another message hashes to the same slot, so limits are approximate. */
+typedef struct {
+    atomic_uint_fast64_t hash;
+    atomic_uint_fast64_t window_start;
+    atomic_uint count;
+    atomic_uint suppressed;
+} GuliLogRate;
+
+enum {
+    GULI_LOG_STOPPED = 0,
+    GULI_LOG_STARTING,
+    GULI_LOG_RUNNING,
+    GULI_LOG_SYNC,                    /* thread could not start: write on the caller */
+};
+
+static struct {
+    GuliLogSlot slots[GULI_LOG_CAPACITY];
+    _Alignas(64) atomic_size_t head;  /* next position to claim */
+    _Alignas(64) atomic_size_t written;  /* positions handed to the sink (log thread) */
+    atomic_int sleeping;
+    atomic_int state;
+    atomic_int level;
+    atomic_uint rate_limit;
+    atomic_uint_fast64_t dropped;
+    int primitives;                   /* lock and conditions initialized */
+    int quit;
+    GuliMutex lock;                   /* sleep/wake, flush, sink changes and synchronous writes */
+    GuliCond wake;
+    GuliCond flushed;
+    GuliThread thread;
+    GuliLogSink sink;
+    void* sink_user;
+    GuliLogRate rates[GULI_LOG_RATE_SLOTS];
+} g_log = { .level = GULI_LOG_INFO, .rate_limit = 10 };
+
+static uint64_t GuliLogNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void GuliLogStderrSink(void* user, const GuliLogRecord* record)
+{
+    (void)user;
+    static const char* const k_levels[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+    const char* tag = (unsigned)record->level < GULI_LOG_NONE ? k_levels[record->level] : "LOG";
+    char code[16] = "";
+    if (record->level == GULI_LOG_ERROR || record->code) snprintf(code, sizeof(code), " [%d]", record->code);
+    if (record->suppressed)
+        fprintf(stderr, "%s%s: %s (%u repeats suppressed)\n", tag, code, record->message, record->suppressed);
+    else
+        fprintf(stderr, "%s%s: %s\n", tag, code, record->message);
+}
+
+/* Deliver one record to the current sink. Caller holds the lock. */
+static void GuliLogEmit(const GuliLogSlot* slot)
+{
+    const GuliLogRecord record = {
+        slot->time_ns, (GuliLogLevel)slot->level, slot->code, slot->suppressed, slot->text,
+    };
+    if (g_log.sink) g_log.sink(g_log.sink_user, &record);
+    else GuliLogStderrSink(NULL, &record);
+}
+
+static void* GuliLogThreadMain(void* arg)
+{
+    (void)arg;
+    size_t tail = atomic_load_explicit(&g_log.written, memory_order_relaxed);
+
+    GuliMutexLock(&g_log.lock);
+    for (;;)
+    {
+        GuliLogSlot* slot = &g_log.slots[tail & (GULI_LOG_CAPACITY - 1)];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) == tail + 1)
+        {
+            GuliLogEmit(slot);
+            atomic_store_explicit(&slot->sequence, tail + GULI_LOG_CAPACITY, memory_order_release);
+            atomic_store_explicit(&g_log.written, ++tail, memory_order_release);
+            continue;
+        }
+
+        /* Drained (or the next slot is still being filled): report progress, then sleep */
+        GuliCondBroadcast(&g_log.flushed);
+        if (g_log.quit && tail == atomic_load_explicit(&g_log.head, memory_order_acquire)) break;
+        /* seq_cst pairs with the producer's publish/sleeping check: one of the two sees the other */
+        atomic_store(&g_log.sleeping, 1);
+        if (atomic_load(&slot->sequence) != tail + 1 &&
+            tail == atomic_load(&g_log.head) && !g_log.quit)
+            GuliCondWait(&g_log.wake, &g_log.lock);
+        else if (tail != atomic_load(&g_log.head))
+        {
+            /* A producer claimed the slot but has not published it yet */
+            GuliMutexUnlock(&g_log.lock);
+            GuliThreadYield();
+            GuliMutexLock(&g_log.lock);
+        }
+        atomic_store(&g_log.sleeping, 0);
+    }
+    GuliMutexUnlock(&g_log.lock);
+    return NULL;
+}
+
+/* Start the log thread once; returns the resulting state. */
+static int GuliLogStart(void)
+{
+    int state = atomic_load_explicit(&g_log.state, memory_order_acquire);
+    if (state == GULI_LOG_RUNNING || state == GULI_LOG_SYNC) return state;
+
+    int expected = GULI_LOG_STOPPED;
+    if (!atomic_compare_exchange_strong(&g_log.state, &expected, GULI_LOG_STARTING))
+    {
+        while ((state = atomic_load_explicit(&g_log.state, memory_order_acquire)) == GULI_LOG_STARTING)
+            GuliThreadYield();
+        return state;
+    }
+
+    if (!g_log.primitives)
+    {
+        if (!GuliMutexInit(&g_log.lock) || !GuliCondInit(&g_log.wake) || !GuliCondInit(&g_log.flushed))
+        {
+            /* Nothing to synchronize with: write on the caller, unserialized */
+            atomic_store(&g_log.state, GULI_LOG_SYNC);
+            return GULI_LOG_SYNC;
+        }
+        for (size_t i = 0; i < GULI_LOG_CAPACITY; i++)
+            atomic_store_explicit(&g_log.slots[i].sequence, i, memory_order_relaxed);
+        g_log.primitives = 1;
+        atexit(GuliLogShutdown);
+    }
+
+    g_log.quit = 0;
+    state = GuliThreadCreate(&g_log.thread, GuliLogThreadMain, NULL) ? GULI_LOG_RUNNING : GULI_LOG_SYNC;
+    atomic_store_explicit(&g_log.state, state, memory_order_release);
+    return state;
+}
+
+/* 0 if the message is over the rate limit; otherwise the count suppressed since the last one let through. */
+static int GuliLogRateCheck(const char* text, uint64_t now, uint32_t* suppressed)
+{
+    const unsigned limit = atomic_load_explicit(&g_log.rate_limit, memory_order_relaxed);
+    *suppressed = 0;
+    if (!limit) return 1;
+
+    const uint64_t hash = GuliHashFNV1a64(text, strlen(text)) | 1u;  /* 0 marks an unused entry */
+    GuliLogRate* r = &g_log.rates[hash & (GULI_LOG_RATE_SLOTS - 1)];
+    if (atomic_load_explicit(&r->hash, memory_order_relaxed) != hash)
+    {
+        atomic_store_explicit(&r->hash, hash, memory_order_relaxed);
+        atomic_store_explicit(&r->window_start, now, memory_order_relaxed);
+        atomic_store_explicit(&r->count, 1, memory_order_relaxed);
+        atomic_store_explicit(&r->suppressed, 0, memory_order_relaxed);
+        return 1;
+    }
+
+    uint_fast64_t start = atomic_load_explicit(&r->window_start, memory_order_relaxed);
+    if (now - start >= GULI_LOG_RATE_WINDOW_NS &&
+        atomic_compare_exchange_strong_explicit(&r->window_start, &start, now, memory_order_relaxed, memory_order_relaxed))
+        atomic_store_explicit(&r->count, 0, memory_order_relaxed);
+
+    if (atomic_fetch_add_explicit(&r->count, 1, memory_order_relaxed) >= limit)
+    {
+        atomic_fetch_add_explicit(&r->suppressed, 1, memory_order_relaxed);
+        return 0;
+    }
+    *suppressed = atomic_exchange_explicit(&r->suppressed, 0, memory_order_relaxed);
+    return 1;
+}
+
+void GuliLog(GuliLogLevel level, int code, const char* fmt, ...)
+{
+    if (!fmt || level >= GULI_LOG_NONE || (int)level < atomic_load_explicit(&g_log.level, memory_order_relaxed))
+        return;
+
+    char text[GULI_LOG_MESSAGE_MAX];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+
+    const uint64_t now = GuliLogNow();
+    uint32_t suppressed;
+    if (!GuliLogRateCheck(text, now, &suppressed)) return;
+
+    const int state = GuliLogStart();
+    if (state != GULI_LOG_RUNNING)
+    {
+        GuliLogSlot slot = { .time_ns = now, .level = (int32_t)level, .code = code, .suppressed = suppressed };
+        memcpy(slot.text, text, sizeof(text));
+        if (g_log.primitives) GuliMutexLock(&g_log.lock);
+        GuliLogEmit(&slot);
+        if (g_log.primitives) GuliMutexUnlock(&g_log.lock);
+        return;
+    }
+
+    /* Claim a slot; a slot whose sequence lags the position is still being consumed: ring full */
+    size_t pos = atomic_load_explicit(&g_log.head, memory_order_relaxed);
+    GuliLogSlot* slot;
+    for (;;)
+    {
+        slot = &g_log.slots[pos & (GULI_LOG_CAPACITY - 1)];
+        const size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&g_log.head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            atomic_fetch_add_explicit(&g_log.dropped, 1, memory_order_relaxed);
+            return;
+        }
+        else pos = atomic_load_explicit(&g_log.head, memory_order_relaxed);
+    }
+
+    slot->time_ns = now;
+    slot->level = (int32_t)level;
+    slot->code = code;
+    slot->suppressed = suppressed;
+    memcpy(slot->text, text, sizeof(text));
+    atomic_store(&slot->sequence, pos + 1);
+
+    if (atomic_load(&g_log.sleeping))
+    {
+        GuliMutexLock(&g_log.lock);
+        GuliCondSignal(&g_log.wake);
+        GuliMutexUnlock(&g_log.lock);
+    }
+}
+
+void GuliLogSetLevel(GuliLogLevel level)
+{
+    atomic_store_explicit(&g_log.level, (int)level, memory_order_relaxed);
+}
+
+void GuliLogSetSink(GuliLogSink sink, void* user)
+{
+    if (GuliLogStart() == GULI_LOG_SYNC && !g_log.primitives)
+    {
+        g_log.sink = sink;
+        g_log.sink_user = user;
+        return;
+    }
+    GuliMutexLock(&g_log.lock);
+    g_log.sink = sink;
+    g_log.sink_user = user;
+    GuliMutexUnlock(&g_log.lock);
+}
+
+void GuliLogSetRateLimit(uint32_t per_second)
+{
+    atomic_store_explicit(&g_log.rate_limit, per_second, memory_order_relaxed);
+}
+
+void GuliLogFlush(void)
+{
+    if (atomic_load_explicit(&g_log.state, memory_order_acquire) != GULI_LOG_RUNNING) return;
+
+    const size_t target = atomic_load(&g_log.head);
+    GuliMutexLock(&g_log.lock);
+    while (atomic_load_explicit(&g_log.written, memory_order_acquire) < target)
+    {
+        GuliCondSignal(&g_log.wake);
+        GuliCondWait(&g_log.flushed, &g_log.lock);
+    }
+    GuliMutexUnlock(&g_log.lock);
+}
+
+uint64_t GuliLogGetDropped(void)
+{
+    return atomic_load_explicit(&g_log.dropped, memory_order_relaxed);
+}
+
+void GuliLogShutdown(void)
+{
+    int expected = GULI_LOG_RUNNING;
+    if (!atomic_compare_exchange_strong(&g_log.state, &expected, GULI_LOG_STARTING)) return;
+
+    GuliMutexLock(&g_log.lock);
+    g_log.quit = 1;
+    GuliCondSignal(&g_log.wake);
+    GuliMutexUnlock(&g_log.lock);
+    GuliThreadJoin(g_log.thread);
+
+    atomic_store_explicit(&g_log.state, GULI_LOG_STOPPED, memory_order_release);
+}
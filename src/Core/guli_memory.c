@@ -0,0 +1,355 @@
+#include "Core/guli_memory.h"
+#include "Core/guli_core.h"
+#include "Core/guli_error.h"
+#include "Core/guli_thread.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Allocator hook and counters
+ * ----------------------------------------------------------------------------- */
+
+static void* GuliDefaultAlloc(void* user, size_t size) { (void)user; return malloc(size); }
+static void* GuliDefaultRealloc(void* user, void* ptr, size_t size) { (void)user; return realloc(ptr, size); }
+static void GuliDefaultFree(void* user, void* ptr) { (void)user; free(ptr); }
+
+static GuliAllocator g_allocator = { GuliDefaultAlloc, GuliDefaultRealloc, GuliDefaultFree, NULL };
+
+static atomic_uint_fast64_t g_allocations;
+static atomic_uint_fast64_t g_reallocations;
+static atomic_uint_fast64_t g_frees;
+
+int GuliSetAllocator(const GuliAllocator* allocator)
+{
+    if (atomic_load(&g_allocations) != atomic_load(&g_frees))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliSetAllocator: allocations from the current allocator are still live");
+        return 0;
+    }
+    if (allocator && (!allocator->alloc || !allocator->realloc || !allocator->free))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliSetAllocator: alloc, realloc and free are required");
+        return 0;
+    }
+    if (allocator) g_allocator = *allocator;
+    else g_allocator = (GuliAllocator){ GuliDefaultAlloc, GuliDefaultRealloc, GuliDefaultFree, NULL };
+    return 1;
+}
+
+void* GuliMalloc(size_t size)
+{
+    void* ptr = g_allocator.alloc(g_allocator.user, size ? size : 1);
+    if (ptr) atomic_fetch_add_explicit(&g_allocations, 1, memory_order_relaxed);
+    return ptr;
+}
+
+void* GuliCalloc(size_t count, size_t size)
+{
+    if (size && count > SIZE_MAX / size) return NULL;
+    void* ptr = GuliMalloc(count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* GuliRealloc(void* ptr, size_t size)
+{
+    if (!ptr) return GuliMalloc(size);
+    if (!size)
+    {
+        GuliFree(ptr);
+        return NULL;
+    }
+    void* grown = g_allocator.realloc(g_allocator.user, ptr, size);
+    if (grown) atomic_fetch_add_explicit(&g_reallocations, 1, memory_order_relaxed);
+    return grown;
+}
+
+void GuliFree(void* ptr)
+{
+    if (!ptr) return;
+    g_allocator.free(g_allocator.user, ptr);
+    atomic_fetch_add_explicit(&g_frees, 1, memory_order_relaxed);
+}
+
+char* GuliStrdup(const char* str)
+{
+    if (!str) return NULL;
+    const size_t len = strlen(str) + 1;
+    char* copy = GuliMalloc(len);
+    if (copy) memcpy(copy, str, len);
+    return copy;
+}
+
+void* GuliMallocAligned(size_t size, size_t alignment)
+{
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    if (size > SIZE_MAX - alignment - sizeof(void*)) return NULL;
+    unsigned char* raw = GuliMalloc(size + alignment - 1 + sizeof(void*));
+    if (!raw) return NULL;
+    /* The raw pointer sits just below the aligned block. */
+    const uintptr_t aligned = ((uintptr_t)(raw + sizeof(void*)) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    ((void**)aligned)[-1] = raw;
+    return (void*)aligned;
+}
+
+void GuliFreeAligned(void* ptr)
+{
+    if (ptr) GuliFree(((void**)ptr)[-1]);
+}
+
+/* -----------------------------------------------------------------------------
+ * Frame arena
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_ARENA_ALIGN 16
+#define GULI_ARENA_MIN_CAPACITY (64 * 1024)
+
+typedef struct ArenaSpill {
+    struct ArenaSpill* next;
+    _Alignas(GULI_ARENA_ALIGN) unsigned char data[];
+} ArenaSpill;
+
+/* One per context: frames of different contexts (possibly on different threads) never share memory */
+struct GuliFrameArena {
+    unsigned char* base;
+    size_t capacity;
+    atomic_size_t offset;          /* may run past capacity: the excess went to spills */
+    atomic_flag spill_lock;
+    ArenaSpill* spills;
+    size_t spill_bytes;
+    size_t reserve;                /* requested minimum capacity */
+    size_t last_used;
+    size_t peak;
+    atomic_uint_fast64_t spill_count;
+    uint64_t frame_mark;           /* allocations + reallocations at the last reset */
+    uint64_t frame_allocations;
+};
+
+/* The GuliInit context's arena; other contexts get theirs from GuliFrameArenaCreate */
+static struct GuliFrameArena g_default_arena = { .spill_lock = ATOMIC_FLAG_INIT };
+
+static struct GuliFrameArena* GuliFrameArenaCurrent(void)
+{
+    struct GuliFrameArena* arena = GuliCurrentState()->arena;
+    return arena ? arena : &g_default_arena;
+}
+
+void* GuliFrameAlloc(size_t size)
+{
+    struct GuliFrameArena* arena = GuliFrameArenaCurrent();
+    size = (size + GULI_ARENA_ALIGN - 1) & ~(size_t)(GULI_ARENA_ALIGN - 1);
+    if (!size) size = GULI_ARENA_ALIGN;
+
+    const size_t offset = atomic_fetch_add_explicit(&arena->offset, size, memory_order_relaxed);
+    if (offset + size <= arena->capacity)
+        return arena->base + offset;
+
+    /* Arena exhausted this frame: spill to the heap until the next reset. */
+    ArenaSpill* spill = GuliMalloc(sizeof(ArenaSpill) + size);
+    if (!spill)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate frame memory");
+        return NULL;
+    }
+    atomic_fetch_add_explicit(&arena->spill_count, 1, memory_order_relaxed);
+    while (atomic_flag_test_and_set_explicit(&arena->spill_lock, memory_order_acquire))
+        GuliThreadPause();
+    spill->next = arena->spills;
+    arena->spills = spill;
+    arena->spill_bytes += size;
+    atomic_flag_clear_explicit(&arena->spill_lock, memory_order_release);
+    return spill->data;
+}
+
+static void GuliFrameArenaFreeSpills(struct GuliFrameArena* arena)
+{
+    while (atomic_flag_test_and_set_explicit(&arena->spill_lock, memory_order_acquire))
+        GuliThreadPause();
+    ArenaSpill* spill = arena->spills;
+    arena->spills = NULL;
+    arena->spill_bytes = 0;
+    atomic_flag_clear_explicit(&arena->spill_lock, memory_order_release);
+
+    while (spill)
+    {
+        ArenaSpill* next = spill->next;
+        GuliFree(spill);
+        spill = next;
+    }
+}
+
+/* Grow the block to at least want bytes (rounded to a power of two). */
+static void GuliFrameArenaGrow(struct GuliFrameArena* arena, size_t want)
+{
+    size_t capacity = arena->capacity ? arena->capacity : GULI_ARENA_MIN_CAPACITY;
+    while (capacity < want)
+        capacity *= 2;
+    if (capacity == arena->capacity) return;
+
+    unsigned char* base = GuliMallocAligned(capacity, GULI_ARENA_ALIGN);
+    if (!base) return;  /* keep the old block; frames keep spilling */
+    GuliFreeAligned(arena->base);
+    arena->base = base;
+    arena->capacity = capacity;
+}
+
+struct GuliFrameArena* GuliFrameArenaCreate(void)
+{
+    struct GuliFrameArena* arena = GuliCalloc(1, sizeof(struct GuliFrameArena));
+    if (arena) atomic_flag_clear(&arena->spill_lock);
+    return arena;
+}
+
+void GuliFrameArenaReserve(size_t bytes)
+{
+    struct GuliFrameArena* arena = GuliFrameArenaCurrent();
+    arena->reserve = bytes;
+    if (bytes > arena->capacity && atomic_load(&arena->offset) == 0)
+        GuliFrameArenaGrow(arena, bytes);
+}
+
+void GuliFrameArenaReset(void)
+{
+    struct GuliFrameArena* arena = GuliFrameArenaCurrent();
+    const size_t offset = atomic_load_explicit(&arena->offset, memory_order_relaxed);
+    const size_t in_block = offset < arena->capacity ? offset : arena->capacity;
+    arena->last_used = in_block + arena->spill_bytes;
+    if (arena->last_used > arena->peak) arena->peak = arena->last_used;
+
+    GuliFrameArenaFreeSpills(arena);
+    const size_t want = arena->peak > arena->reserve ? arena->peak : arena->reserve;
+    if (want > arena->capacity)
+        GuliFrameArenaGrow(arena, want + want / 4);
+    atomic_store_explicit(&arena->offset, 0, memory_order_relaxed);
+
+    const uint64_t mark = atomic_load(&g_allocations) + atomic_load(&g_reallocations);
+    arena->frame_allocations = mark - arena->frame_mark;
+    /* Growth above is charged to the frame that caused it. */
+    arena->frame_mark = mark;
+}
+
+void GuliFrameArenaRelease(void)
+{
+    GuliState* state = GuliCurrentState();
+    struct GuliFrameArena* arena = GuliFrameArenaCurrent();
+    GuliFrameArenaFreeSpills(arena);
+    GuliFreeAligned(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->peak = arena->last_used = 0;
+    atomic_store(&arena->offset, 0);
+    if (state->arena)
+    {
+        GuliFree(state->arena);
+        state->arena = NULL;
+    }
+}
+
+void GuliGetMemoryStats(GuliMemoryStats* stats)
+{
+    if (!stats) return;
+    const uint64_t allocations = atomic_load(&g_allocations);
+    const uint64_t frees = atomic_load(&g_frees);
+    stats->allocations = allocations;
+    stats->reallocations = atomic_load(&g_reallocations);
+    stats->frees = frees;
+    stats->live = allocations - frees;
+    const struct GuliFrameArena* arena = GuliFrameArenaCurrent();
+    stats->frame_allocations = arena->frame_allocations;
+    stats->frame_arena_used = arena->last_used;
+    stats->frame_arena_peak = arena->peak;
+    stats->frame_arena_capacity = arena->capacity;
+    stats->frame_arena_spills = atomic_load(&arena->spill_count);
+}
+
+/* -----------------------------------------------------------------------------
+ * Resource accounting
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    atomic_uint_fast64_t bytes;
+    atomic_uint_fast64_t peak_bytes;
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t peak_count;
+    atomic_uint_fast64_t budget;
+} GuliMemoryCategoryCounters;
+
+static GuliMemoryCategoryCounters g_categories[GULI_MEMORY_CATEGORY_COUNT];
+static GuliMemoryBudgetCallback g_budget_callback;
+static void* g_budget_user;
+
+static const char* const k_category_names[GULI_MEMORY_CATEGORY_COUNT] = {
+    "texture", "buffer", "shader", "framebuffer", "decode", "mesh",
+};
+
+static void GuliMemoryRaisePeak(atomic_uint_fast64_t* peak, uint64_t value)
+{
+    uint_fast64_t current = atomic_load_explicit(peak, memory_order_relaxed);
+    while (value > current &&
+        !atomic_compare_exchange_weak_explicit(peak, &current, value, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+void GuliMemoryTrack(GuliMemoryCategory category, uint64_t bytes)
+{
+    if ((unsigned)category >= GULI_MEMORY_CATEGORY_COUNT) return;
+    GuliMemoryCategoryCounters* c = &g_categories[category];
+
+    const uint64_t after = atomic_fetch_add_explicit(&c->bytes, bytes, memory_order_relaxed) + bytes;
+    GuliMemoryRaisePeak(&c->peak_bytes, after);
+    GuliMemoryRaisePeak(&c->peak_count, atomic_fetch_add_explicit(&c->count, 1, memory_order_relaxed) + 1);
+
+    const uint64_t budget = atomic_load_explicit(&c->budget, memory_order_relaxed);
+    if (!budget || after <= budget || after - bytes > budget) return;
+    if (g_budget_callback)
+    {
+        g_budget_callback(g_budget_user, category, after, budget);
+    }
+    else
+    {
+        GuliLog(GULI_LOG_WARNING, GULI_ERROR_FAILED, "Memory budget exceeded: %s uses %llu of %llu bytes",
+            k_category_names[category], (unsigned long long)after, (unsigned long long)budget);
+    }
+}
+
+void GuliMemoryUntrack(GuliMemoryCategory category, uint64_t bytes)
+{
+    if ((unsigned)category >= GULI_MEMORY_CATEGORY_COUNT) return;
+    atomic_fetch_sub_explicit(&g_categories[category].bytes, bytes, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&g_categories[category].count, 1, memory_order_relaxed);
+}
+
+void GuliSetMemoryBudget(GuliMemoryCategory category, uint64_t bytes)
+{
+    if ((unsigned)category >= GULI_MEMORY_CATEGORY_COUNT) return;
+    atomic_store_explicit(&g_categories[category].budget, bytes, memory_order_relaxed);
+}
+
+void GuliSetMemoryBudgetCallback(GuliMemoryBudgetCallback callback, void* user)
+{
+    g_budget_callback = callback;
+    g_budget_user = user;
+}
+
+void GuliGetMemoryCategoryStats(GuliMemoryCategory category, GuliMemoryCategoryStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if ((unsigned)category >= GULI_MEMORY_CATEGORY_COUNT) return;
+
+    GuliMemoryCategoryCounters* c = &g_categories[category];
+    stats->bytes = atomic_load_explicit(&c->bytes, memory_order_relaxed);
+    stats->peak_bytes = atomic_load_explicit(&c->peak_bytes, memory_order_relaxed);
+    stats->count = atomic_load_explicit(&c->count, memory_order_relaxed);
+    stats->peak_count = atomic_load_explicit(&c->peak_count, memory_order_relaxed);
+    stats->budget = atomic_load_explicit(&c->budget, memory_order_relaxed);
+}
+
+const char* GuliMemoryCategoryName(GuliMemoryCategory category)
+{
+    return (unsigned)category < GULI_MEMORY_CATEGORY_COUNT ? k_category_names[category] : "unknown";
+}
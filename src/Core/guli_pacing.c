@@ -0,0 +1,512 @@
+#include "Core/guli_pacing.h"
+#include "Core/guli_core.h"
+#include "Core/guli_thread.h"
+#ifdef GULI_BACKEND_METAL
+#include "Graphics/Metal/guli_metal.h"
+#endif
+#ifdef GULI_BACKEND_OPENGL
+#include "Graphics/OpenGL/guli_gl.h"
+#endif
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* -----------------------------------------------------------------------------
+ * Frame pacer (one per context)
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_PACING_SAMPLES 128
+#define GULI_PACING_SPIN_MIN_NS 250000ull      /* 0.25 ms */
+#define GULI_PACING_SPIN_MAX_NS 4000000ull     /* 4 ms */
+#define GULI_PACING_SPIN_SLACK_NS 200000ull    /* added to the worst recent oversleep */
+#define GULI_PACING_LATENCY_MARGIN_NS 1000000ull  /* low latency: headroom beyond the measured work */
+
+struct GuliFramePacer {
+    GuliPresentMode mode;
+    int swap_interval;
+    int low_latency;
+    double target_fps;
+    uint64_t period_ns;     /* limiter period, or refresh period when synced; 0 when unknown */
+    uint64_t deadline;      /* limiter: start time of the next frame */
+    uint64_t frame_start;   /* when input was last sampled */
+    uint64_t frame_end;     /* when GuliEndDraw last returned */
+    uint64_t work_ns;       /* smoothed frame_end - frame_start */
+    uint64_t oversleep_ns;  /* decaying maximum of sleep overshoot */
+    uint64_t spin_ns;
+    uint64_t frames;
+    uint64_t late_frames;
+    uint64_t samples[GULI_PACING_SAMPLES];  /* frame times, ns */
+    uint32_t sample_count;
+    uint32_t sample_next;
+
+    /* On-demand redraw. dirty_* collect invalidations from any thread under lock; frame_* hold
+       what the current frame redraws (owner thread only). */
+    int on_demand;
+    GuliMutex lock;
+    int dirty_full;
+    int dirty_count;
+    GuliRect dirty[GULI_MAX_DIRTY_RECTS];
+    int frame_full;
+    int frame_count;
+    GuliRect frame[GULI_MAX_DIRTY_RECTS];
+    int framebuffer_width;   /* last size seen by GuliPollEvents; a change invalidates everything */
+    int framebuffer_height;
+};
+
+static int GuliPacingApplySwapInterval(int interval)
+{
+#ifdef GULI_BACKEND_OPENGL
+    return GlSetSwapInterval(interval);
+#elif defined(GULI_BACKEND_METAL)
+    return MetalSetSwapInterval(interval);
+#else
+    return interval;
+#endif
+}
+
+/* Pick the period and swap interval for the pacer's mode. */
+static void GuliPacingConfigure(struct GuliFramePacer* p)
+{
+    switch (p->mode)
+    {
+    case GULI_PRESENT_UNCAPPED:
+        p->swap_interval = GuliPacingApplySwapInterval(0);
+        p->period_ns = 0;
+        p->target_fps = 0.0;
+        break;
+    case GULI_PRESENT_LIMITED:
+        p->swap_interval = GuliPacingApplySwapInterval(0);
+        p->period_ns = (uint64_t)(1e9 / p->target_fps);
+        break;
+    case GULI_PRESENT_ADAPTIVE:
+    case GULI_PRESENT_VSYNC:
+    default:
+    {
+        p->swap_interval = GuliPacingApplySwapInterval(p->mode == GULI_PRESENT_ADAPTIVE ? -1 : 1);
+        const int hz = G_State.window ? GuliBackendGetRefreshRate(G_State.window) : 0;
+        p->target_fps = (double)hz;
+        p->period_ns = hz > 0 ? 1000000000ull / (uint64_t)hz : 0;
+        break;
+    }
+    }
+    p->deadline = 0;
+}
+
+static struct GuliFramePacer* GuliPacingGet(void)
+{
+    return G_State.pacer;
+}
+
+void GuliFramePacingInit(void)
+{
+    GuliState* state = &G_State;
+    if (state->pacer) return;
+
+    struct GuliFramePacer* p = GuliCalloc(1, sizeof(struct GuliFramePacer));
+    if (!p)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate frame pacer");
+        return;
+    }
+    if (!GuliMutexInit(&p->lock))
+    {
+        GuliFree(p);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create frame pacer mutex");
+        return;
+    }
+    /* GlInit sets swap interval 1: start in the matching mode without touching the swap chain. */
+    p->mode = GULI_PRESENT_VSYNC;
+    p->swap_interval = 1;
+    const int hz = state->window ? GuliBackendGetRefreshRate(state->window) : 0;
+    p->target_fps = (double)hz;
+    p->period_ns = hz > 0 ? 1000000000ull / (uint64_t)hz : 0;
+    p->spin_ns = GULI_PACING_SPIN_MAX_NS / 2;
+    p->dirty_full = 1;
+    state->pacer = p;
+}
+
+/* Sleep until close to target, then spin to it. Returns the time actually reached. */
+static uint64_t GuliPacingWaitUntil(struct GuliFramePacer* p, uint64_t target)
+{
+    uint64_t now = GuliInputGetTimeNs();
+    if (now >= target) return now;
+
+    if (target - now > p->spin_ns)
+    {
+        const uint64_t wake = target - p->spin_ns;
+#if defined(__APPLE__)
+        const uint64_t rel = wake - now;
+        struct timespec ts = { (time_t)(rel / 1000000000ull), (long)(rel % 1000000000ull) };
+        while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+#else
+        struct timespec ts = { (time_t)(wake / 1000000000ull), (long)(wake % 1000000000ull) };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+#endif
+        now = GuliInputGetTimeNs();
+
+        /* Spin margin follows the worst recent overshoot, decaying so one outlier does not stick. */
+        const uint64_t over = now > wake ? now - wake : 0;
+        p->oversleep_ns -= p->oversleep_ns / 16;
+        if (over > p->oversleep_ns) p->oversleep_ns = over;
+        uint64_t spin = p->oversleep_ns + GULI_PACING_SPIN_SLACK_NS;
+        if (spin < GULI_PACING_SPIN_MIN_NS) spin = GULI_PACING_SPIN_MIN_NS;
+        if (spin > GULI_PACING_SPIN_MAX_NS) spin = GULI_PACING_SPIN_MAX_NS;
+        p->spin_ns = spin;
+    }
+
+    while (now < target)
+    {
+        GuliThreadPause();
+        now = GuliInputGetTimeNs();
+    }
+    return now;
+}
+
+/* Wait for this frame's slot per the pacing mode. */
+static void GuliPacingWait(struct GuliFramePacer* p)
+{
+    if (!p->period_ns || !p->frame_start) return;
+
+    if (p->mode == GULI_PRESENT_LIMITED)
+    {
+        /* Fixed cadence from the previous deadline; resynchronize after falling a whole period behind. */
+        const uint64_t now = GuliInputGetTimeNs();
+        uint64_t deadline = p->deadline ? p->deadline + p->period_ns : p->frame_start + p->period_ns;
+        if (now > deadline + p->period_ns) deadline = now;
+        else if (now > deadline + p->period_ns / 2) p->late_frames++;
+        p->deadline = deadline;
+
+        uint64_t wake = deadline;
+        if (p->low_latency && p->frame_end)
+        {
+            /* Sample input so the frame is presented at the deadline rather than started there. */
+            const uint64_t lead = p->work_ns + GULI_PACING_LATENCY_MARGIN_NS;
+            if (lead < p->period_ns) wake = deadline - lead;
+        }
+        GuliPacingWaitUntil(p, wake);
+        return;
+    }
+
+    /* Synced modes: the swap already blocks for the display, so only low latency waits, to just
+       before the next refresh (estimated from when the last swap returned). */
+    if (p->low_latency && p->frame_end && p->mode != GULI_PRESENT_UNCAPPED)
+    {
+        const uint64_t lead = p->work_ns + GULI_PACING_LATENCY_MARGIN_NS;
+        if (lead < p->period_ns)
+            GuliPacingWaitUntil(p, p->frame_end + p->period_ns - lead);
+    }
+}
+
+static int GuliPacingHasDirty(struct GuliFramePacer* p)
+{
+    GuliMutexLock(&p->lock);
+    const int dirty = p->dirty_full || p->dirty_count > 0;
+    GuliMutexUnlock(&p->lock);
+    return dirty;
+}
+
+void GuliPollEvents(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p)
+    {
+        GuliWindowPollEvents();
+        return;
+    }
+
+    /* Idle frames were not drawn: they count neither as frame time nor as work. */
+    const int drew = p->frame_end > p->frame_start;
+    if (p->on_demand && !GuliPacingHasDirty(p))
+    {
+        GuliWindowWaitEvents();
+    }
+    else
+    {
+        GuliPacingWait(p);
+        GuliWindowPollEvents();
+    }
+
+    if (p->on_demand && G_State.window)
+    {
+        int w = 0, h = 0;
+        GuliGetFramebufferSize(&w, &h);
+        if (w != p->framebuffer_width || h != p->framebuffer_height)
+        {
+            p->framebuffer_width = w;
+            p->framebuffer_height = h;
+            GuliInvalidate();
+        }
+    }
+
+    const uint64_t now = GuliInputGetTimeNs();
+    if (p->frame_start && drew)
+    {
+        p->samples[p->sample_next] = now - p->frame_start;
+        p->sample_next = (p->sample_next + 1) % GULI_PACING_SAMPLES;
+        if (p->sample_count < GULI_PACING_SAMPLES) p->sample_count++;
+        p->frames++;
+    }
+    p->frame_start = now;
+}
+
+/* -----------------------------------------------------------------------------
+ * Invalidation
+ * ----------------------------------------------------------------------------- */
+
+static GuliRect GuliRectUnion(GuliRect a, GuliRect b)
+{
+    const int x0 = a.x < b.x ? a.x : b.x;
+    const int y0 = a.y < b.y ? a.y : b.y;
+    const int x1 = (a.x + a.width > b.x + b.width) ? a.x + a.width : b.x + b.width;
+    const int y1 = (a.y + a.height > b.y + b.height) ? a.y + a.height : b.y + b.height;
+    return (GuliRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+static int GuliRectTouches(GuliRect a, GuliRect b)
+{
+    return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+static long long GuliRectArea(GuliRect r)
+{
+    return (long long)r.width * r.height;
+}
+
+/* Add r to the dirty list, merging touching rects; a full list absorbs r where the area grows least. */
+static void GuliPacingAddDirty(struct GuliFramePacer* p, GuliRect r)
+{
+    for (int i = 0; i < p->dirty_count; i++)
+    {
+        if (GuliRectTouches(p->dirty[i], r))
+        {
+            r = GuliRectUnion(p->dirty[i], r);
+            p->dirty[i] = p->dirty[--p->dirty_count];
+            i = -1;  /* the grown rect may now touch others */
+        }
+    }
+    if (p->dirty_count < GULI_MAX_DIRTY_RECTS)
+    {
+        p->dirty[p->dirty_count++] = r;
+        return;
+    }
+    int best = 0;
+    long long best_growth = -1;
+    for (int i = 0; i < p->dirty_count; i++)
+    {
+        const long long growth = GuliRectArea(GuliRectUnion(p->dirty[i], r)) - GuliRectArea(p->dirty[i]);
+        if (best_growth < 0 || growth < best_growth)
+        {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    p->dirty[best] = GuliRectUnion(p->dirty[best], r);
+}
+
+void GuliSetOnDemand(int enabled)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+    p->on_demand = enabled ? 1 : 0;
+    GuliInvalidate();
+}
+
+int GuliIsOnDemand(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    return p ? p->on_demand : 0;
+}
+
+void GuliInvalidate(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+    GuliMutexLock(&p->lock);
+    p->dirty_full = 1;
+    p->dirty_count = 0;
+    GuliMutexUnlock(&p->lock);
+    GuliWindowPostEmptyEvent();
+}
+
+void GuliInvalidateRect(GuliRect rect)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p || rect.width <= 0 || rect.height <= 0) return;
+    GuliMutexLock(&p->lock);
+    if (!p->dirty_full) GuliPacingAddDirty(p, rect);
+    GuliMutexUnlock(&p->lock);
+    GuliWindowPostEmptyEvent();
+}
+
+int GuliNeedsRedraw(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p || !p->on_demand) return 1;
+    return GuliPacingHasDirty(p);
+}
+
+void GuliFramePacingBeginFrame(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+
+    GuliMutexLock(&p->lock);
+    p->frame_full = p->dirty_full || !p->on_demand;
+    p->frame_count = p->frame_full ? 0 : p->dirty_count;
+    memcpy(p->frame, p->dirty, (size_t)p->frame_count * sizeof(GuliRect));
+    p->dirty_full = 0;
+    p->dirty_count = 0;
+    GuliMutexUnlock(&p->lock);
+
+    if (p->frame_full) return;
+
+    /* Clip to the framebuffer; nothing left visible means nothing to scissor to. */
+    int w = 0, h = 0;
+    GuliGetFramebufferSize(&w, &h);
+    int n = 0;
+    for (int i = 0; i < p->frame_count; i++)
+    {
+        GuliRect r = p->frame[i];
+        const int x0 = r.x < 0 ? 0 : r.x, y0 = r.y < 0 ? 0 : r.y;
+        const int x1 = (r.x + r.width > w) ? w : r.x + r.width;
+        const int y1 = (r.y + r.height > h) ? h : r.y + r.height;
+        if (x1 > x0 && y1 > y0)
+            p->frame[n++] = (GuliRect){ x0, y0, x1 - x0, y1 - y0 };
+    }
+    p->frame_count = n;
+    if (!n) p->frame_full = 1;
+}
+
+int GuliFramePacingGetDamage(GuliRect* rects)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p || p->frame_full) return 0;
+    memcpy(rects, p->frame, (size_t)p->frame_count * sizeof(GuliRect));
+    return p->frame_count;
+}
+
+int GuliGetDirtyRects(GuliRect* rects, int max)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!rects || max <= 0) return 0;
+    if (!p || p->frame_full)
+    {
+        int w = 0, h = 0;
+        if (G_State.window) GuliGetFramebufferSize(&w, &h);
+        rects[0] = (GuliRect){ 0, 0, w, h };
+        return 1;
+    }
+    const int n = p->frame_count < max ? p->frame_count : max;
+    memcpy(rects, p->frame, (size_t)n * sizeof(GuliRect));
+    return n;
+}
+
+void GuliFramePacingEndFrame(void)
+{
+    struct GuliFramePacer* p = G_State.pacer;
+    if (!p || !p->frame_start) return;
+
+    p->frame_end = GuliInputGetTimeNs();
+    const uint64_t work = p->frame_end - p->frame_start;
+    /* Rise immediately, fall slowly: underestimating the work makes low-latency frames miss. */
+    p->work_ns = (work > p->work_ns) ? work : p->work_ns - (p->work_ns - work) / 8;
+}
+
+void GuliFramePacingRelease(void)
+{
+    struct GuliFramePacer* p = G_State.pacer;
+    if (!p) return;
+    GuliMutexDestroy(&p->lock);
+    GuliFree(p);
+    G_State.pacer = NULL;
+}
+
+void GuliSetPresentMode(GuliPresentMode mode)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+    if (mode == GULI_PRESENT_LIMITED && p->target_fps <= 0.0)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GULI_PRESENT_LIMITED needs a target; use GuliSetFPS");
+        return;
+    }
+    p->mode = mode;
+    GuliPacingConfigure(p);
+}
+
+GuliPresentMode GuliGetPresentMode(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    return p ? p->mode : GULI_PRESENT_VSYNC;
+}
+
+void GuliSetFPS(double fps)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+    if (fps > 0.0)
+    {
+        p->mode = GULI_PRESENT_LIMITED;
+        p->target_fps = fps;
+    }
+    else
+    {
+        p->mode = GULI_PRESENT_UNCAPPED;
+    }
+    GuliPacingConfigure(p);
+}
+
+void GuliSetLowLatency(int enabled)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (p) p->low_latency = enabled ? 1 : 0;
+}
+
+void GuliGetFrameStats(GuliFrameStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+
+    stats->mode = p->mode;
+    stats->swap_interval = p->swap_interval;
+    stats->target_fps = p->target_fps;
+    stats->frames = p->frames;
+    stats->late_frames = p->late_frames;
+    stats->work_ms = (double)p->work_ns / 1e6;
+    stats->spin_ms = (double)p->spin_ns / 1e6;
+    if (!p->sample_count) return;
+
+    double sum = 0.0, min = 1e300, max = 0.0;
+    for (uint32_t i = 0; i < p->sample_count; i++)
+    {
+        const double ms = (double)p->samples[i] / 1e6;
+        sum += ms;
+        if (ms < min) min = ms;
+        if (ms > max) max = ms;
+    }
+    const double mean = sum / p->sample_count;
+    double var = 0.0;
+    for (uint32_t i = 0; i < p->sample_count; i++)
+    {
+        const double d = (double)p->samples[i] / 1e6 - mean;
+        var += d * d;
+    }
+    stats->frame_ms = mean;
+    stats->min_ms = min;
+    stats->max_ms = max;
+    stats->jitter_ms = sqrt(var / p->sample_count);
+}
+
+void GuliResetFrameStats(void)
+{
+    struct GuliFramePacer* p = GuliPacingGet();
+    if (!p) return;
+    p->frames = p->late_frames = 0;
+    p->sample_count = p->sample_next = 0;
+}
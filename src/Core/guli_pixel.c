@@ -0,0 +1,674 @@
+#include "Core/guli_pixel.h"
+#include "Core/guli_cpu.h"
+#include "Core/guli_memory.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GULI_PIXEL_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define GULI_PIXEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* -----------------------------------------------------------------------------
+ * Kernel table (selected once per process from GuliGetCpuFeatures)
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    const char* name;
+    void (*rgb_to_rgba)(const uint8_t* src, uint8_t* dst, int n);   /* a = 255 */
+    void (*rgb_to_bgra)(const uint8_t* src, uint8_t* dst, int n);
+    void (*swap_rb)(const uint8_t* src, uint8_t* dst, int n);       /* RGBA <-> BGRA; src may equal dst */
+    void (*premultiply)(uint8_t* px, int n);                        /* alpha in byte 3 */
+    void (*float_to_half)(const float* src, uint16_t* dst, size_t n);
+    void (*half_to_float)(const uint16_t* src, float* dst, size_t n);
+} PixelKernels;
+
+static uint8_t g_srgb_decode8[256];
+static uint8_t g_srgb_encode8[256];
+static float g_srgb_decode_f[256];
+static float g_unorm_f[256];
+
+/* ---- Scalar ---- */
+
+static inline uint8_t MulDiv255(unsigned int c, unsigned int a)
+{
+    const unsigned int p = c * a + 128;
+    return (uint8_t)((p + (p >> 8)) >> 8);
+}
+
+static void ScalarRgbToRgba(const uint8_t* src, uint8_t* dst, int n)
+{
+    for (int i = 0; i < n; i++, src += 3, dst += 4)
+    {
+        dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255;
+    }
+}
+
+static void ScalarRgbToBgra(const uint8_t* src, uint8_t* dst, int n)
+{
+    for (int i = 0; i < n; i++, src += 3, dst += 4)
+    {
+        dst[0] = src[2]; dst[1] = src[1]; dst[2] = src[0]; dst[3] = 255;
+    }
+}
+
+static void ScalarSwapRB(const uint8_t* src, uint8_t* dst, int n)
+{
+    for (int i = 0; i < n; i++, src += 4, dst += 4)
+    {
+        const uint8_t r = src[0], g = src[1], b = src[2], a = src[3];
+        dst[0] = b; dst[1] = g; dst[2] = r; dst[3] = a;
+    }
+}
+
+static void ScalarPremultiply(uint8_t* px, int n)
+{
+    for (int i = 0; i < n; i++, px += 4)
+    {
+        const unsigned int a = px[3];
+        px[0] = MulDiv255(px[0], a);
+        px[1] = MulDiv255(px[1], a);
+        px[2] = MulDiv255(px[2], a);
+    }
+}
+
+static uint16_t FloatToHalf(float f)
+{
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    const uint16_t sign = (uint16_t)((x >> 16) & 0x8000u);
+    uint32_t mant = x & 0x7fffffu;
+    const int exp = (int)((x >> 23) & 0xff);
+
+    if (exp == 255) return (uint16_t)(sign | 0x7c00u | (mant ? 0x200u : 0u));
+    const int e = exp - 127 + 15;
+    if (e >= 31) return (uint16_t)(sign | 0x7c00u);
+    if (e <= 0)
+    {
+        if (e < -10) return sign;
+        mant |= 0x800000u;
+        const int shift = 14 - e;
+        uint32_t h = mant >> shift;
+        const uint32_t rem = mant & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rem > halfway || (rem == halfway && (h & 1u))) h++;
+        return (uint16_t)(sign | h);
+    }
+    uint32_t h = ((uint32_t)e << 10) | (mant >> 13);
+    const uint32_t rem = mant & 0x1fffu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) h++;  /* carry may round up into the exponent */
+    return (uint16_t)(sign | h);
+}
+
+static float HalfToFloat(uint16_t h)
+{
+    const uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1fu;
+    uint32_t mant = h & 0x3ffu;
+    uint32_t x;
+
+    if (exp == 0)
+    {
+        if (!mant)
+        {
+            x = sign;
+        }
+        else
+        {
+            exp = 127 - 15 + 1;
+            while (!(mant & 0x400u)) { mant <<= 1; exp--; }
+            x = sign | (exp << 23) | ((mant & 0x3ffu) << 13);
+        }
+    }
+    else if (exp == 31)
+    {
+        x = sign | 0x7f800000u | (mant << 13);
+    }
+    else
+    {
+        x = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+    }
+
+    float f;
+    memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+static void ScalarFloatToHalf(const float* src, uint16_t* dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = FloatToHalf(src[i]);
+}
+
+static void ScalarHalfToFloat(const uint16_t* src, float* dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++) dst[i] = HalfToFloat(src[i]);
+}
+
+static const PixelKernels g_scalar_kernels = {
+    "scalar", ScalarRgbToRgba, ScalarRgbToBgra, ScalarSwapRB, ScalarPremultiply,
+    ScalarFloatToHalf, ScalarHalfToFloat,
+};
+
+/* ---- SSE4.1 (+SSSE3 shuffles) ---- */
+
+#if GULI_PIXEL_X86
+#define GULI_TARGET_SSE4 __attribute__((target("ssse3,sse4.1")))
+#define GULI_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+
+GULI_TARGET_SSE4 static void Sse4Expand(const uint8_t* src, uint8_t* dst, int n, __m128i mask,
+    void (*tail)(const uint8_t*, uint8_t*, int))
+{
+    const __m128i alpha = _mm_set1_epi32((int)0xff000000u);
+    int i = 0;
+    for (; i + 16 <= n; i += 16, src += 48, dst += 64)
+    {
+        const __m128i in0 = _mm_loadu_si128((const __m128i*)(src + 0));
+        const __m128i in1 = _mm_loadu_si128((const __m128i*)(src + 16));
+        const __m128i in2 = _mm_loadu_si128((const __m128i*)(src + 32));
+        const __m128i o0 = _mm_shuffle_epi8(in0, mask);
+        const __m128i o1 = _mm_shuffle_epi8(_mm_alignr_epi8(in1, in0, 12), mask);
+        const __m128i o2 = _mm_shuffle_epi8(_mm_alignr_epi8(in2, in1, 8), mask);
+        const __m128i o3 = _mm_shuffle_epi8(_mm_srli_si128(in2, 4), mask);
+        _mm_storeu_si128((__m128i*)(dst + 0), _mm_or_si128(o0, alpha));
+        _mm_storeu_si128((__m128i*)(dst + 16), _mm_or_si128(o1, alpha));
+        _mm_storeu_si128((__m128i*)(dst + 32), _mm_or_si128(o2, alpha));
+        _mm_storeu_si128((__m128i*)(dst + 48), _mm_or_si128(o3, alpha));
+    }
+    tail(src, dst, n - i);
+}
+
+GULI_TARGET_SSE4 static void Sse4RgbToRgba(const uint8_t* src, uint8_t* dst, int n)
+{
+    Sse4Expand(src, dst, n, _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1), ScalarRgbToRgba);
+}
+
+GULI_TARGET_SSE4 static void Sse4RgbToBgra(const uint8_t* src, uint8_t* dst, int n)
+{
+    Sse4Expand(src, dst, n, _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1), ScalarRgbToBgra);
+}
+
+GULI_TARGET_SSE4 static void Sse4SwapRB(const uint8_t* src, uint8_t* dst, int n)
+{
+    const __m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    int i = 0;
+    for (; i + 4 <= n; i += 4, src += 16, dst += 16)
+        _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), mask));
+    ScalarSwapRB(src, dst, n - i);
+}
+
+/* round(c * a / 255) on 8 u16 lanes */
+GULI_TARGET_SSE4 static inline __m128i Sse4MulDiv255(__m128i c, __m128i a)
+{
+    const __m128i p = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(p, _mm_srli_epi16(p, 8)), 8);
+}
+
+GULI_TARGET_SSE4 static void Sse4Premultiply(uint8_t* px, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i aLo = _mm_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+    const __m128i aHi = _mm_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1);
+    const __m128i keepAlpha = _mm_set1_epi32((int)0xff000000u);
+    int i = 0;
+    for (; i + 4 <= n; i += 4, px += 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)px);
+        const __m128i lo = Sse4MulDiv255(_mm_unpacklo_epi8(v, zero), _mm_shuffle_epi8(v, aLo));
+        const __m128i hi = Sse4MulDiv255(_mm_unpackhi_epi8(v, zero), _mm_shuffle_epi8(v, aHi));
+        _mm_storeu_si128((__m128i*)px, _mm_blendv_epi8(_mm_packus_epi16(lo, hi), v, keepAlpha));
+    }
+    ScalarPremultiply(px, n - i);
+}
+
+static const PixelKernels g_sse4_kernels = {
+    "sse4", Sse4RgbToRgba, Sse4RgbToBgra, Sse4SwapRB, Sse4Premultiply,
+    ScalarFloatToHalf, ScalarHalfToFloat,
+};
+
+/* ---- AVX2 + F16C ---- */
+
+GULI_TARGET_AVX2 static void Avx2Expand(const uint8_t* src, uint8_t* dst, int n, __m256i mask,
+    void (*tail)(const uint8_t*, uint8_t*, int))
+{
+    const __m256i alpha = _mm256_set1_epi32((int)0xff000000u);
+    int i = 0;
+    /* Each step reads 28 bytes for 8 pixels (24 used); keep 2 pixels of slack to stay in bounds. */
+    for (; i + 10 <= n; i += 8, src += 24, dst += 32)
+    {
+        const __m128i lo = _mm_loadu_si128((const __m128i*)src);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)(src + 12));
+        const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_or_si256(_mm256_shuffle_epi8(in, mask), alpha));
+    }
+    tail(src, dst, n - i);
+}
+
+GULI_TARGET_AVX2 static void Avx2RgbToRgba(const uint8_t* src, uint8_t* dst, int n)
+{
+    const __m256i mask = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                          0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    Avx2Expand(src, dst, n, mask, ScalarRgbToRgba);
+}
+
+GULI_TARGET_AVX2 static void Avx2RgbToBgra(const uint8_t* src, uint8_t* dst, int n)
+{
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+                                          2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    Avx2Expand(src, dst, n, mask, ScalarRgbToBgra);
+}
+
+GULI_TARGET_AVX2 static void Avx2SwapRB(const uint8_t* src, uint8_t* dst, int n)
+{
+    const __m256i mask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                          2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    int i = 0;
+    for (; i + 8 <= n; i += 8, src += 32, dst += 32)
+        _mm256_storeu_si256((__m256i*)dst, _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)src), mask));
+    ScalarSwapRB(src, dst, n - i);
+}
+
+GULI_TARGET_AVX2 static inline __m256i Avx2MulDiv255(__m256i c, __m256i a)
+{
+    const __m256i p = _mm256_add_epi16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(p, _mm256_srli_epi16(p, 8)), 8);
+}
+
+GULI_TARGET_AVX2 static void Avx2Premultiply(uint8_t* px, int n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i aLo = _mm256_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1,
+                                         3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+    const __m256i aHi = _mm256_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1,
+                                         11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1);
+    const __m256i keepAlpha = _mm256_set1_epi32((int)0xff000000u);
+    int i = 0;
+    for (; i + 8 <= n; i += 8, px += 32)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)px);
+        const __m256i lo = Avx2MulDiv255(_mm256_unpacklo_epi8(v, zero), _mm256_shuffle_epi8(v, aLo));
+        const __m256i hi = Avx2MulDiv255(_mm256_unpackhi_epi8(v, zero), _mm256_shuffle_epi8(v, aHi));
+        _mm256_storeu_si256((__m256i*)px, _mm256_blendv_epi8(_mm256_packus_epi16(lo, hi), v, keepAlpha));
+    }
+    ScalarPremultiply(px, n - i);
+}
+
+GULI_TARGET_AVX2 static void Avx2FloatToHalf(const float* src, uint16_t* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+    ScalarFloatToHalf(src + i, dst + i, n - i);
+}
+
+GULI_TARGET_AVX2 static void Avx2HalfToFloat(const uint16_t* src, float* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+    ScalarHalfToFloat(src + i, dst + i, n - i);
+}
+
+static const PixelKernels g_avx2_kernels = {
+    "avx2", Avx2RgbToRgba, Avx2RgbToBgra, Avx2SwapRB, Avx2Premultiply,
+    Avx2FloatToHalf, Avx2HalfToFloat,
+};
+#endif /* GULI_PIXEL_X86 */
+
+/* ---- NEON ---- */
+
+#if GULI_PIXEL_NEON
+static void NeonRgbToRgba(const uint8_t* src, uint8_t* dst, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16, src += 48, dst += 64)
+    {
+        const uint8x16x3_t in = vld3q_u8(src);
+        uint8x16x4_t out;
+        out.val[0] = in.val[0]; out.val[1] = in.val[1]; out.val[2] = in.val[2];
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst, out);
+    }
+    ScalarRgbToRgba(src, dst, n - i);
+}
+
+static void NeonRgbToBgra(const uint8_t* src, uint8_t* dst, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16, src += 48, dst += 64)
+    {
+        const uint8x16x3_t in = vld3q_u8(src);
+        uint8x16x4_t out;
+        out.val[0] = in.val[2]; out.val[1] = in.val[1]; out.val[2] = in.val[0];
+        out.val[3] = vdupq_n_u8(255);
+        vst4q_u8(dst, out);
+    }
+    ScalarRgbToBgra(src, dst, n - i);
+}
+
+static void NeonSwapRB(const uint8_t* src, uint8_t* dst, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16, src += 64, dst += 64)
+    {
+        uint8x16x4_t v = vld4q_u8(src);
+        const uint8x16_t r = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = r;
+        vst4q_u8(dst, v);
+    }
+    ScalarSwapRB(src, dst, n - i);
+}
+
+/* round(c * a / 255) */
+static inline uint8x8_t NeonMulDiv255(uint8x8_t c, uint8x8_t a)
+{
+    const uint16x8_t p = vmull_u8(c, a);
+    return vraddhn_u16(p, vrshrq_n_u16(p, 8));
+}
+
+static void NeonPremultiply(uint8_t* px, int n)
+{
+    int i = 0;
+    for (; i + 16 <= n; i += 16, px += 64)
+    {
+        uint8x16x4_t v = vld4q_u8(px);
+        const uint8x16_t a = v.val[3];
+        for (int c = 0; c < 3; c++)
+        {
+            v.val[c] = vcombine_u8(NeonMulDiv255(vget_low_u8(v.val[c]), vget_low_u8(a)),
+                                   NeonMulDiv255(vget_high_u8(v.val[c]), vget_high_u8(a)));
+        }
+        vst4q_u8(px, v);
+    }
+    ScalarPremultiply(px, n - i);
+}
+
+static void NeonFloatToHalf(const float* src, uint16_t* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    ScalarFloatToHalf(src + i, dst + i, n - i);
+}
+
+static void NeonHalfToFloat(const uint16_t* src, float* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    ScalarHalfToFloat(src + i, dst + i, n - i);
+}
+
+static const PixelKernels g_neon_kernels = {
+    "neon", NeonRgbToRgba, NeonRgbToBgra, NeonSwapRB, NeonPremultiply,
+    NeonFloatToHalf, NeonHalfToFloat,
+};
+#endif /* GULI_PIXEL_NEON */
+
+/* ---- Dispatch ---- */
+
+static float SrgbDecode(float c)
+{
+    return (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float SrgbEncode(float c)
+{
+    if (c <= 0.0f) return 0.0f;
+    if (c >= 1.0f) return 1.0f;
+    return (c <= 0.0031308f) ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+}
+
+static _Atomic(const PixelKernels*) g_pixel_kernels;
+
+static const PixelKernels* PixelGetKernels(void)
+{
+    const PixelKernels* k = atomic_load_explicit(&g_pixel_kernels, memory_order_acquire);
+    if (k) return k;
+
+    for (int i = 0; i < 256; i++)
+    {
+        const float c = (float)i / 255.0f;
+        g_unorm_f[i] = c;
+        g_srgb_decode_f[i] = SrgbDecode(c);
+        g_srgb_decode8[i] = (uint8_t)lrintf(g_srgb_decode_f[i] * 255.0f);
+        g_srgb_encode8[i] = (uint8_t)lrintf(SrgbEncode(c) * 255.0f);
+    }
+
+    k = &g_scalar_kernels;
+#if GULI_PIXEL_X86
+    const GuliCpuFeatures* cpu = GuliGetCpuFeatures();
+    if (cpu->avx2 && cpu->f16c) k = &g_avx2_kernels;
+    else if (cpu->ssse3 && cpu->sse41) k = &g_sse4_kernels;
+#elif GULI_PIXEL_NEON
+    k = &g_neon_kernels;
+#endif
+
+    atomic_store_explicit(&g_pixel_kernels, k, memory_order_release);
+    return k;
+}
+
+const char* GuliPixelGetKernelName(void)
+{
+    return PixelGetKernels()->name;
+}
+
+size_t GuliPixelFormatSize(GuliPixelFormat format)
+{
+    switch (format)
+    {
+        case GULI_PIXEL_GRAY8:   return 1;
+        case GULI_PIXEL_GRAYA8:  return 2;
+        case GULI_PIXEL_RGB8:    return 3;
+        case GULI_PIXEL_RGBA8:   return 4;
+        case GULI_PIXEL_BGRA8:   return 4;
+        case GULI_PIXEL_RGBA16F: return 8;
+    }
+    return 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * Row pipeline: expand/swizzle -> sRGB decode -> premultiply -> sRGB encode -> store,
+ * all on one row while it is hot in L1.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    const PixelKernels* k;
+    GuliPixelFormat sf;
+    GuliPixelFormat df;
+    unsigned int flags;
+    int width;
+    uint8_t* row8;   /* RGBA8 staging (8-bit -> 16F) */
+    float* rowf;     /* RGBA float staging (any 16F path) */
+} PixelJob;
+
+/* 8-bit source -> 4-byte destination in RGBA or BGRA order. */
+static void PixelExpand8(const PixelJob* j, const uint8_t* s, uint8_t* d, int bgra)
+{
+    const int n = j->width;
+    switch (j->sf)
+    {
+        case GULI_PIXEL_GRAY8:
+            for (int i = 0; i < n; i++, d += 4) { d[0] = d[1] = d[2] = s[i]; d[3] = 255; }
+            break;
+        case GULI_PIXEL_GRAYA8:
+            for (int i = 0; i < n; i++, d += 4, s += 2) { d[0] = d[1] = d[2] = s[0]; d[3] = s[1]; }
+            break;
+        case GULI_PIXEL_RGB8:
+            if (bgra) j->k->rgb_to_bgra(s, d, n);
+            else j->k->rgb_to_rgba(s, d, n);
+            break;
+        case GULI_PIXEL_RGBA8:
+        case GULI_PIXEL_BGRA8:
+            if ((j->sf == GULI_PIXEL_BGRA8) != (bgra != 0)) j->k->swap_rb(s, d, n);
+            else if (s != d) memcpy(d, s, (size_t)n * 4);
+            break;
+        case GULI_PIXEL_RGBA16F:
+            break;
+    }
+}
+
+static void PixelColorLut8(uint8_t* px, int n, const uint8_t* lut)
+{
+    for (int i = 0; i < n; i++, px += 4)
+    {
+        px[0] = lut[px[0]]; px[1] = lut[px[1]]; px[2] = lut[px[2]];
+    }
+}
+
+static void PixelFloatOps(float* px, int n, unsigned int flags)
+{
+    if (flags & GULI_PIXEL_PREMULTIPLY)
+    {
+        for (int i = 0; i < n; i++, px += 4)
+        {
+            px[0] *= px[3]; px[1] *= px[3]; px[2] *= px[3];
+        }
+        px -= (size_t)n * 4;
+    }
+    if (flags & GULI_PIXEL_LINEAR_TO_SRGB)
+    {
+        for (int i = 0; i < n; i++, px += 4)
+        {
+            px[0] = SrgbEncode(px[0]); px[1] = SrgbEncode(px[1]); px[2] = SrgbEncode(px[2]);
+        }
+    }
+}
+
+static void PixelConvertRow(const PixelJob* j, const uint8_t* s, uint8_t* d)
+{
+    const int n = j->width;
+    const unsigned int flags = j->flags;
+
+    if (j->sf != GULI_PIXEL_RGBA16F && j->df != GULI_PIXEL_RGBA16F)
+    {
+        /* 8-bit -> 8-bit: everything happens in the destination row. */
+        PixelExpand8(j, s, d, j->df == GULI_PIXEL_BGRA8);
+        if (flags & GULI_PIXEL_SRGB_TO_LINEAR) PixelColorLut8(d, n, g_srgb_decode8);
+        if (flags & GULI_PIXEL_PREMULTIPLY) j->k->premultiply(d, n);
+        if (flags & GULI_PIXEL_LINEAR_TO_SRGB) PixelColorLut8(d, n, g_srgb_encode8);
+        return;
+    }
+
+    float* f = j->rowf;
+    if (j->sf == GULI_PIXEL_RGBA16F)
+    {
+        j->k->half_to_float((const uint16_t*)s, f, (size_t)n * 4);
+        if (flags & GULI_PIXEL_SRGB_TO_LINEAR)
+        {
+            for (int i = 0; i < n * 4; i++)
+                if ((i & 3) != 3) f[i] = SrgbDecode(f[i]);
+        }
+    }
+    else
+    {
+        PixelExpand8(j, s, j->row8, 0);
+        const float* lut = (flags & GULI_PIXEL_SRGB_TO_LINEAR) ? g_srgb_decode_f : g_unorm_f;
+        const uint8_t* p = j->row8;
+        for (int i = 0; i < n; i++, p += 4)
+        {
+            f[i * 4 + 0] = lut[p[0]];
+            f[i * 4 + 1] = lut[p[1]];
+            f[i * 4 + 2] = lut[p[2]];
+            f[i * 4 + 3] = g_unorm_f[p[3]];
+        }
+    }
+
+    PixelFloatOps(f, n, flags);
+
+    if (j->df == GULI_PIXEL_RGBA16F)
+    {
+        j->k->float_to_half(f, (uint16_t*)d, (size_t)n * 4);
+        return;
+    }
+
+    const int bgra = (j->df == GULI_PIXEL_BGRA8);
+    for (int i = 0; i < n; i++, d += 4, f += 4)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            float v = f[c];
+            v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            const int dc = (bgra && c != 3) ? 2 - c : c;
+            d[dc] = (uint8_t)(v * 255.0f + 0.5f);
+        }
+    }
+}
+
+int GuliPixelConvert(const void* src, GuliPixelFormat srcFormat, size_t srcStride,
+    void* dst, GuliPixelFormat dstFormat, size_t dstStride,
+    int width, int height, unsigned int flags)
+{
+    const size_t sbpp = GuliPixelFormatSize(srcFormat);
+    const size_t dbpp = GuliPixelFormatSize(dstFormat);
+    if (!src || !dst || width <= 0 || height <= 0 || !sbpp || !dbpp) return 0;
+    if (dstFormat != GULI_PIXEL_RGBA8 && dstFormat != GULI_PIXEL_BGRA8 && dstFormat != GULI_PIXEL_RGBA16F) return 0;
+
+    if (!srcStride) srcStride = (size_t)width * sbpp;
+    if (!dstStride) dstStride = (size_t)width * dbpp;
+    const int inPlace = (src == dst);
+    if (inPlace && (sbpp != dbpp || srcStride != dstStride)) return 0;
+
+    PixelJob j;
+    j.k = PixelGetKernels();
+    j.sf = srcFormat;
+    j.df = dstFormat;
+    j.flags = flags;
+    j.width = width;
+    j.row8 = NULL;
+    j.rowf = NULL;
+
+    const int floatPath = (srcFormat == GULI_PIXEL_RGBA16F || dstFormat == GULI_PIXEL_RGBA16F);
+    const int flipInPlace = inPlace && (flags & GULI_PIXEL_FLIP_Y);
+    const size_t rowf = floatPath ? (size_t)width * 4 * sizeof(float) : 0;
+    const size_t row8 = floatPath ? (size_t)width * 4 : 0;
+    const size_t rowTmp = flipInPlace ? dstStride : 0;
+
+    unsigned char* scratch = NULL;
+    if (rowf + row8 + rowTmp)
+    {
+        scratch = (unsigned char*)GuliMalloc(rowf + row8 + rowTmp);
+        if (!scratch) return 0;
+        j.rowf = floatPath ? (float*)scratch : NULL;
+        j.row8 = floatPath ? scratch + rowf : NULL;
+    }
+
+    const uint8_t* s = (const uint8_t*)src;
+    uint8_t* d = (uint8_t*)dst;
+
+    if (flipInPlace)
+    {
+        /* Convert the top row aside, convert the bottom row into the top, then store the top row below. */
+        uint8_t* tmp = scratch + rowf + row8;
+        for (int y = 0; y < height / 2; y++)
+        {
+            const int yb = height - 1 - y;
+            PixelConvertRow(&j, s + (size_t)y * srcStride, tmp);
+            PixelConvertRow(&j, s + (size_t)yb * srcStride, d + (size_t)y * dstStride);
+            memcpy(d + (size_t)yb * dstStride, tmp, (size_t)width * dbpp);
+        }
+        if (height & 1)
+        {
+            const size_t mid = (size_t)(height / 2);
+            PixelConvertRow(&j, s + mid * srcStride, d + mid * dstStride);
+        }
+    }
+    else
+    {
+        for (int y = 0; y < height; y++)
+        {
+            const int sy = (flags & GULI_PIXEL_FLIP_Y) ? height - 1 - y : y;
+            PixelConvertRow(&j, s + (size_t)sy * srcStride, d + (size_t)y * dstStride);
+        }
+    }
+
+    GuliFree(scratch);
+    return 1;
+}
@@ -0,0 +1,235 @@
+#include "Core/guli_pool.h"
+#include "Core/guli_memory.h"
+#include "Core/guli_thread.h"
+#include "Core/guli_error.h"
+
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Generational object pools
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_POOL_ALIVE (GULI_HANDLE_GEN_MASK + 1u)  /* slot state: generation | ALIVE */
+#define GULI_POOL_FREE (GULI_POOL_ALIVE << 1)         /* released slot already on the free list */
+
+struct GuliPoolPage {
+    unsigned char* hot;                         /* GULI_POOL_PAGE_SLOTS * hot_size */
+    unsigned char* cold;                        /* GULI_POOL_PAGE_SLOTS * cold_size, or NULL */
+    atomic_uint state[GULI_POOL_PAGE_SLOTS];
+    uint32_t next_free[GULI_POOL_PAGE_SLOTS];   /* free-list link: slot index + 1 */
+};
+
+static void GuliPoolLock(GuliPool* pool)
+{
+    int expected = 0;
+    while (!atomic_compare_exchange_weak_explicit(&pool->lock, &expected, 1, memory_order_acquire, memory_order_relaxed))
+    {
+        expected = 0;
+        GuliThreadPause();
+    }
+}
+
+static void GuliPoolUnlock(GuliPool* pool)
+{
+    atomic_store_explicit(&pool->lock, 0, memory_order_release);
+}
+
+static uint32_t GuliHandleIndex(GuliHandle handle)
+{
+    return handle & GULI_HANDLE_INDEX_MASK;
+}
+
+static uint32_t GuliHandleGen(GuliHandle handle)
+{
+    return (handle >> GULI_HANDLE_INDEX_BITS) & GULI_HANDLE_GEN_MASK;
+}
+
+/* Generation a slot moves to when handle is released (0 is skipped) */
+static uint32_t GuliHandleNextGen(GuliHandle handle)
+{
+    const uint32_t gen = (GuliHandleGen(handle) + 1) & GULI_HANDLE_GEN_MASK;
+    return gen ? gen : 1;
+}
+
+static struct GuliPoolPage* GuliPoolPageOf(const GuliPool* pool, uint32_t index)
+{
+    return atomic_load_explicit(&((GuliPool*)pool)->pages[index >> GULI_POOL_PAGE_SHIFT], memory_order_acquire);
+}
+
+static struct GuliPoolPage* GuliPoolAddPage(GuliPool* pool)
+{
+    struct GuliPoolPage* page = GuliCalloc(1, sizeof(struct GuliPoolPage));
+    if (!page) return NULL;
+    page->hot = GuliMallocAligned(GULI_POOL_PAGE_SLOTS * pool->hot_size, 64);
+    page->cold = pool->cold_size ? GuliMallocAligned(GULI_POOL_PAGE_SLOTS * pool->cold_size, 64) : NULL;
+    if (!page->hot || (pool->cold_size && !page->cold))
+    {
+        GuliFreeAligned(page->hot);
+        GuliFreeAligned(page->cold);
+        GuliFree(page);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < GULI_POOL_PAGE_SLOTS; i++)
+        atomic_init(&page->state[i], 1u);  /* generation 1, not alive */
+    return page;
+}
+
+void* GuliPoolAlloc(GuliPool* pool, GuliHandle* handle)
+{
+    if (handle) *handle = GULI_HANDLE_NULL;
+    if (!pool || !pool->hot_size) return NULL;
+
+    GuliPoolLock(pool);
+    uint32_t index;
+    struct GuliPoolPage* page;
+    if (pool->free_head)
+    {
+        index = pool->free_head - 1;
+        page = GuliPoolPageOf(pool, index);
+        pool->free_head = page->next_free[index & (GULI_POOL_PAGE_SLOTS - 1)];
+    }
+    else
+    {
+        index = atomic_load_explicit(&pool->high_water, memory_order_relaxed);
+        if (index > GULI_HANDLE_INDEX_MASK)
+        {
+            GuliPoolUnlock(pool);
+            GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Object pool is full");
+            return NULL;
+        }
+        page = GuliPoolPageOf(pool, index);
+        if (!page)
+        {
+            page = GuliPoolAddPage(pool);
+            if (!page)
+            {
+                GuliPoolUnlock(pool);
+                GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate object pool page");
+                return NULL;
+            }
+            atomic_store_explicit(&pool->pages[index >> GULI_POOL_PAGE_SHIFT], page, memory_order_release);
+        }
+        atomic_store_explicit(&pool->high_water, index + 1, memory_order_release);
+    }
+
+    const uint32_t slot = index & (GULI_POOL_PAGE_SLOTS - 1);
+    void* hot = page->hot + (size_t)slot * pool->hot_size;
+    memset(hot, 0, pool->hot_size);
+    if (page->cold) memset(page->cold + (size_t)slot * pool->cold_size, 0, pool->cold_size);
+
+    const uint32_t gen = atomic_load_explicit(&page->state[slot], memory_order_relaxed) & GULI_HANDLE_GEN_MASK;
+    atomic_store_explicit(&page->state[slot], gen | GULI_POOL_ALIVE, memory_order_release);
+    atomic_fetch_add_explicit(&pool->live, 1, memory_order_relaxed);
+    GuliPoolUnlock(pool);
+
+    if (handle) *handle = (gen << GULI_HANDLE_INDEX_BITS) | index;
+    return hot;
+}
+
+void* GuliPoolGet(const GuliPool* pool, GuliHandle handle)
+{
+    if (!pool || handle == GULI_HANDLE_NULL) return NULL;
+    const uint32_t index = GuliHandleIndex(handle);
+    if (index >= atomic_load_explicit(&((GuliPool*)pool)->high_water, memory_order_acquire)) return NULL;
+
+    struct GuliPoolPage* page = GuliPoolPageOf(pool, index);
+    const uint32_t slot = index & (GULI_POOL_PAGE_SLOTS - 1);
+    if (atomic_load_explicit(&page->state[slot], memory_order_acquire) != (GuliHandleGen(handle) | GULI_POOL_ALIVE))
+        return NULL;
+    return page->hot + (size_t)slot * pool->hot_size;
+}
+
+void* GuliPoolGetCold(const GuliPool* pool, GuliHandle handle)
+{
+    if (!pool || !pool->cold_size || !GuliPoolGet(pool, handle)) return NULL;
+    const uint32_t index = GuliHandleIndex(handle);
+    return GuliPoolPageOf(pool, index)->cold + (size_t)(index & (GULI_POOL_PAGE_SLOTS - 1)) * pool->cold_size;
+}
+
+void GuliPoolRelease(GuliPool* pool, GuliHandle handle)
+{
+    if (!GuliPoolGet(pool, handle)) return;
+    const uint32_t index = GuliHandleIndex(handle);
+    struct GuliPoolPage* page = GuliPoolPageOf(pool, index);
+
+    uint32_t expected = GuliHandleGen(handle) | GULI_POOL_ALIVE;
+    atomic_compare_exchange_strong_explicit(&page->state[index & (GULI_POOL_PAGE_SLOTS - 1)], &expected,
+        GuliHandleNextGen(handle), memory_order_acq_rel, memory_order_relaxed);
+}
+
+void GuliPoolRecycle(GuliPool* pool, GuliHandle handle)
+{
+    if (!pool || handle == GULI_HANDLE_NULL) return;
+    const uint32_t index = GuliHandleIndex(handle);
+    if (index >= atomic_load_explicit(&pool->high_water, memory_order_acquire)) return;
+
+    GuliPoolLock(pool);
+    struct GuliPoolPage* page = GuliPoolPageOf(pool, index);
+    const uint32_t slot = index & (GULI_POOL_PAGE_SLOTS - 1);
+    /* Only a slot released from this handle and not yet recycled: a second recycle would link it to itself */
+    if (atomic_load_explicit(&page->state[slot], memory_order_relaxed) != GuliHandleNextGen(handle))
+    {
+        GuliPoolUnlock(pool);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliPoolRecycle: slot not released by this handle or already recycled");
+        return;
+    }
+    atomic_store_explicit(&page->state[slot], GuliHandleNextGen(handle) | GULI_POOL_FREE, memory_order_relaxed);
+    page->next_free[slot] = pool->free_head;
+    pool->free_head = index + 1;
+    atomic_fetch_sub_explicit(&pool->live, 1, memory_order_relaxed);
+    GuliPoolUnlock(pool);
+}
+
+void GuliPoolFree(GuliPool* pool, GuliHandle handle)
+{
+    if (!GuliPoolGet(pool, handle)) return;
+    GuliPoolRelease(pool, handle);
+    GuliPoolRecycle(pool, handle);
+}
+
+void GuliPoolForEach(GuliPool* pool, GuliPoolVisitFunc func, void* user)
+{
+    if (!pool || !func) return;
+    const uint32_t count = atomic_load_explicit(&pool->high_water, memory_order_acquire);
+    for (uint32_t base = 0; base < count; base += GULI_POOL_PAGE_SLOTS)
+    {
+        struct GuliPoolPage* page = GuliPoolPageOf(pool, base);
+        const uint32_t end = (count - base < GULI_POOL_PAGE_SLOTS) ? count - base : GULI_POOL_PAGE_SLOTS;
+        for (uint32_t slot = 0; slot < end; slot++)
+        {
+            const uint32_t state = atomic_load_explicit(&page->state[slot], memory_order_acquire);
+            if (!(state & GULI_POOL_ALIVE)) continue;
+            func(user, ((state & GULI_HANDLE_GEN_MASK) << GULI_HANDLE_INDEX_BITS) | (base + slot),
+                page->hot + (size_t)slot * pool->hot_size);
+        }
+    }
+}
+
+uint32_t GuliPoolGetCount(const GuliPool* pool)
+{
+    return pool ? atomic_load_explicit(&((GuliPool*)pool)->live, memory_order_relaxed) : 0;
+}
+
+int GuliPoolDestroy(GuliPool* pool)
+{
+    if (!pool) return 1;
+    GuliPoolLock(pool);
+    if (atomic_load_explicit(&pool->live, memory_order_relaxed))
+    {
+        GuliPoolUnlock(pool);
+        return 0;
+    }
+    for (uint32_t i = 0; i < GULI_POOL_MAX_PAGES; i++)
+    {
+        struct GuliPoolPage* page = atomic_load_explicit(&pool->pages[i], memory_order_relaxed);
+        if (!page) break;
+        GuliFreeAligned(page->hot);
+        GuliFreeAligned(page->cold);
+        GuliFree(page);
+        atomic_store_explicit(&pool->pages[i], NULL, memory_order_relaxed);
+    }
+    atomic_store_explicit(&pool->high_water, 0, memory_order_relaxed);
+    pool->free_head = 0;
+    GuliPoolUnlock(pool);
+    return 1;
+}
@@ -0,0 +1,514 @@
+#include "Core/guli_transform.h"
+#include "Core/guli_cpu.h"
+#include "Core/guli_job.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GULI_TRANSFORM_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define GULI_TRANSFORM_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* -----------------------------------------------------------------------------
+ * Kernel table (selected once per process from GuliGetCpuFeatures). SoA kernels
+ * run one object per lane; matrix products vectorize over columns.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    const char* name;
+    void (*points)(const float* m, const float* const in[3], float* const out[3], size_t n);
+    void (*aabbs)(const float* m, const float* const in[6], float* const out[6], size_t n);  /* min xyz, max xyz */
+    void (*trs)(const float* const in[10], float* out, size_t n);   /* GuliTrsSoa order */
+    void (*mat4_mul)(const float* a, size_t a_step, const float* b, float* out, size_t n);  /* a_step 0: same a */
+} TransformKernels;
+
+#define GULI_TRANSFORM_GROUP_MAX 16  /* widest kernel: AVX-512 lanes */
+
+/* ---- Scalar (also the tails of the SIMD kernels) ---- */
+
+static void ScalarPoints(const float* m, const float* const in[3], float* const out[3], size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const float x = in[0][i], y = in[1][i], z = in[2][i];
+        out[0][i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+        out[1][i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+        out[2][i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+    }
+}
+
+/* Center/extent form: the center moves with m, the extent with |m| (Arvo) */
+static void ScalarAabbs(const float* m, const float* const in[6], float* const out[6], size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const float cx = (in[0][i] + in[3][i]) * 0.5f, ex = (in[3][i] - in[0][i]) * 0.5f;
+        const float cy = (in[1][i] + in[4][i]) * 0.5f, ey = (in[4][i] - in[1][i]) * 0.5f;
+        const float cz = (in[2][i] + in[5][i]) * 0.5f, ez = (in[5][i] - in[2][i]) * 0.5f;
+        for (int r = 0; r < 3; r++)
+        {
+            const float c = m[r] * cx + m[4 + r] * cy + m[8 + r] * cz + m[12 + r];
+            const float e = fabsf(m[r]) * ex + fabsf(m[4 + r]) * ey + fabsf(m[8 + r]) * ez;
+            out[r][i] = c - e;
+            out[3 + r][i] = c + e;
+        }
+    }
+}
+
+/* Upper 3x3 of count matrices from t (9 rows of stride floats, column-major order), translation from in */
+static void TrsScatter(const float* t, size_t stride, const float* const in[10], float* out, size_t count)
+{
+    for (size_t j = 0; j < count; j++, out += 16)
+    {
+        out[0] = t[0 * stride + j]; out[1] = t[1 * stride + j]; out[2] = t[2 * stride + j]; out[3] = 0.0f;
+        out[4] = t[3 * stride + j]; out[5] = t[4 * stride + j]; out[6] = t[5 * stride + j]; out[7] = 0.0f;
+        out[8] = t[6 * stride + j]; out[9] = t[7 * stride + j]; out[10] = t[8 * stride + j]; out[11] = 0.0f;
+        out[12] = in[0][j]; out[13] = in[1][j]; out[14] = in[2][j]; out[15] = 1.0f;
+    }
+}
+
+static void ScalarTrs(const float* const in[10], float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const float qx = in[3][i], qy = in[4][i], qz = in[5][i], qw = in[6][i];
+        const float sx = in[7][i], sy = in[8][i], sz = in[9][i];
+        const float x2 = qx + qx, y2 = qy + qy, z2 = qz + qz;
+        const float xx = qx * x2, yy = qy * y2, zz = qz * z2;
+        const float xy = qx * y2, xz = qx * z2, yz = qy * z2;
+        const float wx = qw * x2, wy = qw * y2, wz = qw * z2;
+        const float t[9] = {
+            (1.0f - (yy + zz)) * sx, (xy + wz) * sx, (xz - wy) * sx,
+            (xy - wz) * sy, (1.0f - (xx + zz)) * sy, (yz + wx) * sy,
+            (xz + wy) * sz, (yz - wx) * sz, (1.0f - (xx + yy)) * sz,
+        };
+        const float* const one[10] = { in[0] + i, in[1] + i, in[2] + i };
+        TrsScatter(t, 1, one, out + 16 * i, 1);
+    }
+}
+
+static void ScalarMat4Mul(const float* a, size_t a_step, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += a_step, b += 16, out += 16)
+    {
+        float r[16];
+        for (int c = 0; c < 4; c++)
+            for (int row = 0; row < 4; row++)
+                r[c * 4 + row] = a[row] * b[c * 4] + a[4 + row] * b[c * 4 + 1]
+                    + a[8 + row] * b[c * 4 + 2] + a[12 + row] * b[c * 4 + 3];
+        memcpy(out, r, sizeof(r));
+    }
+}
+
+static const TransformKernels g_scalar_kernels = {
+    "scalar", ScalarPoints, ScalarAabbs, ScalarTrs, ScalarMat4Mul,
+};
+
+/* ---- SoA kernels, written once over a vector type. Before expanding
+   TRANSFORM_SOA_KERNELS define XF_V (vector), XF_SET1, XF_LOAD, XF_STORE,
+   XF_ADD, XF_SUB, XF_MUL and XF_FMA(a, b, c) = a * b + c. ---- */
+
+#define TRANSFORM_SOA_KERNELS(PREFIX, TARGET, W)                                                    \
+TARGET static void PREFIX##Points(const float* m, const float* const in[3], float* const out[3], size_t n) \
+{                                                                                                   \
+    const XF_V m0 = XF_SET1(m[0]), m1 = XF_SET1(m[1]), m2 = XF_SET1(m[2]);                         \
+    const XF_V m4 = XF_SET1(m[4]), m5 = XF_SET1(m[5]), m6 = XF_SET1(m[6]);                         \
+    const XF_V m8 = XF_SET1(m[8]), m9 = XF_SET1(m[9]), m10 = XF_SET1(m[10]);                       \
+    const XF_V m12 = XF_SET1(m[12]), m13 = XF_SET1(m[13]), m14 = XF_SET1(m[14]);                   \
+    size_t i = 0;                                                                                   \
+    for (; i + (W) <= n; i += (W))                                                                  \
+    {                                                                                               \
+        const XF_V x = XF_LOAD(in[0] + i), y = XF_LOAD(in[1] + i), z = XF_LOAD(in[2] + i);         \
+        XF_STORE(out[0] + i, XF_FMA(m8, z, XF_FMA(m4, y, XF_FMA(m0, x, m12))));                    \
+        XF_STORE(out[1] + i, XF_FMA(m9, z, XF_FMA(m5, y, XF_FMA(m1, x, m13))));                    \
+        XF_STORE(out[2] + i, XF_FMA(m10, z, XF_FMA(m6, y, XF_FMA(m2, x, m14))));                   \
+    }                                                                                               \
+    const float* const tin[3] = { in[0] + i, in[1] + i, in[2] + i };                               \
+    float* const tout[3] = { out[0] + i, out[1] + i, out[2] + i };                                 \
+    ScalarPoints(m, tin, tout, n - i);                                                              \
+}                                                                                                   \
+                                                                                                    \
+TARGET static void PREFIX##Aabbs(const float* m, const float* const in[6], float* const out[6], size_t n) \
+{                                                                                                   \
+    const XF_V m0 = XF_SET1(m[0]), m1 = XF_SET1(m[1]), m2 = XF_SET1(m[2]);                         \
+    const XF_V m4 = XF_SET1(m[4]), m5 = XF_SET1(m[5]), m6 = XF_SET1(m[6]);                         \
+    const XF_V m8 = XF_SET1(m[8]), m9 = XF_SET1(m[9]), m10 = XF_SET1(m[10]);                       \
+    const XF_V m12 = XF_SET1(m[12]), m13 = XF_SET1(m[13]), m14 = XF_SET1(m[14]);                   \
+    const XF_V a0 = XF_SET1(fabsf(m[0])), a1 = XF_SET1(fabsf(m[1])), a2 = XF_SET1(fabsf(m[2]));    \
+    const XF_V a4 = XF_SET1(fabsf(m[4])), a5 = XF_SET1(fabsf(m[5])), a6 = XF_SET1(fabsf(m[6]));    \
+    const XF_V a8 = XF_SET1(fabsf(m[8])), a9 = XF_SET1(fabsf(m[9])), a10 = XF_SET1(fabsf(m[10]));  \
+    const XF_V half = XF_SET1(0.5f);                                                                \
+    size_t i = 0;                                                                                   \
+    for (; i + (W) <= n; i += (W))                                                                  \
+    {                                                                                               \
+        const XF_V nx = XF_LOAD(in[0] + i), ny = XF_LOAD(in[1] + i), nz = XF_LOAD(in[2] + i);      \
+        const XF_V px = XF_LOAD(in[3] + i), py = XF_LOAD(in[4] + i), pz = XF_LOAD(in[5] + i);      \
+        const XF_V cx = XF_MUL(XF_ADD(nx, px), half), ex = XF_MUL(XF_SUB(px, nx), half);           \
+        const XF_V cy = XF_MUL(XF_ADD(ny, py), half), ey = XF_MUL(XF_SUB(py, ny), half);           \
+        const XF_V cz = XF_MUL(XF_ADD(nz, pz), half), ez = XF_MUL(XF_SUB(pz, nz), half);           \
+        const XF_V ox = XF_FMA(m8, cz, XF_FMA(m4, cy, XF_FMA(m0, cx, m12)));                       \
+        const XF_V oy = XF_FMA(m9, cz, XF_FMA(m5, cy, XF_FMA(m1, cx, m13)));                       \
+        const XF_V oz = XF_FMA(m10, cz, XF_FMA(m6, cy, XF_FMA(m2, cx, m14)));                      \
+        const XF_V qx = XF_FMA(a8, ez, XF_FMA(a4, ey, XF_MUL(a0, ex)));                            \
+        const XF_V qy = XF_FMA(a9, ez, XF_FMA(a5, ey, XF_MUL(a1, ex)));                            \
+        const XF_V qz = XF_FMA(a10, ez, XF_FMA(a6, ey, XF_MUL(a2, ex)));                           \
+        XF_STORE(out[0] + i, XF_SUB(ox, qx));                                                       \
+        XF_STORE(out[1] + i, XF_SUB(oy, qy));                                                       \
+        XF_STORE(out[2] + i, XF_SUB(oz, qz));                                                       \
+        XF_STORE(out[3] + i, XF_ADD(ox, qx));                                                       \
+        XF_STORE(out[4] + i, XF_ADD(oy, qy));                                                       \
+        XF_STORE(out[5] + i, XF_ADD(oz, qz));                                                       \
+    }                                                                                               \
+    const float* const tin[6] = { in[0] + i, in[1] + i, in[2] + i, in[3] + i, in[4] + i, in[5] + i }; \
+    float* const tout[6] = { out[0] + i, out[1] + i, out[2] + i, out[3] + i, out[4] + i, out[5] + i }; \
+    ScalarAabbs(m, tin, tout, n - i);                                                               \
+}                                                                                                   \
+                                                                                                    \
+TARGET static void PREFIX##Trs(const float* const in[10], float* out, size_t n)                     \
+{                                                                                                   \
+    const XF_V one = XF_SET1(1.0f);                                                                 \
+    float t[9 * (W)];                                                                               \
+    size_t i = 0;                                                                                   \
+    for (; i + (W) <= n; i += (W))                                                                  \
+    {                                                                                               \
+        const XF_V qx = XF_LOAD(in[3] + i), qy = XF_LOAD(in[4] + i);                               \
+        const XF_V qz = XF_LOAD(in[5] + i), qw = XF_LOAD(in[6] + i);                               \
+        const XF_V sx = XF_LOAD(in[7] + i), sy = XF_LOAD(in[8] + i), sz = XF_LOAD(in[9] + i);      \
+        const XF_V x2 = XF_ADD(qx, qx), y2 = XF_ADD(qy, qy), z2 = XF_ADD(qz, qz);                  \
+        const XF_V xx = XF_MUL(qx, x2), yy = XF_MUL(qy, y2), zz = XF_MUL(qz, z2);                  \
+        const XF_V xy = XF_MUL(qx, y2), xz = XF_MUL(qx, z2), yz = XF_MUL(qy, z2);                  \
+        const XF_V wx = XF_MUL(qw, x2), wy = XF_MUL(qw, y2), wz = XF_MUL(qw, z2);                  \
+        XF_STORE(t + 0 * (W), XF_MUL(XF_SUB(one, XF_ADD(yy, zz)), sx));                            \
+        XF_STORE(t + 1 * (W), XF_MUL(XF_ADD(xy, wz), sx));                                          \
+        XF_STORE(t + 2 * (W), XF_MUL(XF_SUB(xz, wy), sx));                                          \
+        XF_STORE(t + 3 * (W), XF_MUL(XF_SUB(xy, wz), sy));                                          \
+        XF_STORE(t + 4 * (W), XF_MUL(XF_SUB(one, XF_ADD(xx, zz)), sy));                            \
+        XF_STORE(t + 5 * (W), XF_MUL(XF_ADD(yz, wx), sy));                                          \
+        XF_STORE(t + 6 * (W), XF_MUL(XF_ADD(xz, wy), sz));                                          \
+        XF_STORE(t + 7 * (W), XF_MUL(XF_SUB(yz, wx), sz));                                          \
+        XF_STORE(t + 8 * (W), XF_MUL(XF_SUB(one, XF_ADD(xx, yy)), sz));                            \
+        const float* const tin[10] = { in[0] + i, in[1] + i, in[2] + i };                          \
+        TrsScatter(t, (W), tin, out + 16 * i, (W));                                                 \
+    }                                                                                               \
+    const float* const tin[10] = { in[0] + i, in[1] + i, in[2] + i, in[3] + i, in[4] + i,           \
+        in[5] + i, in[6] + i, in[7] + i, in[8] + i, in[9] + i };                                    \
+    ScalarTrs(tin, out + 16 * i, n - i);                                                            \
+}
+
+/* ---- x86: SSE4.1, AVX2 + FMA, AVX-512F ---- */
+
+#if GULI_TRANSFORM_X86
+#define GULI_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define GULI_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define GULI_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+
+#define XF_V __m128
+#define XF_SET1 _mm_set1_ps
+#define XF_LOAD _mm_loadu_ps
+#define XF_STORE _mm_storeu_ps
+#define XF_ADD _mm_add_ps
+#define XF_SUB _mm_sub_ps
+#define XF_MUL _mm_mul_ps
+#define XF_FMA(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+TRANSFORM_SOA_KERNELS(Sse4, GULI_TARGET_SSE4, 4)
+#undef XF_V
+#undef XF_SET1
+#undef XF_LOAD
+#undef XF_STORE
+#undef XF_ADD
+#undef XF_SUB
+#undef XF_MUL
+#undef XF_FMA
+
+/* Column j of a * b: the columns of a weighted by the entries of column j of b */
+GULI_TARGET_SSE4 static void Sse4Mat4Mul(const float* a, size_t a_step, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += a_step, b += 16, out += 16)
+    {
+        const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+        for (int c = 0; c < 4; c++)
+        {
+            const __m128 bc = _mm_loadu_ps(b + 4 * c);
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(bc, bc, 0x00));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(bc, bc, 0x55)));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(bc, bc, 0xaa)));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(bc, bc, 0xff)));
+            _mm_storeu_ps(out + 4 * c, r);
+        }
+    }
+}
+
+static const TransformKernels g_sse4_kernels = {
+    "sse4", Sse4Points, Sse4Aabbs, Sse4Trs, Sse4Mat4Mul,
+};
+
+#define XF_V __m256
+#define XF_SET1 _mm256_set1_ps
+#define XF_LOAD _mm256_loadu_ps
+#define XF_STORE _mm256_storeu_ps
+#define XF_ADD _mm256_add_ps
+#define XF_SUB _mm256_sub_ps
+#define XF_MUL _mm256_mul_ps
+#define XF_FMA _mm256_fmadd_ps
+TRANSFORM_SOA_KERNELS(Avx2, GULI_TARGET_AVX2, 8)
+#undef XF_V
+#undef XF_SET1
+#undef XF_LOAD
+#undef XF_STORE
+#undef XF_ADD
+#undef XF_SUB
+#undef XF_MUL
+#undef XF_FMA
+
+/* Two result columns per register: each 128-bit lane holds one column */
+GULI_TARGET_AVX2 static void Avx2Mat4Mul(const float* a, size_t a_step, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += a_step, b += 16, out += 16)
+    {
+        const __m256 a0 = _mm256_broadcast_ps((const __m128*)a), a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8)), a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+        for (int c = 0; c < 4; c += 2)
+        {
+            const __m256 bc = _mm256_loadu_ps(b + 4 * c);
+            __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bc, 0x00));
+            r = _mm256_fmadd_ps(a1, _mm256_permute_ps(bc, 0x55), r);
+            r = _mm256_fmadd_ps(a2, _mm256_permute_ps(bc, 0xaa), r);
+            r = _mm256_fmadd_ps(a3, _mm256_permute_ps(bc, 0xff), r);
+            _mm256_storeu_ps(out + 4 * c, r);
+        }
+    }
+}
+
+static const TransformKernels g_avx2_kernels = {
+    "avx2", Avx2Points, Avx2Aabbs, Avx2Trs, Avx2Mat4Mul,
+};
+
+#define XF_V __m512
+#define XF_SET1 _mm512_set1_ps
+#define XF_LOAD _mm512_loadu_ps
+#define XF_STORE _mm512_storeu_ps
+#define XF_ADD _mm512_add_ps
+#define XF_SUB _mm512_sub_ps
+#define XF_MUL _mm512_mul_ps
+#define XF_FMA _mm512_fmadd_ps
+TRANSFORM_SOA_KERNELS(Avx512, GULI_TARGET_AVX512, 16)
+#undef XF_V
+#undef XF_SET1
+#undef XF_LOAD
+#undef XF_STORE
+#undef XF_ADD
+#undef XF_SUB
+#undef XF_MUL
+#undef XF_FMA
+
+/* The whole product in one register: one column per 128-bit lane */
+GULI_TARGET_AVX512 static void Avx512Mat4Mul(const float* a, size_t a_step, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += a_step, b += 16, out += 16)
+    {
+        const __m512 a0 = _mm512_broadcast_f32x4(_mm_loadu_ps(a)), a1 = _mm512_broadcast_f32x4(_mm_loadu_ps(a + 4));
+        const __m512 a2 = _mm512_broadcast_f32x4(_mm_loadu_ps(a + 8)), a3 = _mm512_broadcast_f32x4(_mm_loadu_ps(a + 12));
+        const __m512 bc = _mm512_loadu_ps(b);
+        __m512 r = _mm512_mul_ps(a0, _mm512_permute_ps(bc, 0x00));
+        r = _mm512_fmadd_ps(a1, _mm512_permute_ps(bc, 0x55), r);
+        r = _mm512_fmadd_ps(a2, _mm512_permute_ps(bc, 0xaa), r);
+        r = _mm512_fmadd_ps(a3, _mm512_permute_ps(bc, 0xff), r);
+        _mm512_storeu_ps(out, r);
+    }
+}
+
+static const TransformKernels g_avx512_kernels = {
+    "avx512", Avx512Points, Avx512Aabbs, Avx512Trs, Avx512Mat4Mul,
+};
+#endif /* GULI_TRANSFORM_X86 */
+
+/* ---- NEON (AArch64) ---- */
+
+#if GULI_TRANSFORM_NEON
+#define XF_V float32x4_t
+#define XF_SET1 vdupq_n_f32
+#define XF_LOAD vld1q_f32
+#define XF_STORE vst1q_f32
+#define XF_ADD vaddq_f32
+#define XF_SUB vsubq_f32
+#define XF_MUL vmulq_f32
+#define XF_FMA(a, b, c) vfmaq_f32(c, a, b)
+TRANSFORM_SOA_KERNELS(Neon, , 4)
+#undef XF_V
+#undef XF_SET1
+#undef XF_LOAD
+#undef XF_STORE
+#undef XF_ADD
+#undef XF_SUB
+#undef XF_MUL
+#undef XF_FMA
+
+static void NeonMat4Mul(const float* a, size_t a_step, const float* b, float* out, size_t n)
+{
+    for (size_t i = 0; i < n; i++, a += a_step, b += 16, out += 16)
+    {
+        const float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a + 4);
+        const float32x4_t a2 = vld1q_f32(a + 8), a3 = vld1q_f32(a + 12);
+        for (int c = 0; c < 4; c++)
+        {
+            const float32x4_t bc = vld1q_f32(b + 4 * c);
+            float32x4_t r = vmulq_laneq_f32(a0, bc, 0);
+            r = vfmaq_laneq_f32(r, a1, bc, 1);
+            r = vfmaq_laneq_f32(r, a2, bc, 2);
+            r = vfmaq_laneq_f32(r, a3, bc, 3);
+            vst1q_f32(out + 4 * c, r);
+        }
+    }
+}
+
+static const TransformKernels g_neon_kernels = {
+    "neon", NeonPoints, NeonAabbs, NeonTrs, NeonMat4Mul,
+};
+#endif /* GULI_TRANSFORM_NEON */
+
+static _Atomic(const TransformKernels*) g_transform_kernels;
+
+static const TransformKernels* TransformGetKernels(void)
+{
+    const TransformKernels* k = atomic_load_explicit(&g_transform_kernels, memory_order_acquire);
+    if (k) return k;
+
+    k = &g_scalar_kernels;
+#if GULI_TRANSFORM_X86
+    const GuliCpuFeatures* cpu = GuliGetCpuFeatures();
+    if (cpu->avx512f && cpu->avx2 && cpu->fma) k = &g_avx512_kernels;
+    else if (cpu->avx2 && cpu->fma) k = &g_avx2_kernels;
+    else if (cpu->sse41) k = &g_sse4_kernels;
+#elif GULI_TRANSFORM_NEON
+    k = &g_neon_kernels;
+#endif
+
+    atomic_store_explicit(&g_transform_kernels, k, memory_order_release);
+    return k;
+}
+
+const char* GuliTransformGetKernelName(void)
+{
+    return TransformGetKernels()->name;
+}
+
+/* -----------------------------------------------------------------------------
+ * Batches: one kernel call per range, ranges spread over the job system
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    const TransformKernels* k;
+    const float* m;
+    const float* in[10];
+    float* out[6];
+    size_t a_step;
+} TransformJob;
+
+static void TransformRun(size_t count, GuliParallelForFunc func, TransformJob* job)
+{
+    job->k = TransformGetKernels();
+    if (count < GULI_TRANSFORM_PARALLEL_MIN)
+    {
+        func(job, 0, count);
+        return;
+    }
+    /* About four ranges per thread, whole vector groups each so only the last range has a tail */
+    const size_t chunks = ((size_t)GuliJobGetWorkerCount() + 1) * 4;
+    size_t grain = (count + chunks - 1) / chunks;
+    grain = (grain + GULI_TRANSFORM_GROUP_MAX - 1) & ~(size_t)(GULI_TRANSFORM_GROUP_MAX - 1);
+    GuliParallelFor(count, grain, func, job);
+}
+
+static void PointsRange(void* user, size_t begin, size_t end)
+{
+    const TransformJob* job = user;
+    const float* const in[3] = { job->in[0] + begin, job->in[1] + begin, job->in[2] + begin };
+    float* const out[3] = { job->out[0] + begin, job->out[1] + begin, job->out[2] + begin };
+    job->k->points(job->m, in, out, end - begin);
+}
+
+static void AabbsRange(void* user, size_t begin, size_t end)
+{
+    const TransformJob* job = user;
+    const float* in[6];
+    float* out[6];
+    for (int c = 0; c < 6; c++)
+    {
+        in[c] = job->in[c] + begin;
+        out[c] = job->out[c] + begin;
+    }
+    job->k->aabbs(job->m, in, out, end - begin);
+}
+
+static void TrsRange(void* user, size_t begin, size_t end)
+{
+    const TransformJob* job = user;
+    const float* in[10];
+    for (int c = 0; c < 10; c++)
+        in[c] = job->in[c] + begin;
+    job->k->trs(in, job->out[0] + 16 * begin, end - begin);
+}
+
+static void Mat4MulRange(void* user, size_t begin, size_t end)
+{
+    const TransformJob* job = user;
+    job->k->mat4_mul(job->m + job->a_step * begin, job->a_step, job->in[0] + 16 * begin,
+        job->out[0] + 16 * begin, end - begin);
+}
+
+void GuliTransformPoints(const float m[16], const GuliVec3Soa* in, GuliVec3Soa* out, size_t count)
+{
+    if (!m || !in || !out || !count) return;
+    TransformJob job = { .m = m, .in = { in->x, in->y, in->z }, .out = { out->x, out->y, out->z } };
+    TransformRun(count, PointsRange, &job);
+}
+
+void GuliTransformAabbs(const float m[16], const GuliAabbSoa* in, GuliAabbSoa* out, size_t count)
+{
+    if (!m || !in || !out || !count) return;
+    TransformJob job = {
+        .m = m,
+        .in = { in->min.x, in->min.y, in->min.z, in->max.x, in->max.y, in->max.z },
+        .out = { out->min.x, out->min.y, out->min.z, out->max.x, out->max.y, out->max.z },
+    };
+    TransformRun(count, AabbsRange, &job);
+}
+
+void GuliMat4MulBatch(const float* a, const float* b, float* out, size_t count)
+{
+    if (!a || !b || !out || !count) return;
+    TransformJob job = { .m = a, .in = { b }, .out = { out }, .a_step = 16 };
+    TransformRun(count, Mat4MulRange, &job);
+}
+
+void GuliMat4MulBatchLeft(const float m[16], const float* b, float* out, size_t count)
+{
+    if (!m || !b || !out || !count) return;
+    TransformJob job = { .m = m, .in = { b }, .out = { out }, .a_step = 0 };
+    TransformRun(count, Mat4MulRange, &job);
+}
+
+void GuliComposeTrs(const GuliTrsSoa* trs, float* out, size_t count)
+{
+    if (!trs || !out || !count) return;
+    TransformJob job = {
+        .in = { trs->tx, trs->ty, trs->tz, trs->qx, trs->qy, trs->qz, trs->qw, trs->sx, trs->sy, trs->sz },
+        .out = { out },
+    };
+    TransformRun(count, TrsRange, &job);
+}
+
+void GuliBuildMvps(const float view[16], const float proj[16], const float* models, float* out, size_t count)
+{
+    if (!view || !proj || !models || !out || !count) return;
+    float view_proj[16];
+    TransformGetKernels()->mat4_mul(proj, 0, view, view_proj, 1);
+    GuliMat4MulBatchLeft(view_proj, models, out, count);
+}
@@ -117,6 +117,12 @@ static void MetalUpdateDrawableSizeAndAttachments(void)
     {
         m->_depth = nil;
     }
+
+    const size_t bytes = (size_t)w * (size_t)h * 4 * m->_layer.maximumDrawableCount +
+        (m->_msaaColor ? m->_msaaColor.allocatedSize : 0) + (m->_depth ? m->_depth.allocatedSize : 0);
+    if (m->_framebufferBytes) GuliMemoryUntrack(GULI_MEMORY_FRAMEBUFFER, m->_framebufferBytes);
+    GuliMemoryTrack(GULI_MEMORY_FRAMEBUFFER, bytes);
+    m->_framebufferBytes = bytes;
 }
 
 GULIResult MetalInit(GuliState* state)
@@ -131,7 +137,7 @@ GULIResult MetalInit(GuliState* state)
         return GULI_ERROR_FAILED;
     }
 
-    metal_s = calloc(1, sizeof(struct MetalState));
+    metal_s = GuliCalloc(1, sizeof(struct MetalState));
     if (!metal_s) { err_msg = "Failed to allocate memory for Metal state"; goto fail; }
 
     metal_s->_device = MTLCreateSystemDefaultDevice();
@@ -183,7 +189,7 @@ GULIResult MetalInit(GuliState* state)
 fail:
     if (state) GuliSetError(&state->error, GULI_ERROR_FAILED, err_msg);
     GULI_PRINT_ERROR(GULI_ERROR_FAILED, err_msg);
-    if (metal_s) free(metal_s);
+    if (metal_s) GuliFree(metal_s);
     return GULI_ERROR_FAILED;
 }
 
@@ -202,6 +208,7 @@ void MetalShutdown(GuliState* state)
 
     struct MetalState* m = state->metal_s;
 
+    if (m->_framebufferBytes) GuliMemoryUntrack(GULI_MEMORY_FRAMEBUFFER, m->_framebufferBytes);
     m->_drawable = nil;
     m->_enc = nil;
     m->_cmd = nil;
@@ -220,7 +227,7 @@ void MetalShutdown(GuliState* state)
     m->_commandQueue = nil;
     m->_device = nil;
 
-    free(state->metal_s);
+    GuliFree(state->metal_s);
     state->metal_s = nil;
 
     GuliSetError(&state->error, GULI_ERROR_SUCCESS, "Metal shutdown successfully");
@@ -346,6 +353,15 @@ int MetalHasActiveFrame(void)
     return (m && m->_cmd != nil) ? 1 : 0;
 }
 
+int MetalSetSwapInterval(int interval)
+{
+    struct MetalState* m = G_State.metal_s;
+    if (!m || !m->_layer) return 0;
+    // No late-swap tearing on CAMetalLayer: adaptive behaves like vsync.
+    m->_layer.displaySyncEnabled = (interval != 0);
+    return interval != 0 ? 1 : 0;
+}
+
 void MetalClearColor(GULI_COLOR color)
 {
     struct MetalState* m = G_State.metal_s;
@@ -366,3 +382,18 @@ void MetalDrawFullscreen(void)
 
     [m->_enc drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
 }
+
+int MetalGetVideoMemoryInfo(GuliVideoMemoryInfo* info)
+{
+    if (!info) return 0;
+    info->total_kb = info->available_kb = -1;
+    struct MetalState* m = G_State.metal_s;
+    if (!m || !m->_device) return 0;
+
+    /* The working-set limit is what Metal lets the process keep resident */
+    const uint64_t limit = m->_device.recommendedMaxWorkingSetSize;
+    const uint64_t used = m->_device.currentAllocatedSize;
+    info->total_kb = (int64_t)(limit / 1024);
+    info->available_kb = used < limit ? (int64_t)((limit - used) / 1024) : 0;
+    return 1;
+}
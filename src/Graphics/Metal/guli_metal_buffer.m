@@ -0,0 +1,37 @@
+#import "Graphics/Metal/guli_metal.h"
+#import "Graphics/guli_buffer.h"
+
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Metal buffer backend (shared storage: CPU writes are visible to the GPU)
+ * ----------------------------------------------------------------------------- */
+
+int MetalBufferCreate(GuliBuffer* buffer, const void* data)
+{
+    struct MetalState* m = G_State.metal_s;
+    if (!m || !m->_device) return 0;
+
+    id<MTLBuffer> mtlBuf = data
+        ? [m->_device newBufferWithBytes:data length:(NSUInteger)buffer->size options:MTLResourceStorageModeShared]
+        : [m->_device newBufferWithLength:(NSUInteger)buffer->size options:MTLResourceStorageModeShared];
+    if (!mtlBuf) return 0;
+
+    buffer->_backend = (__bridge_retained void*)mtlBuf;
+    return 1;
+}
+
+void MetalBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size)
+{
+    id<MTLBuffer> mtlBuf = (__bridge id<MTLBuffer>)buffer->_backend;
+    memcpy((unsigned char*)[mtlBuf contents] + offset, data, size);
+}
+
+void MetalBufferUnload(GuliBuffer* buffer)
+{
+    if (!buffer->_backend) return;
+    id<MTLBuffer> mtlBuf = (__bridge_transfer id<MTLBuffer>)buffer->_backend;
+    (void)mtlBuf; /* ARC releases when we transfer */
+    buffer->_backend = NULL;
+    buffer->size = 0;
+}
@@ -2,7 +2,7 @@
 #import "Graphics/Metal/guli_metal_shader.h"
 #import "Graphics/guli_texture.h"
 #import "Graphics/guli_shader_defines.h"
-#import "Core/guli_file.h"
+#import "Graphics/guli_shader_preprocess.h"
 #import "Core/guli_hash.h"
 
 #include <stdlib.h>
@@ -79,8 +79,12 @@ struct GuliShader {
     NSUInteger colorOffset;
     MetalUniformHash uniformHash;
     MetalUniformHash vertexUniformHash;
+    GuliHandle handle;
 };
 
+/* Cold data: the debug name */
+static GuliPool g_metal_shader_pool = GULI_POOL_INIT(sizeof(struct GuliShader), GULI_RESOURCE_NAME_MAX);
+
 static void MetalBuildUniformHash(MetalUniformHash* outHash, NSArray<MTLArgument*>* args)
 {
     outHash->entries = NULL;
@@ -98,7 +102,7 @@ static void MetalBuildUniformHash(MetalUniformHash* outHash, NSArray<MTLArgument
         if (!st || st.members.count == 0) continue;
 
         int cnt = (int)st.members.count;
-        MetalUniformLoc* entries = (MetalUniformLoc*)calloc((size_t)cnt, sizeof(MetalUniformLoc));
+        MetalUniformLoc* entries = (MetalUniformLoc*)GuliCalloc((size_t)cnt, sizeof(MetalUniformLoc));
         if (!entries) return;
 
         outHash->entries = entries;
@@ -203,10 +207,13 @@ GuliShader* MetalShaderLoadFromMemoryEx(const char* vsCode, const char* fsCode,
         }
     }
 
-    GuliShader* shader = calloc(1, sizeof(GuliShader));
+    GuliHandle handle;
+    GuliShader* shader = GuliPoolAlloc(&g_metal_shader_pool, &handle);
     if (!shader) return NULL;
 
+    shader->handle = handle;
     shader->pipeline = pipeline;
+    GuliMemoryTrack(GULI_MEMORY_SHADER, 0);  /* Metal does not expose pipeline sizes: counted only */
     shader->uniformBuffer = uniformBuffer;
     shader->vertexUniformBuffer = vertexUniformBuffer;
     shader->colorOffset = colorOffset;
@@ -227,7 +234,7 @@ GuliShader* MetalShaderLoadFromFileEx(const char* path, const char* unused, cons
     if (!path) return NULL;
 
     g_metal_shader_error[0] = '\0';
-    char* source = GuliLoadFileText(path);
+    char* source = GuliShaderPreprocess(path, NULL, NULL, 0);
     if (!source)
     {
         strncpy(g_metal_shader_error, "Failed to load shader file", GULI_SHADER_ERROR_MAX - 1);
@@ -237,23 +244,44 @@ GuliShader* MetalShaderLoadFromFileEx(const char* path, const char* unused, cons
     }
 
     GuliShader* shader = MetalShaderLoadFromMemoryEx(source, NULL, vertexName, fragmentName);
-    free(source);
+    GuliFree(source);
+    return shader;
+}
+
+GuliShader* MetalShaderLoadSpirv(const GuliShaderSpirvDesc* desc)
+{
+    if (!desc || !desc->vs_source)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "SPIR-V shader needs an MSL fallback on Metal");
+        return NULL;
+    }
+    char* source = GuliShaderPreprocessSpecConstants(desc->vs_source, desc->constants, desc->constant_count);
+    if (!source) return NULL;
+    GuliShader* shader = MetalShaderLoadFromMemoryEx(source, NULL, desc->vs_entry, desc->fs_entry);
+    GuliFree(source);
     return shader;
 }
 
+int MetalShaderIsSpirvSupported(void)
+{
+    return 0;
+}
+
 void MetalShaderUnload(GuliShader* shader)
 {
     if (!shader) return;
+    if (shader->pipeline) GuliMemoryUntrack(GULI_MEMORY_SHADER, 0);
     shader->pipeline = nil;
     shader->uniformBuffer = nil;
     shader->vertexUniformBuffer = nil;
-    free(shader->uniformHash.entries);
+    GuliFree(shader->uniformHash.entries);
     shader->uniformHash.entries = NULL;
     shader->uniformHash.count = 0;
-    free(shader->vertexUniformHash.entries);
+    GuliFree(shader->vertexUniformHash.entries);
     shader->vertexUniformHash.entries = NULL;
     shader->vertexUniformHash.count = 0;
-    free(shader);
+    /* In-flight command buffers retain the pipeline, so the slot is reusable at once */
+    GuliPoolFree(&g_metal_shader_pool, shader->handle);
 }
 
 int MetalShaderIsValid(const GuliShader* shader)
@@ -261,6 +289,30 @@ int MetalShaderIsValid(const GuliShader* shader)
     return (shader && shader->pipeline != nil) ? 1 : 0;
 }
 
+GuliShaderHandle MetalShaderGetHandle(const GuliShader* shader)
+{
+    return shader ? shader->handle : GULI_HANDLE_NULL;
+}
+
+GuliShader* MetalShaderFromHandle(GuliShaderHandle handle)
+{
+    return GuliPoolGet(&g_metal_shader_pool, handle);
+}
+
+void MetalShaderSetName(GuliShader* shader, const char* name)
+{
+    char* cold = shader ? GuliPoolGetCold(&g_metal_shader_pool, shader->handle) : NULL;
+    if (!cold) return;
+    strncpy(cold, name ? name : "", GULI_RESOURCE_NAME_MAX - 1);
+    cold[GULI_RESOURCE_NAME_MAX - 1] = '\0';
+}
+
+const char* MetalShaderGetName(const GuliShader* shader)
+{
+    const char* cold = shader ? GuliPoolGetCold(&g_metal_shader_pool, shader->handle) : NULL;
+    return cold ? cold : "";
+}
+
 const char* MetalShaderGetCompileError(void)
 {
     return (g_metal_shader_error[0] != '\0') ? g_metal_shader_error : NULL;
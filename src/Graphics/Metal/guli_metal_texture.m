@@ -7,9 +7,9 @@
  * Metal texture backend
  * ----------------------------------------------------------------------------- */
 
-GuliTexture* MetalTextureCreateFromPixels(int width, int height, const unsigned char* pixels)
+GuliTexture* MetalTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels)
 {
-    if (width <= 0 || height <= 0) return NULL;
+    if (width <= 0 || height <= 0 || levels <= 0 || !pixels) return NULL;
 
     struct MetalState* m = G_State.metal_s;
     if (!m || !m->_device) return NULL;
@@ -17,31 +17,43 @@ GuliTexture* MetalTextureCreateFromPixels(int width, int height, const unsigned
     MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA8Unorm
                                                                                     width:(NSUInteger)width
                                                                                    height:(NSUInteger)height
-                                                                                mipmapped:NO];
+                                                                                mipmapped:(levels > 1)];
+    desc.mipmapLevelCount = (NSUInteger)levels;
     desc.usage = MTLTextureUsageShaderRead;
     desc.storageMode = MTLStorageModeShared;
 
     id<MTLTexture> mtlTex = [m->_device newTextureWithDescriptor:desc];
     if (!mtlTex) return NULL;
 
-    if (pixels)
+    size_t bytes = 0;
+    for (int level = 0; level < levels; level++)
     {
-        MTLRegion region = MTLRegionMake2D(0, 0, (NSUInteger)width, (NSUInteger)height);
-        NSUInteger bytesPerRow = (NSUInteger)width * 4;
-        [mtlTex replaceRegion:region mipmapLevel:0 withBytes:pixels bytesPerRow:bytesPerRow];
+        const NSUInteger lw = (width >> level) > 0 ? (NSUInteger)(width >> level) : 1;
+        const NSUInteger lh = (height >> level) > 0 ? (NSUInteger)(height >> level) : 1;
+        bytes += (size_t)lw * lh * 4;
+        if (!pixels[level]) continue;
+        MTLRegion region = MTLRegionMake2D(0, 0, lw, lh);
+        [mtlTex replaceRegion:region mipmapLevel:(NSUInteger)level withBytes:pixels[level] bytesPerRow:lw * 4];
     }
 
-    GuliTexture* tex = (GuliTexture*)calloc(1, sizeof(GuliTexture));
+    GuliTexture* tex = GuliTextureAlloc();
     if (!tex)
     {
         return NULL;
     }
-    tex->_backend = (__bridge void*)mtlTex;
+    tex->_backend = (__bridge_retained void*)mtlTex;
     tex->width = width;
     tex->height = height;
+    tex->_bytes = bytes;
+    GuliMemoryTrack(GULI_MEMORY_TEXTURE, bytes);
     return tex;
 }
 
+GuliTexture* MetalTextureCreateFromPixels(int width, int height, const unsigned char* pixels)
+{
+    return MetalTextureCreateFromLevels(width, height, 1, &pixels);
+}
+
 void MetalTextureUnload(GuliTexture* texture)
 {
     if (!texture) return;
@@ -50,6 +62,8 @@ void MetalTextureUnload(GuliTexture* texture)
         id<MTLTexture> mtlTex = (__bridge_transfer id<MTLTexture>)texture->_backend;
         (void)mtlTex; /* ARC releases when we transfer */
         texture->_backend = NULL;
+        GuliMemoryUntrack(GULI_MEMORY_TEXTURE, texture->_bytes);
     }
+    texture->_bytes = 0;
     texture->width = texture->height = 0;
 }
@@ -1,4 +1,6 @@
 #include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/guli_loader.h"
 
 #include <glad/glad.h>
 
@@ -31,9 +33,9 @@ GULIResult GlInit(GuliState* state)
         return GULI_ERROR_FAILED;
     }
 
-    glfwSwapInterval(1);
+    glfwSwapInterval(1);  /* GULI_PRESENT_VSYNC; see GuliSetPresentMode */
 
-    state->gl_s = calloc(1, sizeof(struct GLState));
+    state->gl_s = GuliCalloc(1, sizeof(struct GLState));
     if (!state->gl_s)
     {
         GuliSetError(&state->error, GULI_ERROR_FAILED, "Failed to allocate GL state");
@@ -48,13 +50,27 @@ GULIResult GlInit(GuliState* state)
     if (sem_init(&state->gl_s->inflight_semaphore, 0, GULI_MAX_FRAMES_IN_FLIGHT) != 0)
 #endif
     {
-        free(state->gl_s);
+        GuliFree(state->gl_s);
         state->gl_s = NULL;
         GuliSetError(&state->error, GULI_ERROR_FAILED, "Failed to create frame semaphore");
         GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create frame semaphore");
         return GULI_ERROR_FAILED;
     }
 
+    if (!GlRetireInit(state->gl_s))
+    {
+#if defined(__APPLE__)
+        state->gl_s->inflight_semaphore = NULL;
+#else
+        sem_destroy(&state->gl_s->inflight_semaphore);
+#endif
+        GuliFree(state->gl_s);
+        state->gl_s = NULL;
+        GuliSetError(&state->error, GULI_ERROR_FAILED, "Failed to create deletion queue");
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create deletion queue");
+        return GULI_ERROR_FAILED;
+    }
+
     state->gl_s->has_active_frame = 0;
     state->gl_s->frame_index = 0;
 
@@ -67,6 +83,10 @@ GULIResult GlInit(GuliState* state)
 
 void GlShutdown(GuliState* state)
 {
+    if (state) GlShaderReloadFree(state->gl_s);
+    GlRenderThreadStop();
+    GuliLoaderStop();
+    GlRetireCollect(1);
     if (state && state->gl_s && state->gl_s->fullscreen_vao)
         glDeleteVertexArrays(1, &state->gl_s->fullscreen_vao);
 
@@ -85,26 +105,58 @@ void GlShutdown(GuliState* state)
 #else
     sem_destroy(&state->gl_s->inflight_semaphore);
 #endif
-    free(state->gl_s);
+    if (state->gl_s->framebuffer_bytes) GuliMemoryUntrack(GULI_MEMORY_FRAMEBUFFER, state->gl_s->framebuffer_bytes);
+    GlDamageFree(state->gl_s);
+    GlRetireFree(state->gl_s);
+    GuliFree(state->gl_s);
     state->gl_s = NULL;
 
     GuliSetError(&state->error, GULI_ERROR_SUCCESS, "OpenGL shutdown successfully");
 }
 
-static void GlBeginFrame(void)
+void GlExecBeginFrame(const GlCmdFrame* frame)
 {
     struct GLState* gl = G_State.gl_s;
     if (!gl) return;
 
     GL_SEM_WAIT(gl);
 
+    gl->framebuffer_width = frame->width;
+    gl->framebuffer_height = frame->height;
+    if (frame->width > 0 && frame->height > 0)
+        glViewport(0, 0, frame->width, frame->height);
+    GlDamageBeginFrame(frame);
+}
+
+/* Default framebuffer estimate: front and back RGBA8 plus 24/8 depth-stencil (GLFW's defaults). */
+static void GlTrackFramebuffer(struct GLState* gl, int width, int height)
+{
+    if (width <= 0 || height <= 0) return;
+    const size_t bytes = (size_t)width * (size_t)height * (4 * 2 + 4);
+    if (bytes == gl->framebuffer_bytes) return;
+    if (gl->framebuffer_bytes) GuliMemoryUntrack(GULI_MEMORY_FRAMEBUFFER, gl->framebuffer_bytes);
+    GuliMemoryTrack(GULI_MEMORY_FRAMEBUFFER, bytes);
+    gl->framebuffer_bytes = bytes;
+}
+
+static void GlBeginFrame(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return;
+
     gl->has_active_frame = 1;
     gl->frame_index = (gl->frame_index + 1) % GULI_MAX_FRAMES_IN_FLIGHT;
 
-    int w = 0, h = 0;
-    GuliGetFramebufferSize(&w, &h);
-    if (w > 0 && h > 0)
-        glViewport(0, 0, w, h);
+    GlCmdFrame frame = {0};
+    GuliGetFramebufferSize(&frame.width, &frame.height);
+    GlTrackFramebuffer(gl, frame.width, frame.height);
+    frame.damage_count = GuliFramePacingGetDamage(frame.damage);
+
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdBeginFrame(cmd, &frame);
+    else GlExecBeginFrame(&frame);
+    GlRetireCollect(0);
+    GlShaderReloadPoll(gl);
 }
 
 void GlBeginDraw(void)
@@ -118,6 +170,12 @@ void GlClearColor(GULI_COLOR color)
     struct GLState* gl = G_State.gl_s;
     if (!gl) return;
 
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd)
+    {
+        GlCmdClear(cmd, color);
+        return;
+    }
     glClearColor(color[0], color[1], color[2], color[3]);
     glClear(GL_COLOR_BUFFER_BIT);
 }
@@ -129,6 +187,12 @@ static void GlBeginPass(const GULI_COLOR* clearColor)
 
     if (clearColor)
     {
+        GlCmdBuffer* cmd = GlRenderThreadRecorder();
+        if (cmd)
+        {
+            GlCmdClear(cmd, *clearColor);
+            return;
+        }
         glClearColor((*clearColor)[0], (*clearColor)[1], (*clearColor)[2], (*clearColor)[3]);
         glClear(GL_COLOR_BUFFER_BIT);
     }
@@ -144,18 +208,42 @@ void GlDrawFullscreen(void)
     struct GLState* gl = G_State.gl_s;
     if (!gl) return;
 
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd)
+    {
+        GlCmdDrawFullscreen(cmd);
+        return;
+    }
     glBindVertexArray(gl->fullscreen_vao);
     glDrawArrays(GL_TRIANGLES, 0, 3);
 }
 
+void GlExecEndFrame(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return;
+
+    if (gl->recorder)
+        GlRecorderCapture();
+    if (!GlDamageSwap())
+        glfwSwapBuffers(G_State.window);
+    GL_SEM_POST(gl);
+}
+
 static void GlEndFrame(void)
 {
     struct GLState* gl = G_State.gl_s;
     if (!gl) return;
 
     gl->has_active_frame = 0;
-    glfwSwapBuffers(G_State.window);
-    GL_SEM_POST(gl);
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd)
+    {
+        GlCmdEndFrame(cmd);
+        GlRenderThreadSubmit();
+        return;
+    }
+    GlExecEndFrame();
 }
 
 void GlEndDraw(void)
@@ -164,8 +252,63 @@ void GlEndDraw(void)
     GlEndFrame();
 }
 
+typedef struct {
+    int interval;
+} GlSwapIntervalCall;
+
+static void GlSwapIntervalInvoke(void* arg)
+{
+    GlSwapIntervalCall* call = arg;
+    if (call->interval < 0 &&
+        !glfwExtensionSupported("GLX_EXT_swap_control_tear") &&
+        !glfwExtensionSupported("WGL_EXT_swap_control_tear"))
+        call->interval = 1;
+    glfwSwapInterval(call->interval);
+}
+
+int GlSetSwapInterval(int interval)
+{
+    if (!G_State.gl_s) return 0;
+    GlSwapIntervalCall call = { interval };
+    GlRenderThreadInvoke(GlSwapIntervalInvoke, &call);
+    return call.interval;
+}
+
 int GlHasActiveFrame(void)
 {
     struct GLState* gl = G_State.gl_s;
     return (gl && gl->has_active_frame) ? 1 : 0;
 }
+
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+
+static void GlVideoMemoryInvoke(void* arg)
+{
+    GuliVideoMemoryInfo* info = arg;
+    if (glfwExtensionSupported("GL_NVX_gpu_memory_info"))
+    {
+        GLint total = 0, available = 0;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &total);
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+        info->total_kb = total;
+        info->available_kb = available;
+    }
+    else if (glfwExtensionSupported("GL_ATI_meminfo"))
+    {
+        /* Free pool KiB, largest free block, then auxiliary memory; no total */
+        GLint free_texture[4] = {0};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, free_texture);
+        info->available_kb = free_texture[0];
+    }
+}
+
+int GlGetVideoMemoryInfo(GuliVideoMemoryInfo* info)
+{
+    if (!info) return 0;
+    info->total_kb = info->available_kb = -1;
+    if (!G_State.gl_s) return 0;
+    GlRenderThreadInvoke(GlVideoMemoryInvoke, info);
+    return (info->total_kb >= 0 || info->available_kb >= 0) ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/guli_buffer.h"
+
+#include <glad/glad.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL buffer backend. Creation and updates go through GL_COPY_WRITE_BUFFER so
+ * they never disturb VAO state (element array bindings) or the caller's bindings.
+ * ----------------------------------------------------------------------------- */
+
+int GlBufferCreate(GuliBuffer* buffer, const void* data);
+
+typedef struct {
+    GuliBuffer* buffer;
+    const void* data;
+    int result;
+} GlBufferCreateCall;
+
+static void GlBufferCreateInvoke(void* arg)
+{
+    GlBufferCreateCall* call = arg;
+    call->result = GlBufferCreate(call->buffer, call->data);
+}
+
+int GlBufferCreate(GuliBuffer* buffer, const void* data)
+{
+    if (GlRenderThreadIsRemote())
+    {
+        GlBufferCreateCall call = { buffer, data, 0 };
+        GlRenderThreadInvoke(GlBufferCreateInvoke, &call);
+        return call.result;
+    }
+
+    unsigned int id = 0;
+    glGenBuffers(1, &id);
+    if (!id) return 0;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)buffer->size, data,
+        buffer->type == GULI_BUFFER_VERTEX || buffer->type == GULI_BUFFER_INDEX ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    buffer->_backend = (void*)(uintptr_t)id;
+    return 1;
+}
+
+void GlBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size)
+{
+    const unsigned int id = (unsigned int)(uintptr_t)buffer->_backend;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd)
+    {
+        GlCmdBufferData(cmd, id, offset, data, size);
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GlBufferUnload(GuliBuffer* buffer)
+{
+    /* Deleted (and the slot recycled) once frames that may read it have retired */
+    GlRetireObject(GL_RETIRE_BUFFER, (unsigned int)(uintptr_t)buffer->_backend, &G_BufferPool, buffer->_handle);
+    buffer->_backend = NULL;
+    buffer->size = 0;
+}
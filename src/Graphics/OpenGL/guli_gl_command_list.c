@@ -0,0 +1,233 @@
+#include "Graphics/guli_command_list.h"
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/OpenGL/guli_gl_shader.h"
+
+#include <stdlib.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL command lists: per-thread encoding into the shared command stream
+ * format, merged by sort key at submit
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    uint64_t key;
+    size_t begin;  /* byte offset into the list's stream; ends where the next packet begins */
+} GlCmdPacket;
+
+struct GuliCommandList {
+    GlCmdBuffer stream;
+    GlCmdPacket* packets;
+    size_t packet_count;
+    size_t packet_capacity;
+    uint64_t key;
+    int open;  /* a packet with the current key is accepting commands */
+};
+
+typedef struct {
+    uint64_t key;
+    uint32_t list;
+    uint32_t packet;
+} GlCmdSortItem;
+
+GuliCommandList* GuliCommandListCreate(void)
+{
+    GuliCommandList* list = GuliCalloc(1, sizeof(GuliCommandList));
+    if (!list)
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate command list");
+    return list;
+}
+
+void GuliCommandListDestroy(GuliCommandList* list)
+{
+    if (!list) return;
+    GlCmdBufferFree(&list->stream);
+    GuliFree(list->packets);
+    GuliFree(list);
+}
+
+void GuliCommandListReset(GuliCommandList* list)
+{
+    if (!list) return;
+    GlCmdBufferReset(&list->stream);
+    list->packet_count = 0;
+    list->key = 0;
+    list->open = 0;
+}
+
+void GuliCommandListSetKey(GuliCommandList* list, uint64_t key)
+{
+    if (!list) return;
+    list->key = key;
+    list->open = 0;
+}
+
+size_t GuliCommandListGetPacketCount(const GuliCommandList* list)
+{
+    return list ? list->packet_count : 0;
+}
+
+/* Stream to record into, opening a packet if needed; NULL on failure. */
+static GlCmdBuffer* GlListStream(GuliCommandList* list)
+{
+    if (!list) return NULL;
+    if (list->open) return &list->stream;
+
+    if (list->packet_count == list->packet_capacity)
+    {
+        size_t capacity = list->packet_capacity ? list->packet_capacity * 2 : 256;
+        GlCmdPacket* packets = GuliRealloc(list->packets, capacity * sizeof(GlCmdPacket));
+        if (!packets)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to grow command list packets");
+            return NULL;
+        }
+        list->packets = packets;
+        list->packet_capacity = capacity;
+    }
+    list->packets[list->packet_count].key = list->key;
+    list->packets[list->packet_count].begin = list->stream.size;
+    list->packet_count++;
+    list->open = 1;
+    return &list->stream;
+}
+
+void GuliCmdUseShader(GuliCommandList* list, GuliShader* shader)
+{
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUseProgram(buf, GlShaderGetProgram(shader));
+}
+
+void GuliCmdSetFloat(GuliCommandList* list, GuliShader* shader, int loc, float value)
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformFloats(buf, program, loc, &value, 1);
+}
+
+void GuliCmdSetVec2(GuliCommandList* list, GuliShader* shader, int loc, const float v[2])
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0 || !v) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformFloats(buf, program, loc, v, 2);
+}
+
+void GuliCmdSetVec3(GuliCommandList* list, GuliShader* shader, int loc, const float v[3])
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0 || !v) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformFloats(buf, program, loc, v, 3);
+}
+
+void GuliCmdSetVec4(GuliCommandList* list, GuliShader* shader, int loc, const float v[4])
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0 || !v) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformFloats(buf, program, loc, v, 4);
+}
+
+void GuliCmdSetInt(GuliCommandList* list, GuliShader* shader, int loc, int value)
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformInt(buf, program, loc, value);
+}
+
+void GuliCmdSetMatrix4(GuliCommandList* list, GuliShader* shader, int loc, const float m[16])
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0 || !m) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdUniformMatrix4(buf, program, loc, m);
+}
+
+void GuliCmdSetColor(GuliCommandList* list, GuliShader* shader, int loc, GULI_COLOR color)
+{
+    GuliCmdSetVec4(list, shader, loc, color);
+}
+
+void GuliCmdSetTexture(GuliCommandList* list, GuliShader* shader, int loc, GuliTexture* texture, int slot)
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!program || (loc = GlShaderResolveLocation(shader, loc)) < 0 || !texture || !texture->_backend) return;
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdBindTexture2D(buf, program, loc, slot, (unsigned int)(uintptr_t)texture->_backend);
+}
+
+void GuliCmdDrawFullscreen(GuliCommandList* list)
+{
+    GlCmdBuffer* buf = GlListStream(list);
+    if (buf) GlCmdDrawFullscreen(buf);
+}
+
+static int GlCmdSortCompare(const void* a, const void* b)
+{
+    const GlCmdSortItem* x = a;
+    const GlCmdSortItem* y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->list != y->list) return x->list < y->list ? -1 : 1;
+    return (x->packet > y->packet) - (x->packet < y->packet);
+}
+
+void GuliCommandListSubmit(GuliCommandList* const* lists, int count)
+{
+    if (!lists || count <= 0) return;
+    if (!GlHasActiveFrame())
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliCommandListSubmit must be called between GuliBeginDraw and GuliEndDraw");
+        return;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < count; i++)
+        total += lists[i] ? lists[i]->packet_count : 0;
+    if (total == 0) return;
+
+    GlCmdSortItem* items = GuliFrameAlloc(total * sizeof(GlCmdSortItem));
+    if (!items)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate command list merge buffer");
+        return;
+    }
+
+    size_t n = 0;
+    int sorted = 1;
+    for (int i = 0; i < count; i++)
+    {
+        const GuliCommandList* list = lists[i];
+        if (!list) continue;
+        for (size_t p = 0; p < list->packet_count; p++)
+        {
+            items[n].key = list->packets[p].key;
+            items[n].list = (uint32_t)i;
+            items[n].packet = (uint32_t)p;
+            if (n > 0 && GlCmdSortCompare(&items[n - 1], &items[n]) > 0) sorted = 0;
+            n++;
+        }
+    }
+    if (!sorted)
+        qsort(items, n, sizeof(GlCmdSortItem), GlCmdSortCompare);
+
+    /* Runs of consecutive packets from one list are replayed (or forwarded) as a single range. */
+    GlCmdBuffer* frame = GlRenderThreadRecorder();
+    size_t i = 0;
+    while (i < n)
+    {
+        const GuliCommandList* list = lists[items[i].list];
+        size_t j = i + 1;
+        while (j < n && items[j].list == items[i].list && items[j].packet == items[j - 1].packet + 1)
+            j++;
+
+        const size_t last = items[j - 1].packet;
+        const size_t begin = list->packets[items[i].packet].begin;
+        const size_t end = (last + 1 < list->packet_count) ? list->packets[last + 1].begin : list->stream.size;
+        if (frame) GlCmdAppend(frame, list->stream.data + begin, end - begin);
+        else GlCmdReplay(list->stream.data + begin, end - begin);
+        i = j;
+    }
+}
@@ -0,0 +1,309 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+
+#include <glad/glad.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL command stream: encoding and replay
+ * ----------------------------------------------------------------------------- */
+
+#define GL_CMD_ALIGN 8
+#define GL_CMD_INITIAL_CAPACITY 4096
+
+static int GlCmdReserve(GlCmdBuffer* buf, size_t size)
+{
+    if (buf->size + size <= buf->capacity) return 1;
+
+    size_t capacity = buf->capacity ? buf->capacity * 2 : GL_CMD_INITIAL_CAPACITY;
+    while (capacity < buf->size + size)
+        capacity *= 2;
+    unsigned char* data = GuliRealloc(buf->data, capacity);
+    if (!data)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to grow GL command buffer");
+        return 0;
+    }
+    buf->data = data;
+    buf->capacity = capacity;
+    return 1;
+}
+
+void* GlCmdPush(GlCmdBuffer* buf, GlCmdOp op, size_t payload)
+{
+    const size_t size = (sizeof(GlCmdHeader) + payload + GL_CMD_ALIGN - 1) & ~(size_t)(GL_CMD_ALIGN - 1);
+    if (!GlCmdReserve(buf, size)) return NULL;
+
+    GlCmdHeader* header = (GlCmdHeader*)(buf->data + buf->size);
+    header->op = (uint32_t)op;
+    header->size = (uint32_t)size;
+    buf->size += size;
+    memset(header + 1, 0, size - sizeof(GlCmdHeader));
+    return header + 1;
+}
+
+int GlCmdAppend(GlCmdBuffer* buf, const unsigned char* data, size_t size)
+{
+    if (!size) return 1;
+    if (!GlCmdReserve(buf, size)) return 0;
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    return 1;
+}
+
+void GlCmdBufferReset(GlCmdBuffer* buf)
+{
+    buf->size = 0;
+}
+
+void GlCmdBufferFree(GlCmdBuffer* buf)
+{
+    GuliFree(buf->data);
+    buf->data = NULL;
+    buf->size = buf->capacity = 0;
+}
+
+void GlCmdBeginFrame(GlCmdBuffer* buf, const GlCmdFrame* frame)
+{
+    GlCmdFrame* c = GlCmdPush(buf, GL_CMD_BEGIN_FRAME, sizeof(*c));
+    if (c) *c = *frame;
+}
+
+void GlCmdEndFrame(GlCmdBuffer* buf)
+{
+    GlCmdPush(buf, GL_CMD_END_FRAME, 0);
+}
+
+void GlCmdClear(GlCmdBuffer* buf, const float color[4])
+{
+    GlCmdClearColor* c = GlCmdPush(buf, GL_CMD_CLEAR, sizeof(*c));
+    if (c) memcpy(c->color, color, sizeof(c->color));
+}
+
+void GlCmdDrawFullscreen(GlCmdBuffer* buf)
+{
+    GlCmdPush(buf, GL_CMD_DRAW_FULLSCREEN, 0);
+}
+
+void GlCmdUseProgram(GlCmdBuffer* buf, unsigned int program)
+{
+    GlCmdObject* c = GlCmdPush(buf, GL_CMD_USE_PROGRAM, sizeof(*c));
+    if (c) c->id = program;
+}
+
+void GlCmdUniformFloats(GlCmdBuffer* buf, unsigned int program, int loc, const float* v, int count)
+{
+    if (count < 1 || count > 4) return;
+    GlCmdUniformF* c = GlCmdPush(buf, GL_CMD_UNIFORM_F, sizeof(*c));
+    if (!c) return;
+    c->program = program;
+    c->loc = loc;
+    c->count = count;
+    memcpy(c->v, v, (size_t)count * sizeof(float));
+}
+
+void GlCmdUniformInt(GlCmdBuffer* buf, unsigned int program, int loc, int value)
+{
+    GlCmdUniformI* c = GlCmdPush(buf, GL_CMD_UNIFORM_I, sizeof(*c));
+    if (!c) return;
+    c->program = program;
+    c->loc = loc;
+    c->value = value;
+}
+
+void GlCmdUniformMatrix4(GlCmdBuffer* buf, unsigned int program, int loc, const float m[16])
+{
+    GlCmdUniformMat4* c = GlCmdPush(buf, GL_CMD_UNIFORM_MAT4, sizeof(*c));
+    if (!c) return;
+    c->program = program;
+    c->loc = loc;
+    memcpy(c->m, m, sizeof(c->m));
+}
+
+void GlCmdBindTexture2D(GlCmdBuffer* buf, unsigned int program, int loc, int slot, unsigned int texture)
+{
+    GlCmdBindTexture* c = GlCmdPush(buf, GL_CMD_BIND_TEXTURE, sizeof(*c));
+    if (!c) return;
+    c->program = program;
+    c->loc = loc;
+    c->slot = slot;
+    c->texture = texture;
+}
+
+void GlCmdDeleteObjects(GlCmdBuffer* buf, int kind, const unsigned int* names, int count)
+{
+    GlCmdDeleteList* c = GlCmdPush(buf, GL_CMD_DELETE_OBJECTS, sizeof(*c) + (size_t)count * sizeof(unsigned int));
+    if (!c) return;
+    c->kind = (uint32_t)kind;
+    c->count = (uint32_t)count;
+    memcpy(c + 1, names, (size_t)count * sizeof(unsigned int));
+}
+
+void GlCmdBufferData(GlCmdBuffer* buf, unsigned int buffer, size_t offset, const void* data, size_t size)
+{
+    GlCmdBufferRange* c = GlCmdPush(buf, GL_CMD_BUFFER_DATA, sizeof(*c) + size);
+    if (!c) return;
+    c->buffer = buffer;
+    c->offset = offset;
+    c->size = size;
+    memcpy(c + 1, data, size);
+}
+
+void GlCmdWaitFence(GlCmdBuffer* buf, void* sync)
+{
+    GlCmdFence* c = GlCmdPush(buf, GL_CMD_WAIT_FENCE, sizeof(*c));
+    if (c) c->sync = (uint64_t)(uintptr_t)sync;
+}
+
+void GlCmdDispatchCompute(GlCmdBuffer* buf, const GlCmdDispatch* dispatch)
+{
+    GlCmdDispatch* c = GlCmdPush(buf, GL_CMD_DISPATCH, sizeof(*c));
+    if (c) *c = *dispatch;
+}
+
+void GlCmdDispatchComputeIndirect(GlCmdBuffer* buf, const GlCmdDispatchIndirect* dispatch)
+{
+    GlCmdDispatchIndirect* c = GlCmdPush(buf, GL_CMD_DISPATCH_INDIRECT, sizeof(*c));
+    if (c) *c = *dispatch;
+}
+
+void GlCmdBindStorageBuffer(GlCmdBuffer* buf, const GlCmdBindStorage* bind)
+{
+    GlCmdBindStorage* c = GlCmdPush(buf, GL_CMD_BIND_STORAGE, sizeof(*c));
+    if (c) *c = *bind;
+}
+
+void GlCmdBindImageTexture(GlCmdBuffer* buf, const GlCmdBindImage* bind)
+{
+    GlCmdBindImage* c = GlCmdPush(buf, GL_CMD_BIND_IMAGE, sizeof(*c));
+    if (c) *c = *bind;
+}
+
+void GlCmdMemoryBarrier(GlCmdBuffer* buf, uint32_t bits)
+{
+    GlCmdBarrier* c = GlCmdPush(buf, GL_CMD_MEMORY_BARRIER, sizeof(*c));
+    if (c) c->bits = bits;
+}
+
+void GlCmdMultiDrawElementsIndirect(GlCmdBuffer* buf, const GlCmdMultiDrawIndirect* draw)
+{
+    GlCmdMultiDrawIndirect* c = GlCmdPush(buf, GL_CMD_MULTI_DRAW_INDIRECT, sizeof(*c));
+    if (c) *c = *draw;
+}
+
+void GlCmdReplay(const unsigned char* data, size_t size)
+{
+    size_t offset = 0;
+    while (offset + sizeof(GlCmdHeader) <= size)
+    {
+        const GlCmdHeader* header = (const GlCmdHeader*)(data + offset);
+        const void* payload = header + 1;
+        if (header->size < sizeof(GlCmdHeader) || offset + header->size > size) break;
+        offset += header->size;
+
+        switch ((GlCmdOp)header->op)
+        {
+        case GL_CMD_BEGIN_FRAME:
+        {
+            GlExecBeginFrame(payload);
+            break;
+        }
+        case GL_CMD_END_FRAME:
+            GlExecEndFrame();
+            break;
+        case GL_CMD_CLEAR:
+        {
+            const GlCmdClearColor* c = payload;
+            glClearColor(c->color[0], c->color[1], c->color[2], c->color[3]);
+            glClear(GL_COLOR_BUFFER_BIT);
+            break;
+        }
+        case GL_CMD_DRAW_FULLSCREEN:
+            if (G_State.gl_s)
+            {
+                glBindVertexArray(G_State.gl_s->fullscreen_vao);
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+            }
+            break;
+        case GL_CMD_USE_PROGRAM:
+            GlBindProgram(((const GlCmdObject*)payload)->id);
+            break;
+        case GL_CMD_UNIFORM_F:
+        {
+            const GlCmdUniformF* c = payload;
+            GlBindProgram(c->program);
+            switch (c->count)
+            {
+            case 1: glUniform1fv(c->loc, 1, c->v); break;
+            case 2: glUniform2fv(c->loc, 1, c->v); break;
+            case 3: glUniform3fv(c->loc, 1, c->v); break;
+            default: glUniform4fv(c->loc, 1, c->v); break;
+            }
+            break;
+        }
+        case GL_CMD_UNIFORM_I:
+        {
+            const GlCmdUniformI* c = payload;
+            GlBindProgram(c->program);
+            glUniform1i(c->loc, c->value);
+            break;
+        }
+        case GL_CMD_UNIFORM_MAT4:
+        {
+            const GlCmdUniformMat4* c = payload;
+            GlBindProgram(c->program);
+            glUniformMatrix4fv(c->loc, 1, GL_FALSE, c->m);
+            break;
+        }
+        case GL_CMD_BIND_TEXTURE:
+        {
+            const GlCmdBindTexture* c = payload;
+            GlBindProgram(c->program);
+            glUniform1i(c->loc, c->slot);
+            glActiveTexture(GL_TEXTURE0 + (unsigned int)c->slot);
+            glBindTexture(GL_TEXTURE_2D, c->texture);
+            break;
+        }
+        case GL_CMD_DELETE_OBJECTS:
+        {
+            const GlCmdDeleteList* c = payload;
+            GlExecDeleteObjects((int)c->kind, (const unsigned int*)(c + 1), (int)c->count);
+            break;
+        }
+        case GL_CMD_BUFFER_DATA:
+        {
+            const GlCmdBufferRange* c = payload;
+            glBindBuffer(GL_COPY_WRITE_BUFFER, c->buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)c->offset, (GLsizeiptr)c->size, c + 1);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            break;
+        }
+        case GL_CMD_WAIT_FENCE:
+        {
+            GLsync sync = (GLsync)(uintptr_t)((const GlCmdFence*)payload)->sync;
+            glWaitSync(sync, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(sync);
+            break;
+        }
+        case GL_CMD_DISPATCH:
+            GlExecDispatch(payload);
+            break;
+        case GL_CMD_DISPATCH_INDIRECT:
+            GlExecDispatchIndirect(payload);
+            break;
+        case GL_CMD_BIND_STORAGE:
+            GlExecBindStorage(payload);
+            break;
+        case GL_CMD_BIND_IMAGE:
+            GlExecBindImage(payload);
+            break;
+        case GL_CMD_MEMORY_BARRIER:
+            glMemoryBarrier(((const GlCmdBarrier*)payload)->bits);
+            break;
+        case GL_CMD_MULTI_DRAW_INDIRECT:
+            GlExecMultiDrawIndirect(payload);
+            break;
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include "Graphics/guli_compute.h"
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/OpenGL/guli_gl_shader.h"
+
+#include <glad/glad.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL compute: dispatch, storage/image bindings and barriers. Each call either
+ * records a command (render-thread mode) or runs the same GlExec* path directly.
+ * ----------------------------------------------------------------------------- */
+
+static void GlComputeSupportedInvoke(void* arg)
+{
+    *(int*)arg = GLAD_GL_VERSION_4_3 ? 1 : 0;
+}
+
+int GuliComputeIsSupported(void)
+{
+    int supported = 0;
+    if (GlRenderThreadIsRemote()) GlRenderThreadInvoke(GlComputeSupportedInvoke, &supported);
+    else GlComputeSupportedInvoke(&supported);
+    return supported;
+}
+
+GuliShader* GuliShaderLoadCompute(const char* csCode)
+{
+    return GlShaderLoadCompute(csCode);
+}
+
+GuliShader* GuliShaderLoadComputeFromFile(const char* path)
+{
+    return GlShaderLoadComputeFromFile(path);
+}
+
+int GuliComputeGetLocalSize(const GuliShader* shader, int size[3])
+{
+    return GlShaderGetLocalSize(shader, size);
+}
+
+/* -----------------------------------------------------------------------------
+ * Execution (direct calls and command replay)
+ * ----------------------------------------------------------------------------- */
+
+void GlExecDispatch(const GlCmdDispatch* dispatch)
+{
+    GlBindProgram(dispatch->program);
+    glDispatchCompute(dispatch->x, dispatch->y, dispatch->z);
+}
+
+void GlExecDispatchIndirect(const GlCmdDispatchIndirect* dispatch)
+{
+    GlBindProgram(dispatch->program);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, dispatch->buffer);
+    glDispatchComputeIndirect((GLintptr)dispatch->offset);
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+}
+
+void GlExecBindStorage(const GlCmdBindStorage* bind)
+{
+    if (bind->buffer && bind->size)
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, bind->binding, bind->buffer,
+            (GLintptr)bind->offset, (GLsizeiptr)bind->size);
+    else
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bind->binding, bind->buffer);
+}
+
+void GlExecBindImage(const GlCmdBindImage* bind)
+{
+    glBindImageTexture(bind->unit, bind->texture, bind->level, GL_FALSE, 0, bind->access, bind->format);
+}
+
+/* -----------------------------------------------------------------------------
+ * Public API
+ * ----------------------------------------------------------------------------- */
+
+static const GLbitfield k_barrier_bits[] = {
+    GL_SHADER_STORAGE_BARRIER_BIT,
+    GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+    GL_TEXTURE_FETCH_BARRIER_BIT,
+    GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT,
+    GL_COMMAND_BARRIER_BIT,
+    GL_UNIFORM_BARRIER_BIT,
+    GL_BUFFER_UPDATE_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT,
+    GL_FRAMEBUFFER_BARRIER_BIT,
+};
+
+/* The compute entry points are NULL below GL 4.3: refuse instead of calling them */
+static int GlComputeRequire(const char* what)
+{
+    if (GuliComputeIsSupported()) return 1;
+    GULI_PRINT_ERROR(GULI_ERROR_FAILED, what);
+    return 0;
+}
+
+/* Only a compute program can be dispatched, and one only links on GL 4.3 */
+static unsigned int GlComputeProgram(const GuliShader* shader)
+{
+    int local[3];
+    if (!GlShaderGetLocalSize(shader, local))
+    {
+        if (shader) GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Dispatch requires a compute shader");
+        return 0;
+    }
+    return GlShaderGetProgram(shader);
+}
+
+static GLbitfield GlBarrierBits(uint32_t bits)
+{
+    if (bits == GULI_BARRIER_ALL) return GL_ALL_BARRIER_BITS;
+    GLbitfield gl = 0;
+    for (uint32_t i = 0; i < sizeof(k_barrier_bits) / sizeof(k_barrier_bits[0]); i++)
+        if (bits & (1u << i)) gl |= k_barrier_bits[i];
+    return gl;
+}
+
+void GuliComputeDispatch(GuliShader* shader, uint32_t groups_x, uint32_t groups_y, uint32_t groups_z)
+{
+    const unsigned int program = GlComputeProgram(shader);
+    if (!program || !groups_x || !groups_y || !groups_z) return;
+
+    const GlCmdDispatch dispatch = { program, groups_x, groups_y, groups_z };
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdDispatchCompute(cmd, &dispatch);
+    else GlExecDispatch(&dispatch);
+}
+
+void GuliComputeDispatchForSize(GuliShader* shader, uint32_t width, uint32_t height, uint32_t depth)
+{
+    int local[3];
+    if (!GlShaderGetLocalSize(shader, local)) return;
+    GuliComputeDispatch(shader,
+        (width + (uint32_t)local[0] - 1) / (uint32_t)local[0],
+        (height + (uint32_t)local[1] - 1) / (uint32_t)local[1],
+        (depth + (uint32_t)local[2] - 1) / (uint32_t)local[2]);
+}
+
+void GuliComputeDispatchIndirect(GuliShader* shader, GuliBuffer* buffer, size_t offset)
+{
+    const unsigned int program = GlComputeProgram(shader);
+    if (!program || !buffer || !buffer->_backend) return;
+    if ((offset & 3) || offset + 3 * sizeof(uint32_t) > buffer->size)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Indirect dispatch arguments out of range or misaligned");
+        return;
+    }
+
+    const GlCmdDispatchIndirect dispatch = { program, (unsigned int)(uintptr_t)buffer->_backend, offset };
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdDispatchComputeIndirect(cmd, &dispatch);
+    else GlExecDispatchIndirect(&dispatch);
+}
+
+void GuliComputeBindStorageBuffer(uint32_t binding, GuliBuffer* buffer, size_t offset, size_t size)
+{
+    if (!GlComputeRequire("Storage buffers require OpenGL 4.3 (GULI_CONTEXT_COMPUTE)")) return;
+
+    GlCmdBindStorage bind = { 0, binding, 0, 0 };
+    if (buffer && buffer->_backend)
+    {
+        if (offset >= buffer->size || (size && offset + size > buffer->size))
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Storage buffer range out of bounds");
+            return;
+        }
+        bind.buffer = (unsigned int)(uintptr_t)buffer->_backend;
+        bind.offset = offset;
+        bind.size = (offset || size) ? (size ? size : buffer->size - offset) : 0;
+    }
+
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdBindStorageBuffer(cmd, &bind);
+    else GlExecBindStorage(&bind);
+}
+
+void GuliComputeBindImage(uint32_t unit, GuliTexture* texture, int level, GuliImageAccess access)
+{
+    static const GLenum k_access[] = { GL_READ_ONLY, GL_WRITE_ONLY, GL_READ_WRITE };
+    if ((unsigned int)access > GULI_IMAGE_READ_WRITE || level < 0) return;
+    if (!GlComputeRequire("Image bindings require OpenGL 4.3 (GULI_CONTEXT_COMPUTE)")) return;
+
+    const GlCmdBindImage bind = {
+        (texture && texture->_backend) ? (unsigned int)(uintptr_t)texture->_backend : 0,
+        unit, level, k_access[access], GL_RGBA8,
+    };
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdBindImageTexture(cmd, &bind);
+    else GlExecBindImage(&bind);
+}
+
+void GuliComputeMemoryBarrier(uint32_t bits)
+{
+    const GLbitfield gl = GlBarrierBits(bits);
+    if (!gl) return;
+    if (!GlComputeRequire("Memory barriers require OpenGL 4.3 (GULI_CONTEXT_COMPUTE)")) return;
+
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdMemoryBarrier(cmd, gl);
+    else glMemoryBarrier(gl);
+}
@@ -0,0 +1,187 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#if defined(__linux__)
+#define GLFW_EXPOSE_NATIVE_EGL
+#include <GLFW/glfw3native.h>
+#include <EGL/eglext.h>
+#define GL_DAMAGE_EGL 1
+#endif
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Partial redraw. A frame with damage rects is scissored to their bounds plus
+ * whatever changed since the back buffer was last presented (EGL_EXT_buffer_age),
+ * then presented with EGL_KHR/EXT_swap_buffers_with_damage when available.
+ * Without a known buffer age the back buffer contents are undefined, so the
+ * frame is redrawn in full.
+ * ----------------------------------------------------------------------------- */
+
+#define GL_DAMAGE_HISTORY 4  /* buffer ages beyond this redraw in full */
+
+#ifdef GL_DAMAGE_EGL
+typedef EGLBoolean (EGLAPIENTRYP GlEglQuerySurfaceFn)(EGLDisplay, EGLSurface, EGLint, EGLint*);
+typedef const char* (EGLAPIENTRYP GlEglQueryStringFn)(EGLDisplay, EGLint);
+typedef EGLBoolean (EGLAPIENTRYP GlEglSwapWithDamageFn)(EGLDisplay, EGLSurface, const EGLint*, EGLint);
+#endif
+
+struct GlDamage {
+    int probed;
+    int buffer_age;                     /* EGL_EXT_buffer_age usable */
+#ifdef GL_DAMAGE_EGL
+    EGLDisplay display;
+    EGLSurface surface;
+    GlEglQuerySurfaceFn query_surface;
+    GlEglSwapWithDamageFn swap_with_damage;
+    EGLint rects[GULI_MAX_DIRTY_RECTS * 4];  /* this frame's damage, bottom-left origin */
+#endif
+    int rect_count;
+    int partial;                        /* current frame is scissored */
+    GuliRect bounds;                    /* union of this frame's damage */
+    GuliRect history[GL_DAMAGE_HISTORY];  /* bounds of the previous frames, newest first */
+    int history_count;
+};
+
+#ifdef GL_DAMAGE_EGL
+/* Whole-token match in a space-separated extension string. */
+static int GlDamageHasExtension(const char* list, const char* name)
+{
+    const size_t len = strlen(name);
+    for (const char* p = list; p && (p = strstr(p, name)); p += len)
+    {
+        if ((p == list || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0'))
+            return 1;
+    }
+    return 0;
+}
+#endif
+
+/* Resolve the EGL entry points once, on the thread owning the context. */
+static void GlDamageProbe(struct GlDamage* d)
+{
+    d->probed = 1;
+#ifdef GL_DAMAGE_EGL
+    if (glfwGetWindowAttrib(G_State.window, GLFW_CONTEXT_CREATION_API) != GLFW_EGL_CONTEXT_API)
+        return;
+
+    d->display = glfwGetEGLDisplay();
+    d->surface = glfwGetEGLSurface(G_State.window);
+    GlEglQueryStringFn query_string = (GlEglQueryStringFn)glfwGetProcAddress("eglQueryString");
+    d->query_surface = (GlEglQuerySurfaceFn)glfwGetProcAddress("eglQuerySurface");
+    if (d->display == EGL_NO_DISPLAY || d->surface == EGL_NO_SURFACE || !query_string || !d->query_surface)
+        return;
+
+    const char* extensions = query_string(d->display, EGL_EXTENSIONS);
+    d->buffer_age = GlDamageHasExtension(extensions, "EGL_EXT_buffer_age");
+    if (GlDamageHasExtension(extensions, "EGL_KHR_swap_buffers_with_damage"))
+        d->swap_with_damage = (GlEglSwapWithDamageFn)glfwGetProcAddress("eglSwapBuffersWithDamageKHR");
+    else if (GlDamageHasExtension(extensions, "EGL_EXT_swap_buffers_with_damage"))
+        d->swap_with_damage = (GlEglSwapWithDamageFn)glfwGetProcAddress("eglSwapBuffersWithDamageEXT");
+#endif
+}
+
+static GuliRect GlDamageUnion(GuliRect a, GuliRect b)
+{
+    const int x0 = a.x < b.x ? a.x : b.x;
+    const int y0 = a.y < b.y ? a.y : b.y;
+    const int x1 = (a.x + a.width > b.x + b.width) ? a.x + a.width : b.x + b.width;
+    const int y1 = (a.y + a.height > b.y + b.height) ? a.y + a.height : b.y + b.height;
+    return (GuliRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+/* Age of the back buffer in frames: 0 when unknown (contents undefined). */
+static int GlDamageBufferAge(struct GlDamage* d)
+{
+#ifdef GL_DAMAGE_EGL
+    EGLint age = 0;
+    if (d->buffer_age && d->query_surface(d->display, d->surface, EGL_BUFFER_AGE_EXT, &age))
+        return (int)age;
+#else
+    (void)d;
+#endif
+    return 0;
+}
+
+void GlDamageBeginFrame(const GlCmdFrame* frame)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return;
+
+    struct GlDamage* d = gl->damage;
+    if (!d)
+    {
+        /* Full frames need no tracking until the first partial one. */
+        if (!frame->damage_count) return;
+        d = gl->damage = GuliCalloc(1, sizeof(struct GlDamage));
+        if (!d)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate damage state");
+            return;
+        }
+    }
+    if (!d->probed) GlDamageProbe(d);
+
+    d->partial = 0;
+    d->rect_count = 0;
+    d->bounds = (GuliRect){ 0, 0, frame->width, frame->height };
+    if (!frame->damage_count) return;
+
+    /* The back buffer misses every change presented since it was last used. */
+    const int age = GlDamageBufferAge(d);
+    if (age <= 0 || age - 1 > d->history_count) return;
+
+    GuliRect bounds = frame->damage[0];
+    for (int i = 1; i < frame->damage_count; i++)
+        bounds = GlDamageUnion(bounds, frame->damage[i]);
+    d->bounds = bounds;
+    for (int i = 0; i < age - 1; i++)
+        bounds = GlDamageUnion(bounds, d->history[i]);
+
+#ifdef GL_DAMAGE_EGL
+    for (int i = 0; i < frame->damage_count; i++)
+    {
+        const GuliRect r = frame->damage[i];
+        d->rects[i * 4 + 0] = r.x;
+        d->rects[i * 4 + 1] = frame->height - r.y - r.height;
+        d->rects[i * 4 + 2] = r.width;
+        d->rects[i * 4 + 3] = r.height;
+    }
+#endif
+    d->rect_count = frame->damage_count;
+    d->partial = 1;
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(bounds.x, frame->height - bounds.y - bounds.height, bounds.width, bounds.height);
+}
+
+int GlDamageSwap(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlDamage* d = gl ? gl->damage : NULL;
+    if (!d) return 0;
+
+    if (d->partial) glDisable(GL_SCISSOR_TEST);
+
+    memmove(d->history + 1, d->history, (GL_DAMAGE_HISTORY - 1) * sizeof(GuliRect));
+    d->history[0] = d->bounds;
+    if (d->history_count < GL_DAMAGE_HISTORY) d->history_count++;
+
+    int swapped = 0;
+#ifdef GL_DAMAGE_EGL
+    if (d->partial && d->swap_with_damage)
+        swapped = d->swap_with_damage(d->display, d->surface, d->rects, d->rect_count) ? 1 : 0;
+#endif
+    d->partial = 0;
+    return swapped;
+}
+
+void GlDamageFree(struct GLState* gl)
+{
+    if (!gl) return;
+    GuliFree(gl->damage);
+    gl->damage = NULL;
+}
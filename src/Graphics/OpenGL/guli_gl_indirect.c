@@ -0,0 +1,324 @@
+#include "Graphics/guli_indirect.h"
+#include "Graphics/guli_compute.h"
+#include "Graphics/guli_shader_preprocess.h"
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/OpenGL/guli_gl_shader.h"
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <math.h>
+#include <stdio.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL GPU-driven drawing: frustum-culling compute pass writing
+ * DrawElementsIndirectCommands, submitted with one multi-draw
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t count;
+    uint32_t instance_count;
+    uint32_t first_index;
+    int32_t base_vertex;
+    uint32_t base_instance;
+} GlDrawElementsIndirectCommand;
+
+typedef void (APIENTRYP GlMultiDrawIndirectCountFn)(GLenum mode, GLenum type, const void* indirect,
+    GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride);
+
+/* Commands land at the object's index, or (GULI_CULL_COMPACT) packed at an atomic counter */
+static const char* cull_cs_glsl =
+    "layout(local_size_x = 64) in;\n"
+    "struct Object { vec4 sphere; uint mesh; uint pad0, pad1, pad2; };\n"
+    "struct Mesh { uint count; uint first_index; int base_vertex; uint pad; };\n"
+    "struct Command { uint count; uint instance_count; uint first_index; int base_vertex; uint base_instance; };\n"
+    "layout(std430, binding = 0) readonly buffer Objects { Object objects[]; };\n"
+    "layout(std430, binding = 1) readonly buffer Meshes { Mesh meshes[]; };\n"
+    "layout(std430, binding = 2) writeonly buffer Commands { Command commands[]; };\n"
+    "#ifdef GULI_CULL_COMPACT\n"
+    "layout(std430, binding = 3) buffer DrawCount { uint draw_count; };\n"
+    "#endif\n"
+    "uniform vec4 u_planes[6];\n"
+    "uniform int u_object_count;\n"
+    "void main() {\n"
+    "    uint i = gl_GlobalInvocationID.x;\n"
+    "    if (i >= uint(u_object_count)) return;\n"
+    "    Object o = objects[i];\n"
+    "    bool visible = true;\n"
+    "    for (int p = 0; p < 6; p++)\n"
+    "        visible = visible && dot(u_planes[p].xyz, o.sphere.xyz) + u_planes[p].w >= -o.sphere.w;\n"
+    "    Mesh m = meshes[o.mesh];\n"
+    "#ifdef GULI_CULL_COMPACT\n"
+    "    if (!visible) return;\n"
+    "    uint slot = atomicAdd(draw_count, 1u);\n"
+    "#else\n"
+    "    uint slot = i;\n"
+    "#endif\n"
+    "    commands[slot] = Command(m.count, visible ? 1u : 0u, m.first_index, m.base_vertex, i);\n"
+    "}\n";
+
+struct GuliIndirectScene {
+    GuliShader* cull;
+    int plane_locs[6];
+    int count_loc;
+    unsigned int vao;
+    GuliBuffer* objects;     /* GuliIndirectObject per object */
+    GuliBuffer* meshes;      /* GuliIndirectMesh per mesh */
+    GuliBuffer* commands;    /* GlDrawElementsIndirectCommand per object */
+    GuliBuffer* draw_count;  /* uint32 written by the cull; NULL without indirect parameters */
+    GuliBuffer* draw_ids;    /* 0..max_objects-1, the per-instance draw ID */
+    uint32_t mesh_count;
+    uint32_t max_objects;
+    uint32_t object_count;
+    int culled;
+};
+
+static GlMultiDrawIndirectCountFn GlIndirectCountFn(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return NULL;
+    if (!gl->indirect_count_probed)
+    {
+        gl->indirect_count_probed = 1;
+        gl->multi_draw_indirect_count = NULL;
+        if (GLAD_GL_VERSION_4_6 && glMultiDrawElementsIndirectCount)
+            gl->multi_draw_indirect_count = (void (*)(void))glMultiDrawElementsIndirectCount;
+        else if (glfwExtensionSupported("GL_ARB_indirect_parameters"))
+            gl->multi_draw_indirect_count = (void (*)(void))glfwGetProcAddress("glMultiDrawElementsIndirectCountARB");
+    }
+    return (GlMultiDrawIndirectCountFn)gl->multi_draw_indirect_count;
+}
+
+void GlExecMultiDrawIndirect(const GlCmdMultiDrawIndirect* draw)
+{
+    GlBindProgram(draw->program);
+    glBindVertexArray(draw->vao);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, draw->commands);
+    GlMultiDrawIndirectCountFn draw_count = draw->draw_count ? GlIndirectCountFn() : NULL;
+    if (draw_count)
+    {
+        glBindBuffer(GL_PARAMETER_BUFFER, draw->draw_count);
+        draw_count(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, 0, (GLsizei)draw->max_draws, 0);
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+    }
+    else glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, (GLsizei)draw->max_draws, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+/* VAOs are per context: built where GL executes, which also probes indirect parameters */
+typedef struct {
+    GuliIndirectScene* scene;
+    const GuliIndirectSceneDesc* desc;
+    int has_draw_count;
+} GlIndirectVaoCall;
+
+static void GlIndirectVaoInvoke(void* arg)
+{
+    GlIndirectVaoCall* call = arg;
+    const GuliIndirectSceneDesc* desc = call->desc;
+    call->has_draw_count = GlIndirectCountFn() != NULL;
+
+    unsigned int vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, (unsigned int)(uintptr_t)desc->vertices->_backend);
+    for (int i = 0; i < desc->attribute_count; i++)
+    {
+        const GuliVertexAttribute* a = &desc->attributes[i];
+        glEnableVertexAttribArray(a->location);
+        glVertexAttribPointer(a->location, (GLint)a->components, GL_FLOAT, GL_FALSE, (GLsizei)desc->stride,
+            (const void*)(uintptr_t)a->offset);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, (unsigned int)(uintptr_t)call->scene->draw_ids->_backend);
+    glEnableVertexAttribArray(GULI_INDIRECT_DRAW_ID_LOCATION);
+    glVertexAttribIPointer(GULI_INDIRECT_DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, 0, NULL);
+    glVertexAttribDivisor(GULI_INDIRECT_DRAW_ID_LOCATION, 1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (unsigned int)(uintptr_t)desc->indices->_backend);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    call->scene->vao = vao;
+}
+
+static int GlIndirectDescValid(const GuliIndirectSceneDesc* desc)
+{
+    if (!desc || !GuliBufferIsValid(desc->vertices) || !GuliBufferIsValid(desc->indices) || !desc->stride
+        || !desc->meshes || !desc->mesh_count || !desc->max_objects
+        || desc->attribute_count < 0 || (desc->attribute_count && !desc->attributes))
+        return 0;
+    for (int i = 0; i < desc->attribute_count; i++)
+    {
+        const GuliVertexAttribute* a = &desc->attributes[i];
+        if (a->location >= GULI_INDIRECT_DRAW_ID_LOCATION || a->components < 1 || a->components > 4) return 0;
+    }
+    return 1;
+}
+
+GuliIndirectScene* GuliIndirectSceneCreate(const GuliIndirectSceneDesc* desc)
+{
+    if (!GlIndirectDescValid(desc))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Invalid indirect scene description");
+        return NULL;
+    }
+    if (!GuliComputeIsSupported())
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GPU-driven drawing needs an OpenGL 4.3 context");
+        return NULL;
+    }
+
+    GuliIndirectScene* scene = GuliCalloc(1, sizeof(*scene));
+    uint32_t* ids = GuliMalloc((size_t)desc->max_objects * sizeof(uint32_t));
+    if (!scene || !ids)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate indirect scene");
+        GuliFree(scene);
+        GuliFree(ids);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < desc->max_objects; i++)
+        ids[i] = i;
+
+    scene->mesh_count = desc->mesh_count;
+    scene->max_objects = desc->max_objects;
+    scene->objects = GuliBufferCreate(GULI_BUFFER_STORAGE, NULL, (size_t)desc->max_objects * sizeof(GuliIndirectObject));
+    scene->meshes = GuliBufferCreate(GULI_BUFFER_STORAGE, desc->meshes, (size_t)desc->mesh_count * sizeof(GuliIndirectMesh));
+    scene->commands = GuliBufferCreate(GULI_BUFFER_STORAGE, NULL,
+        (size_t)desc->max_objects * sizeof(GlDrawElementsIndirectCommand));
+    scene->draw_ids = GuliBufferCreate(GULI_BUFFER_VERTEX, ids, (size_t)desc->max_objects * sizeof(uint32_t));
+    GuliFree(ids);
+    if (!scene->objects || !scene->meshes || !scene->commands || !scene->draw_ids)
+    {
+        GuliIndirectSceneDestroy(scene);
+        return NULL;
+    }
+
+    GlIndirectVaoCall call = { scene, desc, 0 };
+    if (GlRenderThreadIsRemote()) GlRenderThreadInvoke(GlIndirectVaoInvoke, &call);
+    else GlIndirectVaoInvoke(&call);
+
+    const uint32_t zero = 0;
+    const GuliShaderDefine compact = { "GULI_CULL_COMPACT", NULL };
+    if (call.has_draw_count)
+        scene->draw_count = GuliBufferCreate(GULI_BUFFER_STORAGE, &zero, sizeof(zero));
+    char* source = GuliShaderPreprocessSource(cull_cs_glsl, NULL, "430 core", &compact, scene->draw_count ? 1 : 0);
+    scene->cull = source ? GlShaderLoadCompute(source) : NULL;
+    GuliFree(source);
+    if (!scene->vao || !scene->cull || (call.has_draw_count && !scene->draw_count))
+    {
+        GuliIndirectSceneDestroy(scene);
+        return NULL;
+    }
+
+    char name[16];
+    for (int i = 0; i < 6; i++)
+    {
+        snprintf(name, sizeof(name), "u_planes[%d]", i);
+        scene->plane_locs[i] = GlShaderGetLocation(scene->cull, name);
+    }
+    scene->count_loc = GlShaderGetLocation(scene->cull, "u_object_count");
+    GlShaderSetName(scene->cull, "guli_indirect_cull");
+    return scene;
+}
+
+void GuliIndirectSceneDestroy(GuliIndirectScene* scene)
+{
+    if (!scene) return;
+    /* Recorded frames may still draw from the scene: everything goes through retirement */
+    if (scene->cull) GlShaderUnload(scene->cull);
+    if (scene->vao) GlRetireObject(GL_RETIRE_VERTEX_ARRAY, scene->vao, NULL, GULI_HANDLE_NULL);
+    GuliBufferUnload(scene->objects);
+    GuliBufferUnload(scene->meshes);
+    GuliBufferUnload(scene->commands);
+    GuliBufferUnload(scene->draw_count);
+    GuliBufferUnload(scene->draw_ids);
+    GuliFree(scene);
+}
+
+int GuliIndirectSceneSetObjects(GuliIndirectScene* scene, uint32_t first, const GuliIndirectObject* objects, uint32_t count)
+{
+    if (!scene || !objects || first > scene->max_objects || count > scene->max_objects - first) return 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (objects[i].mesh >= scene->mesh_count)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Indirect object refers to a mesh out of range");
+            return 0;
+        }
+    }
+    if (count)
+        GuliBufferUpdate(scene->objects, (size_t)first * sizeof(GuliIndirectObject), objects,
+            (size_t)count * sizeof(GuliIndirectObject));
+    return 1;
+}
+
+void GuliIndirectSceneSetObjectCount(GuliIndirectScene* scene, uint32_t count)
+{
+    if (!scene) return;
+    scene->object_count = count < scene->max_objects ? count : scene->max_objects;
+    scene->culled = 0;
+}
+
+/* Gribb-Hartmann planes from a column-major matrix, normalized so distances are in world units */
+static void GlFrustumPlanes(const float m[16], float planes[6][4])
+{
+    for (int i = 0; i < 6; i++)
+    {
+        const int row = i / 2;
+        const float sign = (i & 1) ? -1.0f : 1.0f;
+        for (int c = 0; c < 4; c++)
+            planes[i][c] = m[c * 4 + 3] + sign * m[c * 4 + row];
+        const float len = sqrtf(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+        if (len > 0.0f)
+            for (int c = 0; c < 4; c++)
+                planes[i][c] /= len;
+    }
+}
+
+void GuliIndirectSceneCull(GuliIndirectScene* scene, const float view_proj[16])
+{
+    if (!scene || !view_proj) return;
+    scene->culled = 1;
+    if (!scene->object_count) return;
+
+    float planes[6][4];
+    GlFrustumPlanes(view_proj, planes);
+    for (int i = 0; i < 6; i++)
+        GlShaderSetVec4(scene->cull, scene->plane_locs[i], planes[i]);
+    GlShaderSetInt(scene->cull, scene->count_loc, (int)scene->object_count);
+
+    if (scene->draw_count)
+    {
+        const uint32_t zero = 0;
+        GuliBufferUpdate(scene->draw_count, 0, &zero, sizeof(zero));
+        GuliComputeBindStorageBuffer(3, scene->draw_count, 0, 0);
+    }
+    GuliComputeBindStorageBuffer(0, scene->objects, 0, 0);
+    GuliComputeBindStorageBuffer(1, scene->meshes, 0, 0);
+    GuliComputeBindStorageBuffer(2, scene->commands, 0, 0);
+    GuliComputeDispatch(scene->cull,
+        (scene->object_count + GULI_INDIRECT_CULL_GROUP_SIZE - 1) / GULI_INDIRECT_CULL_GROUP_SIZE, 1, 1);
+    GuliComputeMemoryBarrier(GULI_BARRIER_COMMAND);
+}
+
+void GuliIndirectSceneDraw(GuliIndirectScene* scene, GuliShader* shader)
+{
+    const unsigned int program = GlShaderGetProgram(shader);
+    if (!scene || !program || !scene->culled || !scene->object_count) return;
+
+    const GlCmdMultiDrawIndirect draw = {
+        program,
+        scene->vao,
+        (unsigned int)(uintptr_t)scene->commands->_backend,
+        scene->draw_count ? (unsigned int)(uintptr_t)scene->draw_count->_backend : 0,
+        scene->object_count,
+    };
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdMultiDrawElementsIndirect(cmd, &draw);
+    else GlExecMultiDrawIndirect(&draw);
+}
+
+int GuliIndirectSceneHasDrawCount(const GuliIndirectScene* scene)
+{
+    return (scene && scene->draw_count) ? 1 : 0;
+}
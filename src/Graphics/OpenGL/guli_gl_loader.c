@@ -0,0 +1,435 @@
+#include "Graphics/guli_loader.h"
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/OpenGL/guli_gl_shader.h"
+#include "Core/guli_thread.h"
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL loader thread: hidden shared-context window, FIFO of uploads, fence
+ * handoff to the drawing context
+ * ----------------------------------------------------------------------------- */
+
+#define GL_UPLOAD_MAX_LEVELS 16
+
+typedef enum {
+    GL_UPLOAD_TEXTURE,
+    GL_UPLOAD_SHADER,
+    GL_UPLOAD_BUFFER,
+} GlUploadKind;
+
+typedef enum {
+    GL_UPLOAD_QUEUED = 0,
+    GL_UPLOAD_LOADED,  /* created on the loader; fence pending */
+    GL_UPLOAD_READY,
+    GL_UPLOAD_FAILED,
+} GlUploadState;
+
+struct GuliUpload {
+    GlUploadKind kind;
+    atomic_int state;
+    atomic_int refs;  /* caller + loader while queued */
+
+    int width, height, levels;
+    const unsigned char* pixels[GL_UPLOAD_MAX_LEVELS];
+    char* vs;
+    char* fs;
+    GuliBufferType buffer_type;
+    const void* data;
+    size_t size;
+
+    GuliTexture* texture;
+    GuliShader* shader;
+    GuliBuffer* buffer;
+    GLsync fence;
+
+    GuliUpload* next;
+};
+
+struct GlLoader {
+    GuliState* context;  /* state whose GL context the loader shares with */
+    GLFWwindow* window;
+    GuliThread thread;
+    GuliMutex lock;
+    GuliCond wake;  /* loader: upload queued or quit */
+    GuliCond done;  /* waiters: an upload finished */
+    GuliUpload* head;
+    GuliUpload* tail;
+    int started;    /* 1 once the shared context is current, -1 on failure */
+    int quit;
+};
+
+static struct GlLoader* GlLoaderGet(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    return gl ? gl->loader : NULL;
+}
+
+static char* GlUploadCopyString(const char* s)
+{
+    if (!s) return NULL;
+    const size_t len = strlen(s) + 1;
+    char* copy = GuliMalloc(len);
+    if (copy) memcpy(copy, s, len);
+    return copy;
+}
+
+/* Create the object on the calling thread's context (loader, or the drawing thread as fallback). */
+static void GlUploadExecute(GuliUpload* up)
+{
+    switch (up->kind)
+    {
+    case GL_UPLOAD_TEXTURE:
+        up->texture = GuliTextureCreateFromLevels(up->width, up->height, up->levels, up->pixels);
+        break;
+    case GL_UPLOAD_SHADER:
+        up->shader = GlShaderLoadFromMemory(up->vs, up->fs);
+        break;
+    case GL_UPLOAD_BUFFER:
+        up->buffer = GuliBufferCreate(up->buffer_type, up->data, up->size);
+        break;
+    }
+    GuliFree(up->vs);
+    GuliFree(up->fs);
+    up->vs = up->fs = NULL;
+}
+
+static int GlUploadHasObject(const GuliUpload* up)
+{
+    return up->texture || up->shader || up->buffer;
+}
+
+static void GlUploadDeleteFenceInvoke(void* arg)
+{
+    glDeleteSync((GLsync)arg);
+}
+
+/* Destroy an object nobody will receive, then the ticket. */
+static void GlUploadDiscard(GuliUpload* up)
+{
+    if (up->fence)
+        GlRenderThreadInvoke(GlUploadDeleteFenceInvoke, up->fence);
+    if (up->texture) GuliTextureUnload(up->texture);
+    if (up->shader) GlShaderUnload(up->shader);
+    if (up->buffer) GuliBufferUnload(up->buffer);
+    GuliFree(up->vs);
+    GuliFree(up->fs);
+    GuliFree(up);
+}
+
+static void GlUploadDropRef(GuliUpload* up)
+{
+    if (atomic_fetch_sub(&up->refs, 1) == 1)
+    {
+        if (atomic_load(&up->state) == GL_UPLOAD_READY)
+            GuliFree(up);
+        else
+            GlUploadDiscard(up);
+    }
+}
+
+static void* GlLoaderMain(void* arg)
+{
+    struct GlLoader* loader = arg;
+    G_CurrentState = (loader->context == &G_DefaultState) ? NULL : loader->context;
+    glfwMakeContextCurrent(loader->window);
+    GlRenderThreadSetContextOwner();
+
+    GuliMutexLock(&loader->lock);
+    loader->started = (glfwGetCurrentContext() == loader->window) ? 1 : -1;
+    GuliCondBroadcast(&loader->done);
+
+    while (loader->started > 0)
+    {
+        while (!loader->head && !loader->quit)
+            GuliCondWait(&loader->wake, &loader->lock);
+        if (loader->quit) break;
+
+        GuliUpload* up = loader->head;
+        loader->head = up->next;
+        if (!loader->head) loader->tail = NULL;
+        GuliMutexUnlock(&loader->lock);
+
+        /* Skip work the caller already gave up on. */
+        if (atomic_load(&up->refs) > 1)
+            GlUploadExecute(up);
+
+        int state = GL_UPLOAD_FAILED;
+        if (GlUploadHasObject(up))
+        {
+            /* Flush so the fence reaches the GPU before another context waits on it. */
+            up->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            state = GL_UPLOAD_LOADED;
+        }
+
+        GuliMutexLock(&loader->lock);
+        atomic_store(&up->state, state);
+        GuliCondBroadcast(&loader->done);
+        GuliMutexUnlock(&loader->lock);
+        GlUploadDropRef(up);
+        GuliMutexLock(&loader->lock);
+    }
+    GuliMutexUnlock(&loader->lock);
+
+    glfwMakeContextCurrent(NULL);
+    return NULL;
+}
+
+static GuliUpload* GlUploadSubmit(GuliUpload* up)
+{
+    struct GlLoader* loader = GlLoaderGet();
+    if (!loader)
+    {
+        /* No loader: create synchronously on the drawing thread. */
+        atomic_init(&up->refs, 1);
+        GlUploadExecute(up);
+        atomic_init(&up->state, GlUploadHasObject(up) ? GL_UPLOAD_READY : GL_UPLOAD_FAILED);
+        return up;
+    }
+
+    atomic_init(&up->refs, 2);
+    atomic_init(&up->state, GL_UPLOAD_QUEUED);
+    GuliMutexLock(&loader->lock);
+    if (loader->tail) loader->tail->next = up;
+    else loader->head = up;
+    loader->tail = up;
+    GuliCondSignal(&loader->wake);
+    GuliMutexUnlock(&loader->lock);
+    return up;
+}
+
+GuliUpload* GuliUploadTexture(int width, int height, int levels, const unsigned char* const* pixels)
+{
+    if (width <= 0 || height <= 0 || levels <= 0 || levels > GL_UPLOAD_MAX_LEVELS || !pixels) return NULL;
+
+    GuliUpload* up = GuliCalloc(1, sizeof(GuliUpload));
+    if (!up) return NULL;
+    up->kind = GL_UPLOAD_TEXTURE;
+    up->width = width;
+    up->height = height;
+    up->levels = levels;
+    memcpy(up->pixels, pixels, (size_t)levels * sizeof(*pixels));
+    return GlUploadSubmit(up);
+}
+
+GuliUpload* GuliUploadShader(const char* vsCode, const char* fsCode)
+{
+    GuliUpload* up = GuliCalloc(1, sizeof(GuliUpload));
+    if (!up) return NULL;
+    up->kind = GL_UPLOAD_SHADER;
+    up->vs = GlUploadCopyString(vsCode);
+    up->fs = GlUploadCopyString(fsCode);
+    if ((vsCode && !up->vs) || (fsCode && !up->fs))
+    {
+        GlUploadDiscard(up);
+        return NULL;
+    }
+    return GlUploadSubmit(up);
+}
+
+GuliUpload* GuliUploadBuffer(GuliBufferType type, const void* data, size_t size)
+{
+    if (size == 0) return NULL;
+
+    GuliUpload* up = GuliCalloc(1, sizeof(GuliUpload));
+    if (!up) return NULL;
+    up->kind = GL_UPLOAD_BUFFER;
+    up->buffer_type = type;
+    up->data = data;
+    up->size = size;
+    return GlUploadSubmit(up);
+}
+
+/* Make a LOADED upload usable on the drawing context without blocking the CPU. */
+static void GlUploadHandOff(GuliUpload* up, int block_gpu)
+{
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd)
+    {
+        /* Render-thread mode: the wait is replayed before anything recorded after it. */
+        GlCmdWaitFence(cmd, up->fence);
+    }
+    else if (block_gpu)
+    {
+        glWaitSync(up->fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(up->fence);
+    }
+    else
+    {
+        const GLenum r = glClientWaitSync(up->fence, 0, 0);
+        if (r == GL_TIMEOUT_EXPIRED) return;
+        glDeleteSync(up->fence);
+    }
+    up->fence = NULL;
+    atomic_store(&up->state, GL_UPLOAD_READY);
+}
+
+static GuliUploadStatus GlUploadStatusOf(const GuliUpload* up)
+{
+    switch (atomic_load(&up->state))
+    {
+    case GL_UPLOAD_READY: return GULI_UPLOAD_READY;
+    case GL_UPLOAD_FAILED: return GULI_UPLOAD_FAILED;
+    default: return GULI_UPLOAD_PENDING;
+    }
+}
+
+GuliUploadStatus GuliUploadPoll(GuliUpload* upload)
+{
+    if (!upload) return GULI_UPLOAD_FAILED;
+    if (atomic_load(&upload->state) == GL_UPLOAD_LOADED)
+        GlUploadHandOff(upload, 0);
+    return GlUploadStatusOf(upload);
+}
+
+GuliUploadStatus GuliUploadWait(GuliUpload* upload)
+{
+    if (!upload) return GULI_UPLOAD_FAILED;
+
+    struct GlLoader* loader = GlLoaderGet();
+    if (loader && atomic_load(&upload->state) == GL_UPLOAD_QUEUED)
+    {
+        GuliMutexLock(&loader->lock);
+        while (atomic_load(&upload->state) == GL_UPLOAD_QUEUED)
+            GuliCondWait(&loader->done, &loader->lock);
+        GuliMutexUnlock(&loader->lock);
+    }
+    if (atomic_load(&upload->state) == GL_UPLOAD_LOADED)
+        GlUploadHandOff(upload, 1);
+    return GlUploadStatusOf(upload);
+}
+
+GuliTexture* GuliUploadGetTexture(const GuliUpload* upload)
+{
+    return (upload && atomic_load(&upload->state) == GL_UPLOAD_READY) ? upload->texture : NULL;
+}
+
+GuliShader* GuliUploadGetShader(const GuliUpload* upload)
+{
+    return (upload && atomic_load(&upload->state) == GL_UPLOAD_READY) ? upload->shader : NULL;
+}
+
+GuliBuffer* GuliUploadGetBuffer(const GuliUpload* upload)
+{
+    return (upload && atomic_load(&upload->state) == GL_UPLOAD_READY) ? upload->buffer : NULL;
+}
+
+void GuliUploadRelease(GuliUpload* upload)
+{
+    if (upload) GlUploadDropRef(upload);
+}
+
+int GuliLoaderStart(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl || !G_State.window)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Loader requires an initialized OpenGL backend");
+        return 0;
+    }
+    if (gl->loader) return 1;
+    if (gl->render_thread)
+    {
+        /* Sharing requires the main context not to be current on another thread. */
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Start the loader before the render thread");
+        return 0;
+    }
+
+    struct GlLoader* loader = GuliCalloc(1, sizeof(struct GlLoader));
+    if (!loader)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate loader");
+        return 0;
+    }
+
+    loader->context = &G_State;
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    loader->window = glfwCreateWindow(1, 1, "guli loader", NULL, G_State.window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!loader->window)
+    {
+        GuliFree(loader);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create loader shared context");
+        return 0;
+    }
+
+    /* created: how many of lock, wake and done exist, so a failure destroys just those */
+    int created = 0;
+    if (GuliMutexInit(&loader->lock)) created++;
+    if (created == 1 && GuliCondInit(&loader->wake)) created++;
+    if (created == 2 && GuliCondInit(&loader->done)) created++;
+    if (created < 3 || !GuliThreadCreate(&loader->thread, GlLoaderMain, loader))
+    {
+        if (created > 2) GuliCondDestroy(&loader->done);
+        if (created > 1) GuliCondDestroy(&loader->wake);
+        if (created > 0) GuliMutexDestroy(&loader->lock);
+        glfwDestroyWindow(loader->window);
+        GuliFree(loader);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to start loader thread");
+        return 0;
+    }
+
+    GuliMutexLock(&loader->lock);
+    while (loader->started == 0)
+        GuliCondWait(&loader->done, &loader->lock);
+    const int started = loader->started;
+    GuliMutexUnlock(&loader->lock);
+
+    if (started < 0)
+    {
+        GuliThreadJoin(loader->thread);
+        glfwDestroyWindow(loader->window);
+        GuliCondDestroy(&loader->done);
+        GuliCondDestroy(&loader->wake);
+        GuliMutexDestroy(&loader->lock);
+        GuliFree(loader);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Loader thread could not make its context current");
+        return 0;
+    }
+
+    gl->loader = loader;
+    return 1;
+}
+
+void GuliLoaderStop(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlLoader* loader = gl ? gl->loader : NULL;
+    if (!loader) return;
+
+    GuliMutexLock(&loader->lock);
+    loader->quit = 1;
+    GuliCondSignal(&loader->wake);
+    GuliMutexUnlock(&loader->lock);
+    GuliThreadJoin(loader->thread);
+
+    /* Uploads that never started fail. */
+    GuliUpload* up = loader->head;
+    loader->head = loader->tail = NULL;
+    while (up)
+    {
+        GuliUpload* next = up->next;
+        atomic_store(&up->state, GL_UPLOAD_FAILED);
+        GlUploadDropRef(up);
+        up = next;
+    }
+
+    gl->loader = NULL;
+    glfwDestroyWindow(loader->window);
+    GuliCondDestroy(&loader->done);
+    GuliCondDestroy(&loader->wake);
+    GuliMutexDestroy(&loader->lock);
+    GuliFree(loader);
+}
+
+int GuliLoaderIsActive(void)
+{
+    return GlLoaderGet() ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Graphics/guli_recorder.h"
+
+#include <glad/glad.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * OpenGL frame readback for GuliRecorder: PBO ring + fences, mapped frames behind
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_GL_RECORD_SLOTS GULI_MAX_FRAMES_IN_FLIGHT
+#define GULI_GL_RECORD_WAIT_NS 1000000000ull
+
+struct GlRecorderState {
+    GuliRecorder* recorder;
+    unsigned int pbo[GULI_GL_RECORD_SLOTS];
+    size_t pbo_size[GULI_GL_RECORD_SLOTS];
+    GLsync fence[GULI_GL_RECORD_SLOTS];
+    int width[GULI_GL_RECORD_SLOTS];
+    int height[GULI_GL_RECORD_SLOTS];
+    unsigned int head;
+};
+
+/* Copy a completed readback slot into a recorder frame. */
+static void GlRecorderResolve(struct GlRecorderState* r, unsigned int slot)
+{
+    if (!r->fence[slot]) return;
+
+    glClientWaitSync(r->fence[slot], GL_SYNC_FLUSH_COMMANDS_BIT, GULI_GL_RECORD_WAIT_NS);
+    glDeleteSync(r->fence[slot]);
+    r->fence[slot] = NULL;
+
+    const int w = r->width[slot];
+    const int h = r->height[slot];
+    unsigned char* dst = GuliRecorderAcquireFrame(r->recorder, w, h);
+    if (!dst) return;
+
+    const size_t size = (size_t)w * (size_t)h * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, r->pbo[slot]);
+    const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+    if (src)
+    {
+        memcpy(dst, src, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    GuliRecorderSubmitFrame(r->recorder, src ? dst : NULL, 1);
+}
+
+int GlRecorderAttach(GuliRecorder* recorder);
+void GlRecorderDetach(void);
+
+/* Attach/detach create and delete GL buffers: in render-thread mode they run there. */
+typedef struct {
+    GuliRecorder* recorder;
+    int result;
+} GlRecorderAttachCall;
+
+static void GlRecorderAttachInvoke(void* arg)
+{
+    GlRecorderAttachCall* call = arg;
+    call->result = GlRecorderAttach(call->recorder);
+}
+
+static void GlRecorderDetachInvoke(void* arg)
+{
+    (void)arg;
+    GlRecorderDetach();
+}
+
+int GlRecorderAttach(GuliRecorder* recorder)
+{
+    if (GlRenderThreadIsRemote())
+    {
+        GlRecorderAttachCall call = { recorder, 0 };
+        GlRenderThreadInvoke(GlRecorderAttachInvoke, &call);
+        return call.result;
+    }
+
+    struct GLState* gl = G_State.gl_s;
+    if (!gl)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Recorder requires an initialized OpenGL backend");
+        return 0;
+    }
+    if (gl->recorder)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "A recorder is already attached");
+        return 0;
+    }
+
+    struct GlRecorderState* r = GuliCalloc(1, sizeof(struct GlRecorderState));
+    if (!r)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate recorder readback state");
+        return 0;
+    }
+
+    r->recorder = recorder;
+    glGenBuffers(GULI_GL_RECORD_SLOTS, r->pbo);
+    gl->recorder = r;
+    return 1;
+}
+
+void GlRecorderDetach(void)
+{
+    if (GlRenderThreadIsRemote())
+    {
+        GlRenderThreadInvoke(GlRecorderDetachInvoke, NULL);
+        return;
+    }
+
+    struct GLState* gl = G_State.gl_s;
+    if (!gl || !gl->recorder) return;
+
+    struct GlRecorderState* r = gl->recorder;
+    for (unsigned int i = 0; i < GULI_GL_RECORD_SLOTS; i++)
+        GlRecorderResolve(r, (r->head + i) % GULI_GL_RECORD_SLOTS);
+
+    glDeleteBuffers(GULI_GL_RECORD_SLOTS, r->pbo);
+    GuliFree(r);
+    gl->recorder = NULL;
+}
+
+/* Called from GlExecEndFrame before the swap: queue an async read of the back buffer and
+   resolve the slot read GULI_GL_RECORD_SLOTS frames ago, which has normally completed. */
+void GlRecorderCapture(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl || !gl->recorder) return;
+
+    struct GlRecorderState* r = gl->recorder;
+    const unsigned int slot = r->head;
+    GlRecorderResolve(r, slot);
+
+    const int w = gl->framebuffer_width;
+    const int h = gl->framebuffer_height;
+    if (w <= 0 || h <= 0) return;
+
+    const size_t size = (size_t)w * (size_t)h * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, r->pbo[slot]);
+    if (size > r->pbo_size[slot])
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)size, NULL, GL_STREAM_READ);
+        r->pbo_size[slot] = size;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    r->fence[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    r->width[slot] = w;
+    r->height[slot] = h;
+    r->head = (slot + 1) % GULI_GL_RECORD_SLOTS;
+}
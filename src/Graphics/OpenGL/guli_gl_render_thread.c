@@ -0,0 +1,276 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Core/guli_thread.h"
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <stdlib.h>
+
+/* -----------------------------------------------------------------------------
+ * Render-thread mode. The API records into a command buffer on the owning
+ * thread; a dedicated thread holding the GL context replays it one frame behind.
+ * Two frame buffers alternate, so recording frame N+1 overlaps the replay (and
+ * swap) of frame N. Calls that must return GL objects or state run synchronously
+ * on the render thread, after the frames already submitted.
+ * ----------------------------------------------------------------------------- */
+
+#define GL_RT_FRAMES 2
+
+typedef enum {
+    GL_RT_FREE = 0,
+    GL_RT_RECORDING,
+    GL_RT_SUBMITTED,
+} GlRtFrameState;
+
+typedef struct GlRtInvoke {
+    void (*func)(void* arg);
+    void* arg;
+    int done;
+} GlRtInvoke;
+
+struct GlRenderThread {
+    GuliState* context;                   /* state whose GL context the thread owns */
+    GuliThread thread;
+    GuliMutex lock;
+    GuliCond wake;                        /* render thread: frame or invoke queued, or quit */
+    GuliCond done;                        /* owners: frame retired, invoke finished, startup */
+    GlCmdBuffer frames[GL_RT_FRAMES];
+    GlRtFrameState state[GL_RT_FRAMES];
+    GlRtInvoke* invoke;                   /* at most one pending */
+    int replay;                           /* render side: next frame to replay */
+    int record;                           /* owner side: frame being recorded */
+    int recording;                        /* owner side: frames[record] is acquired */
+    int started;                          /* 1 once the context is current on the thread, -1 on failure */
+    int quit;
+};
+
+_Thread_local static int t_gl_context_owner;  /* render or loader thread: has its own context current */
+
+static struct GlRenderThread* GlRtGet(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    return gl ? gl->render_thread : NULL;
+}
+
+static void* GlRenderThreadMain(void* arg)
+{
+    struct GlRenderThread* rt = arg;
+    G_CurrentState = (rt->context == &G_DefaultState) ? NULL : rt->context;
+    GlRenderThreadSetContextOwner();
+    glfwMakeContextCurrent(G_State.window);
+
+    GuliMutexLock(&rt->lock);
+    rt->started = (glfwGetCurrentContext() == G_State.window) ? 1 : -1;
+    GuliCondBroadcast(&rt->done);
+    if (rt->started < 0)
+    {
+        GuliMutexUnlock(&rt->lock);
+        return NULL;
+    }
+
+    for (;;)
+    {
+        /* Submitted frames first: invokes and quit are ordered after them. */
+        if (rt->state[rt->replay] == GL_RT_SUBMITTED)
+        {
+            GlCmdBuffer* frame = &rt->frames[rt->replay];
+            GuliMutexUnlock(&rt->lock);
+            GlCmdReplay(frame->data, frame->size);
+            GuliMutexLock(&rt->lock);
+            rt->state[rt->replay] = GL_RT_FREE;
+            rt->replay = (rt->replay + 1) % GL_RT_FRAMES;
+            GuliCondBroadcast(&rt->done);
+            continue;
+        }
+        if (rt->invoke)
+        {
+            GlRtInvoke* call = rt->invoke;
+            GuliMutexUnlock(&rt->lock);
+            call->func(call->arg);
+            GuliMutexLock(&rt->lock);
+            call->done = 1;
+            rt->invoke = NULL;
+            GuliCondBroadcast(&rt->done);
+            continue;
+        }
+        if (rt->quit) break;
+        GuliCondWait(&rt->wake, &rt->lock);
+    }
+    GuliMutexUnlock(&rt->lock);
+
+    glfwMakeContextCurrent(NULL);
+    return NULL;
+}
+
+/* Hand the recorded buffer to the render thread. Owner side. */
+static void GlRtSubmit(struct GlRenderThread* rt)
+{
+    if (!rt->recording) return;
+    GuliMutexLock(&rt->lock);
+    rt->state[rt->record] = GL_RT_SUBMITTED;
+    GuliCondSignal(&rt->wake);
+    GuliMutexUnlock(&rt->lock);
+    rt->record = (rt->record + 1) % GL_RT_FRAMES;
+    rt->recording = 0;
+}
+
+GlCmdBuffer* GlRenderThreadRecorder(void)
+{
+    struct GlRenderThread* rt = GlRtGet();
+    if (!rt || t_gl_context_owner) return NULL;
+
+    if (!rt->recording)
+    {
+        /* Blocks while the render thread is still replaying this buffer (two frames back). */
+        GuliMutexLock(&rt->lock);
+        while (rt->state[rt->record] != GL_RT_FREE)
+            GuliCondWait(&rt->done, &rt->lock);
+        rt->state[rt->record] = GL_RT_RECORDING;
+        GuliMutexUnlock(&rt->lock);
+        GlCmdBufferReset(&rt->frames[rt->record]);
+        rt->recording = 1;
+    }
+    return &rt->frames[rt->record];
+}
+
+void GlRenderThreadSetContextOwner(void)
+{
+    t_gl_context_owner = 1;
+}
+
+int GlRenderThreadIsRemote(void)
+{
+    return (GlRtGet() && !t_gl_context_owner) ? 1 : 0;
+}
+
+void GlRenderThreadInvoke(void (*func)(void* arg), void* arg)
+{
+    struct GlRenderThread* rt = GlRtGet();
+    if (!rt || t_gl_context_owner)
+    {
+        func(arg);
+        return;
+    }
+
+    GlRtInvoke call = { func, arg, 0 };
+    GuliMutexLock(&rt->lock);
+    while (rt->invoke)
+        GuliCondWait(&rt->done, &rt->lock);
+    rt->invoke = &call;
+    GuliCondSignal(&rt->wake);
+    while (!call.done)
+        GuliCondWait(&rt->done, &rt->lock);
+    GuliMutexUnlock(&rt->lock);
+}
+
+void GlRenderThreadSubmit(void)
+{
+    struct GlRenderThread* rt = GlRtGet();
+    if (rt && !t_gl_context_owner) GlRtSubmit(rt);
+}
+
+int GlRenderThreadStart(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl || !G_State.window)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Render thread requires an initialized OpenGL backend");
+        return 0;
+    }
+    if (gl->render_thread) return 1;
+    if (gl->has_active_frame)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Cannot start the render thread inside a frame");
+        return 0;
+    }
+
+    struct GlRenderThread* rt = GuliCalloc(1, sizeof(struct GlRenderThread));
+    if (!rt)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate render thread");
+        return 0;
+    }
+    if (!GuliMutexInit(&rt->lock))
+    {
+        GuliFree(rt);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create render thread mutex");
+        return 0;
+    }
+    if (!GuliCondInit(&rt->wake) || !GuliCondInit(&rt->done))
+    {
+        GuliMutexDestroy(&rt->lock);
+        GuliFree(rt);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create render thread conditions");
+        return 0;
+    }
+
+    rt->context = &G_State;
+
+    /* A context is current on at most one thread: release it before the thread takes it. */
+    glFinish();
+    glfwMakeContextCurrent(NULL);
+
+    if (!GuliThreadCreate(&rt->thread, GlRenderThreadMain, rt))
+    {
+        glfwMakeContextCurrent(G_State.window);
+        GuliCondDestroy(&rt->done);
+        GuliCondDestroy(&rt->wake);
+        GuliMutexDestroy(&rt->lock);
+        GuliFree(rt);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create render thread");
+        return 0;
+    }
+
+    GuliMutexLock(&rt->lock);
+    while (rt->started == 0)
+        GuliCondWait(&rt->done, &rt->lock);
+    const int started = rt->started;
+    GuliMutexUnlock(&rt->lock);
+
+    if (started < 0)
+    {
+        GuliThreadJoin(rt->thread);
+        glfwMakeContextCurrent(G_State.window);
+        GuliCondDestroy(&rt->done);
+        GuliCondDestroy(&rt->wake);
+        GuliMutexDestroy(&rt->lock);
+        GuliFree(rt);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Render thread could not make the GL context current");
+        return 0;
+    }
+
+    gl->render_thread = rt;
+    return 1;
+}
+
+void GlRenderThreadStop(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlRenderThread* rt = gl ? gl->render_thread : NULL;
+    if (!rt || t_gl_context_owner) return;
+
+    /* Flush whatever was recorded (deferred deletes, or a frame left open) before quitting. */
+    GlRtSubmit(rt);
+
+    GuliMutexLock(&rt->lock);
+    rt->quit = 1;
+    GuliCondSignal(&rt->wake);
+    GuliMutexUnlock(&rt->lock);
+    GuliThreadJoin(rt->thread);
+
+    gl->render_thread = NULL;
+    glfwMakeContextCurrent(G_State.window);
+
+    for (int i = 0; i < GL_RT_FRAMES; i++)
+        GlCmdBufferFree(&rt->frames[i]);
+    GuliCondDestroy(&rt->done);
+    GuliCondDestroy(&rt->wake);
+    GuliMutexDestroy(&rt->lock);
+    GuliFree(rt);
+}
+
+int GlRenderThreadIsActive(void)
+{
+    return GlRtGet() ? 1 : 0;
+}
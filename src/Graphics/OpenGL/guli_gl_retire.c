@@ -0,0 +1,162 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
+#include "Core/guli_thread.h"
+
+#include <glad/glad.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Deferred destruction. Unload only invalidates the object's handle and queues
+ * its GL name; GlRetireCollect (every GlBeginDraw) deletes the names queued
+ * GL_RETIRE_DELAY frames ago in one call per object type and recycles their pool
+ * slots. Entries are queued in frame order, so the ready ones form a prefix.
+ * Whatever is still queued is deleted by GlShutdown.
+ * ----------------------------------------------------------------------------- */
+
+#define GL_RETIRE_DELAY (GULI_MAX_FRAMES_IN_FLIGHT + 1)  /* +1: render-thread replay runs a frame behind */
+#define GL_RETIRE_BATCH 64
+
+typedef struct {
+    uint64_t frame;           /* queue frame when the object was unloaded */
+    GuliPool* pool;           /* slot to recycle (NULL: none) */
+    GuliHandle handle;
+    unsigned int name;
+    GlRetireKind kind;
+} GlRetireEntry;
+
+struct GlRetireQueue {
+    GuliMutex lock;           /* unloads may come from the loader thread or jobs */
+    GlRetireEntry* entries;
+    size_t count;
+    size_t capacity;
+    uint64_t frame;
+};
+
+void GlExecDeleteObjects(int kind, const unsigned int* names, int count)
+{
+    switch ((GlRetireKind)kind)
+    {
+    case GL_RETIRE_TEXTURE:
+        glDeleteTextures(count, names);
+        break;
+    case GL_RETIRE_BUFFER:
+        glDeleteBuffers(count, names);
+        break;
+    case GL_RETIRE_PROGRAM:
+    {
+        struct GLState* gl = G_State.gl_s;
+        for (int i = 0; i < count; i++)
+        {
+            glDeleteProgram(names[i]);
+            /* The name may be handed out again: drop it from the bind cache */
+            if (gl && gl->current_program == names[i]) gl->current_program = 0;
+        }
+        break;
+    }
+    case GL_RETIRE_VERTEX_ARRAY:
+        glDeleteVertexArrays(count, names);
+        break;
+    default:
+        break;
+    }
+}
+
+static void GlRetireDelete(GlRetireKind kind, const unsigned int* names, int count)
+{
+    if (!count) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdDeleteObjects(cmd, (int)kind, names, count);
+    else GlExecDeleteObjects((int)kind, names, count);
+}
+
+int GlRetireInit(struct GLState* gl)
+{
+    struct GlRetireQueue* q = GuliCalloc(1, sizeof(struct GlRetireQueue));
+    if (!q) return 0;
+    if (!GuliMutexInit(&q->lock))
+    {
+        GuliFree(q);
+        return 0;
+    }
+    gl->retire = q;
+    return 1;
+}
+
+void GlRetireObject(GlRetireKind kind, unsigned int name, GuliPool* pool, GuliHandle handle)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlRetireQueue* q = gl ? gl->retire : NULL;
+    if (!q)
+    {
+        /* No context left to delete from */
+        if (pool) GuliPoolRecycle(pool, handle);
+        return;
+    }
+
+    GuliMutexLock(&q->lock);
+    if (q->count == q->capacity)
+    {
+        const size_t capacity = q->capacity ? q->capacity * 2 : 64;
+        GlRetireEntry* entries = GuliRealloc(q->entries, capacity * sizeof(GlRetireEntry));
+        if (!entries)
+        {
+            GuliMutexUnlock(&q->lock);
+            GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to queue object deletion; deleting now");
+            if (name) GlRetireDelete(kind, &name, 1);
+            if (pool) GuliPoolRecycle(pool, handle);
+            return;
+        }
+        q->entries = entries;
+        q->capacity = capacity;
+    }
+    q->entries[q->count++] = (GlRetireEntry){ q->frame, pool, handle, name, kind };
+    GuliMutexUnlock(&q->lock);
+}
+
+void GlRetireCollect(int all)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlRetireQueue* q = gl ? gl->retire : NULL;
+    if (!q) return;
+
+    GuliMutexLock(&q->lock);
+    q->frame++;
+    size_t ready = 0;
+    while (ready < q->count && (all || q->frame - q->entries[ready].frame >= GL_RETIRE_DELAY))
+        ready++;
+
+    unsigned int names[GL_RETIRE_KIND_COUNT][GL_RETIRE_BATCH];
+    int counts[GL_RETIRE_KIND_COUNT] = {0};
+    for (size_t i = 0; i < ready; i++)
+    {
+        const GlRetireEntry* e = &q->entries[i];
+        if (e->name)
+        {
+            if (counts[e->kind] == GL_RETIRE_BATCH)
+            {
+                GlRetireDelete(e->kind, names[e->kind], counts[e->kind]);
+                counts[e->kind] = 0;
+            }
+            names[e->kind][counts[e->kind]++] = e->name;
+        }
+        if (e->pool) GuliPoolRecycle(e->pool, e->handle);
+    }
+    for (int kind = 0; kind < GL_RETIRE_KIND_COUNT; kind++)
+        GlRetireDelete((GlRetireKind)kind, names[kind], counts[kind]);
+
+    if (ready)
+    {
+        memmove(q->entries, q->entries + ready, (q->count - ready) * sizeof(GlRetireEntry));
+        q->count -= ready;
+    }
+    GuliMutexUnlock(&q->lock);
+}
+
+void GlRetireFree(struct GLState* gl)
+{
+    if (!gl || !gl->retire) return;
+    GuliMutexDestroy(&gl->retire->lock);
+    GuliFree(gl->retire->entries);
+    GuliFree(gl->retire);
+    gl->retire = NULL;
+}
@@ -1,11 +1,14 @@
 #include "Graphics/OpenGL/guli_gl.h"
 #include "Graphics/OpenGL/guli_gl_shader.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
 #include "Graphics/guli_texture.h"
 #include "Graphics/guli_shader_defines.h"
-#include "Core/guli_file.h"
+#include "Graphics/guli_shader_preprocess.h"
 #include "Core/guli_hash.h"
 
 #include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -15,14 +18,18 @@
 
 _Thread_local static char g_gl_shader_error[GULI_SHADER_ERROR_MAX];
 
-static unsigned int g_gl_current_program;
-
-static void GlEnsureProgram(unsigned int program)
+void GlBindProgram(unsigned int program)
 {
-    if (program != g_gl_current_program)
+    struct GLState* gl = G_State.gl_s;
+    if (!gl)
+    {
+        glUseProgram(program);
+        return;
+    }
+    if (program != gl->current_program)
     {
         glUseProgram(program);
-        g_gl_current_program = program;
+        gl->current_program = program;
     }
 }
 
@@ -40,13 +47,31 @@ typedef struct {
     int hashTable[GULI_UNIFORM_HASH_SIZE];
 } GlUniformCache;
 
+/* Name lookups and the debug name live apart from the per-draw fields */
+typedef struct {
+    GlUniformCache uniformCache;
+    char name[GULI_RESOURCE_NAME_MAX];
+    size_t bytes;  /* program binary size counted under GULI_MEMORY_SHADER */
+    int local_size[3];  /* compute: work group size; 0 for graphics programs */
+} GlShaderCold;
+
 struct GuliShader {
     unsigned int program;
     int locs[GULI_SHADER_LOC_COUNT];
-    GlUniformCache uniformCache;
+    GuliHandle handle;
+    int reloadable;  /* hot reload: locations handed out are uniform cache slots */
+    GlShaderCold* cold;
+};
+
+static const char* const k_default_uniforms[GULI_SHADER_LOC_COUNT] = {
+    [GULI_SHADER_LOC_COLOR] = GULI_SHADER_UNIFORM_COLOR,
+    [GULI_SHADER_LOC_MVP] = GULI_SHADER_UNIFORM_MVP,
 };
 
-static int GlCacheLookup(GlUniformCache* cache, const char* name)
+static GuliPool g_gl_shader_pool = GULI_POOL_INIT(sizeof(struct GuliShader), sizeof(GlShaderCold));
+
+/* Entry index for name, or GULI_GL_CACHE_MISS */
+static int GlCacheFind(const GlUniformCache* cache, const char* name)
 {
     uint32_t idx = GuliHashFNV1a(name) % GULI_UNIFORM_HASH_SIZE;
     for (int probe = 0; probe < GULI_UNIFORM_HASH_SIZE; probe++)
@@ -54,15 +79,16 @@ static int GlCacheLookup(GlUniformCache* cache, const char* name)
         int ei = cache->hashTable[idx];
         if (ei == GULI_GL_HASH_EMPTY) return GULI_GL_CACHE_MISS;
         if (strcmp(cache->entries[ei].name, name) == 0)
-            return cache->entries[ei].location;
+            return ei;
         idx = (idx + 1) % GULI_UNIFORM_HASH_SIZE;
     }
     return GULI_GL_CACHE_MISS;
 }
 
+/* Returns the new entry's index, or -1 when the cache is full */
 static int GlCacheInsert(GlUniformCache* cache, const char* name, int location)
 {
-    if (cache->count >= GULI_UNIFORM_CACHE_MAX) return location;
+    if (cache->count >= GULI_UNIFORM_CACHE_MAX) return -1;
     uint32_t idx = GuliHashFNV1a(name) % GULI_UNIFORM_HASH_SIZE;
     while (cache->hashTable[idx] != GULI_GL_HASH_EMPTY)
         idx = (idx + 1) % GULI_UNIFORM_HASH_SIZE;
@@ -73,7 +99,15 @@ static int GlCacheInsert(GlUniformCache* cache, const char* name, int location)
     cache->entries[ei].name[len] = '\0';
     cache->entries[ei].location = location;
     cache->hashTable[idx] = ei;
-    return location;
+    return ei;
+}
+
+/* Program location for a location handed out by GlShaderGetLocation (a cache slot for reloadable shaders) */
+static inline int GlShaderResolve(const GuliShader* shader, int loc)
+{
+    if (!shader->reloadable || loc < 0) return loc;
+    const GlUniformCache* cache = &shader->cold->uniformCache;
+    return loc < cache->count ? cache->entries[loc].location : -1;
 }
 
 static unsigned int compile_glsl(const char* source, unsigned int type)
@@ -97,11 +131,11 @@ static unsigned int compile_glsl(const char* source, unsigned int type)
     return shader;
 }
 
-static unsigned int link_program(unsigned int vs, unsigned int fs)
+static unsigned int link_stages(const unsigned int* stages, int count)
 {
     unsigned int program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
+    for (int i = 0; i < count; i++)
+        glAttachShader(program, stages[i]);
     glLinkProgram(program);
 
     int success = 0;
@@ -116,13 +150,86 @@ static unsigned int link_program(unsigned int vs, unsigned int fs)
         glDeleteProgram(program);
         return 0;
     }
-    glDetachShader(program, vs);
-    glDetachShader(program, fs);
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+    for (int i = 0; i < count; i++)
+    {
+        glDetachShader(program, stages[i]);
+        glDeleteShader(stages[i]);
+    }
     return program;
 }
 
+static unsigned int link_program(unsigned int vs, unsigned int fs)
+{
+    const unsigned int stages[2] = { vs, fs };
+    return link_stages(stages, 2);
+}
+
+/* -----------------------------------------------------------------------------
+ * SPIR-V ingestion (GL 4.6 core or GL_ARB_gl_spirv). glad is generated without
+ * extensions, so the ARB entry point is resolved by hand.
+ * ----------------------------------------------------------------------------- */
+
+#define GL_SPIRV_CONSTANTS_MAX 64
+
+typedef void (APIENTRYP GlSpecializeShaderFn)(GLuint shader, const GLchar* pEntryPoint, GLuint numSpecializationConstants,
+    const GLuint* pConstantIndex, const GLuint* pConstantValue);
+
+static GlSpecializeShaderFn GlSpirvSpecializer(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return NULL;
+    if (!gl->spirv_probed)
+    {
+        gl->spirv_probed = 1;
+        gl->specialize_shader = NULL;
+        if (!glShaderBinary)
+            return NULL;
+        if (GLAD_GL_VERSION_4_6 && glSpecializeShader)
+            gl->specialize_shader = (void (*)(void))glSpecializeShader;
+        else if (glfwExtensionSupported("GL_ARB_gl_spirv"))
+            gl->specialize_shader = (void (*)(void))glfwGetProcAddress("glSpecializeShaderARB");
+    }
+    return (GlSpecializeShaderFn)gl->specialize_shader;
+}
+
+static unsigned int compile_spirv(GlSpecializeShaderFn specialize, const void* code, size_t size, const char* entry,
+    const GuliShaderSpecConstant* constants, int count, unsigned int type)
+{
+    if (!code || !size || size % 4 != 0 || count > GL_SPIRV_CONSTANTS_MAX)
+    {
+        strncpy(g_gl_shader_error, "Invalid SPIR-V module or too many specialization constants", GULI_SHADER_ERROR_MAX - 1);
+        g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "%s", g_gl_shader_error);
+        return 0;
+    }
+
+    /* SoA copies of the constants for glSpecializeShader */
+    GLuint ids[GL_SPIRV_CONSTANTS_MAX], values[GL_SPIRV_CONSTANTS_MAX];
+    for (int i = 0; i < count; i++)
+    {
+        ids[i] = constants[i].id;
+        values[i] = constants[i].value;
+    }
+
+    unsigned int shader = glCreateShader(type);
+    glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V, code, (GLsizei)size);
+    specialize(shader, entry ? entry : "main", (GLuint)count, ids, values);
+
+    int success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char log[512] = "SPIR-V specialization failed";
+        glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+        strncpy(g_gl_shader_error, log, GULI_SHADER_ERROR_MAX - 1);
+        g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "%s", log);
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
 /* Default vertex shader - fullscreen triangle */
 static const char* default_vs_glsl =
     "#version 330 core\n"
@@ -150,8 +257,76 @@ static const char* default_fs_glsl =
     "    finalColor = colDiffuse * fragColor;\n"
     "}\n";
 
+/* In render-thread mode compilation runs there; the error is copied back to the caller's thread. */
+typedef struct {
+    const char* vs;
+    const char* fs;
+    int is_default;
+    const GuliShaderSpirvDesc* spirv;
+    const char* cs;
+    GuliShader* shader;
+    char error[GULI_SHADER_ERROR_MAX];
+} GlShaderLoadCall;
+
+static void GlShaderLoadInvoke(void* arg)
+{
+    GlShaderLoadCall* call = arg;
+    if (call->spirv) call->shader = GlShaderLoadSpirv(call->spirv);
+    else if (call->cs) call->shader = GlShaderLoadCompute(call->cs);
+    else call->shader = call->is_default ? GlShaderLoadDefault() : GlShaderLoadFromMemory(call->vs, call->fs);
+    memcpy(call->error, g_gl_shader_error, GULI_SHADER_ERROR_MAX);
+}
+
+static GuliShader* GlShaderLoadRemote(const char* vs, const char* fs, int is_default, const GuliShaderSpirvDesc* spirv)
+{
+    GlShaderLoadCall call = { vs, fs, is_default, spirv, NULL, NULL, {0} };
+    GlRenderThreadInvoke(GlShaderLoadInvoke, &call);
+    memcpy(g_gl_shader_error, call.error, GULI_SHADER_ERROR_MAX);
+    return call.shader;
+}
+
+typedef struct {
+    unsigned int program;
+    const char* name;
+    int location;
+} GlUniformLocationCall;
+
+static void GlUniformLocationInvoke(void* arg)
+{
+    GlUniformLocationCall* call = arg;
+    call->location = glGetUniformLocation(call->program, call->name);
+}
+
+/* Pooled shader wrapping a linked program; deletes the program on failure. */
+static GuliShader* GlShaderCreate(unsigned int program)
+{
+    GuliHandle handle;
+    GuliShader* shader = GuliPoolAlloc(&g_gl_shader_pool, &handle);
+    if (!shader) { glDeleteProgram(program); return NULL; }
+
+    shader->program = program;
+    shader->handle = handle;
+    shader->cold = GuliPoolGetCold(&g_gl_shader_pool, handle);
+    for (int i = 0; i < GULI_UNIFORM_HASH_SIZE; i++)
+        shader->cold->uniformCache.hashTable[i] = GULI_GL_HASH_EMPTY;
+    shader->reloadable = 0;
+    for (int i = 0; i < GULI_SHADER_LOC_COUNT; i++)
+        shader->locs[i] = glGetUniformLocation(program, k_default_uniforms[i]);
+
+    /* Binary size approximates the driver's copy; without program binaries only the count is tracked */
+    GLint binary = 0;
+    if (GLAD_GL_VERSION_4_1 || glfwExtensionSupported("GL_ARB_get_program_binary"))
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary);
+    shader->cold->bytes = binary > 0 ? (size_t)binary : 0;
+    GuliMemoryTrack(GULI_MEMORY_SHADER, shader->cold->bytes);
+    memset(shader->cold->local_size, 0, sizeof(shader->cold->local_size));
+    return shader;
+}
+
 GuliShader* GlShaderLoadDefault(void)
 {
+    if (GlRenderThreadIsRemote()) return GlShaderLoadRemote(NULL, NULL, 1, NULL);
+
     g_gl_shader_error[0] = '\0';
     unsigned int vs = compile_glsl(default_vs_glsl, GL_VERTEX_SHADER);
     if (!vs) return NULL;
@@ -162,20 +337,13 @@ GuliShader* GlShaderLoadDefault(void)
     unsigned int program = link_program(vs, fs);
     if (!program) return NULL;
 
-    GuliShader* shader = calloc(1, sizeof(GuliShader));
-    if (!shader) { glDeleteProgram(program); return NULL; }
-
-    shader->program = program;
-    for (int i = 0; i < GULI_UNIFORM_HASH_SIZE; i++)
-        shader->uniformCache.hashTable[i] = GULI_GL_HASH_EMPTY;
-    shader->locs[GULI_SHADER_LOC_COLOR] = glGetUniformLocation(program, GULI_SHADER_UNIFORM_COLOR);
-    shader->locs[GULI_SHADER_LOC_MVP] = glGetUniformLocation(program, GULI_SHADER_UNIFORM_MVP);
-
-    return shader;
+    return GlShaderCreate(program);
 }
 
 GuliShader* GlShaderLoadFromMemory(const char* vsCode, const char* fsCode)
 {
+    if (GlRenderThreadIsRemote()) return GlShaderLoadRemote(vsCode, fsCode, 0, NULL);
+
     g_gl_shader_error[0] = '\0';
     const char* vs = vsCode ? vsCode : default_vs_glsl;
     const char* fs = fsCode ? fsCode : default_fs_glsl;
@@ -189,18 +357,7 @@ GuliShader* GlShaderLoadFromMemory(const char* vsCode, const char* fsCode)
     unsigned int program = link_program(vsId, fsId);
     if (!program) return NULL;
 
-    GuliShader* shader = calloc(1, sizeof(GuliShader));
-    if (!shader) { glDeleteProgram(program); return NULL; }
-
-    shader->program = program;
-    for (int i = 0; i < GULI_UNIFORM_HASH_SIZE; i++)
-        shader->uniformCache.hashTable[i] = GULI_GL_HASH_EMPTY;
-    for (int i = 0; i < GULI_SHADER_LOC_COUNT; i++)
-        shader->locs[i] = -1;
-    shader->locs[GULI_SHADER_LOC_COLOR] = glGetUniformLocation(program, GULI_SHADER_UNIFORM_COLOR);
-    shader->locs[GULI_SHADER_LOC_MVP] = glGetUniformLocation(program, GULI_SHADER_UNIFORM_MVP);
-
-    return shader;
+    return GlShaderCreate(program);
 }
 
 GuliShader* GlShaderLoadFromMemoryEx(const char* vsCode, const char* fsCode,
@@ -223,8 +380,9 @@ GuliShader* GlShaderLoadFromFile(const char* vertPath, const char* fragPath)
 {
     if (!vertPath || !fragPath) return NULL;
 
+    /* Includes resolved; no defines (GuliShaderVariants builds define permutations) */
     g_gl_shader_error[0] = '\0';
-    char* vs = GuliLoadFileText(vertPath);
+    char* vs = GuliShaderPreprocess(vertPath, NULL, NULL, 0);
     if (!vs)
     {
         strncpy(g_gl_shader_error, "Failed to load vertex shader file", GULI_SHADER_ERROR_MAX - 1);
@@ -233,27 +391,191 @@ GuliShader* GlShaderLoadFromFile(const char* vertPath, const char* fragPath)
         return NULL;
     }
 
-    char* fs = GuliLoadFileText(fragPath);
+    char* fs = GuliShaderPreprocess(fragPath, NULL, NULL, 0);
     if (!fs)
     {
         strncpy(g_gl_shader_error, "Failed to load fragment shader file", GULI_SHADER_ERROR_MAX - 1);
         g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
         GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to load fragment shader file");
-        free(vs);
+        GuliFree(vs);
         return NULL;
     }
 
     GuliShader* shader = GlShaderLoadFromMemory(vs, fs);
-    free(vs);
-    free(fs);
+    GuliFree(vs);
+    GuliFree(fs);
+    /* Watched from the caller's thread, whichever thread compiled it */
+    if (shader && G_State.gl_s && G_State.gl_s->shader_reload)
+        GlShaderReloadWatch(shader, vertPath, fragPath);
     return shader;
 }
 
+GuliShader* GlShaderLoadCompute(const char* csCode)
+{
+    if (!csCode) return NULL;
+    if (GlRenderThreadIsRemote())
+    {
+        GlShaderLoadCall call = { NULL, NULL, 0, NULL, csCode, NULL, {0} };
+        GlRenderThreadInvoke(GlShaderLoadInvoke, &call);
+        memcpy(g_gl_shader_error, call.error, GULI_SHADER_ERROR_MAX);
+        return call.shader;
+    }
+
+    g_gl_shader_error[0] = '\0';
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        strncpy(g_gl_shader_error, "Compute shaders need an OpenGL 4.3 context", GULI_SHADER_ERROR_MAX - 1);
+        g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Compute shaders need an OpenGL 4.3 context");
+        return NULL;
+    }
+
+    unsigned int cs = compile_glsl(csCode, GL_COMPUTE_SHADER);
+    if (!cs) return NULL;
+
+    unsigned int program = link_stages(&cs, 1);
+    if (!program) return NULL;
+
+    GuliShader* shader = GlShaderCreate(program);
+    if (shader) glGetProgramiv(program, GL_COMPUTE_WORK_GROUP_SIZE, shader->cold->local_size);
+    return shader;
+}
+
+GuliShader* GlShaderLoadComputeFromFile(const char* path)
+{
+    if (!path) return NULL;
+
+    g_gl_shader_error[0] = '\0';
+    char* cs = GuliShaderPreprocess(path, NULL, NULL, 0);
+    if (!cs)
+    {
+        strncpy(g_gl_shader_error, "Failed to load compute shader file", GULI_SHADER_ERROR_MAX - 1);
+        g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to load compute shader file");
+        return NULL;
+    }
+
+    GuliShader* shader = GlShaderLoadCompute(cs);
+    GuliFree(cs);
+    return shader;
+}
+
+int GlShaderGetLocalSize(const GuliShader* shader, int size[3])
+{
+    if (!shader || !shader->program || !shader->cold->local_size[0])
+    {
+        size[0] = size[1] = size[2] = 0;
+        return 0;
+    }
+    memcpy(size, shader->cold->local_size, sizeof(shader->cold->local_size));
+    return 1;
+}
+
+static void GlSpirvSupportedInvoke(void* arg)
+{
+    *(int*)arg = GlSpirvSpecializer() != NULL;
+}
+
+int GlShaderIsSpirvSupported(void)
+{
+    int supported = 0;
+    if (GlRenderThreadIsRemote()) GlRenderThreadInvoke(GlSpirvSupportedInvoke, &supported);
+    else GlSpirvSupportedInvoke(&supported);
+    return supported;
+}
+
+/* GLSL fallback with the constants as GULI_SPEC_CONSTANT_<id> defines */
+static GuliShader* GlShaderLoadSpirvFallback(const GuliShaderSpirvDesc* desc)
+{
+    if (!desc->vs_source || !desc->fs_source)
+    {
+        strncpy(g_gl_shader_error, "SPIR-V unsupported and no GLSL fallback given", GULI_SHADER_ERROR_MAX - 1);
+        g_gl_shader_error[GULI_SHADER_ERROR_MAX - 1] = '\0';
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "SPIR-V unsupported and no GLSL fallback given");
+        return NULL;
+    }
+    char* vs = GuliShaderPreprocessSpecConstants(desc->vs_source, desc->constants, desc->constant_count);
+    char* fs = GuliShaderPreprocessSpecConstants(desc->fs_source, desc->constants, desc->constant_count);
+    GuliShader* shader = (vs && fs) ? GlShaderLoadFromMemory(vs, fs) : NULL;
+    GuliFree(vs);
+    GuliFree(fs);
+    return shader;
+}
+
+GuliShader* GlShaderLoadSpirv(const GuliShaderSpirvDesc* desc)
+{
+    if (!desc || desc->constant_count < 0 || (desc->constant_count && !desc->constants)) return NULL;
+    if (GlRenderThreadIsRemote()) return GlShaderLoadRemote(NULL, NULL, 0, desc);
+
+    g_gl_shader_error[0] = '\0';
+    GlSpecializeShaderFn specialize = GlSpirvSpecializer();
+    if (!specialize || !desc->vs_spirv || !desc->fs_spirv) return GlShaderLoadSpirvFallback(desc);
+
+    unsigned int vs = compile_spirv(specialize, desc->vs_spirv, desc->vs_size, desc->vs_entry,
+        desc->constants, desc->constant_count, GL_VERTEX_SHADER);
+    unsigned int fs = vs ? compile_spirv(specialize, desc->fs_spirv, desc->fs_size, desc->fs_entry,
+        desc->constants, desc->constant_count, GL_FRAGMENT_SHADER) : 0;
+    unsigned int program = 0;
+    if (fs) program = link_program(vs, fs);
+    else if (vs) glDeleteShader(vs);
+
+    /* A module the driver rejects still has the source path */
+    if (!program)
+    {
+        if (!desc->vs_source || !desc->fs_source) return NULL;
+        GuliLog(GULI_LOG_WARNING, 0, "SPIR-V shader rejected by the driver; compiling the GLSL fallback");
+        return GlShaderLoadSpirvFallback(desc);
+    }
+    return GlShaderCreate(program);
+}
+
 void GlShaderUnload(GuliShader* shader)
 {
     if (!shader) return;
-    if (shader->program) glDeleteProgram(shader->program);
-    free(shader);
+    /* Handles go stale now; the program is deleted (and the slot recycled) once
+       frames that may still draw with it have retired */
+    GuliPoolRelease(&g_gl_shader_pool, shader->handle);
+    if (shader->program) GuliMemoryUntrack(GULI_MEMORY_SHADER, shader->cold->bytes);
+    GlRetireObject(GL_RETIRE_PROGRAM, shader->program, &g_gl_shader_pool, shader->handle);
+    shader->program = 0;
+}
+
+void GlShaderMakeReloadable(GuliShader* shader)
+{
+    if (shader) shader->reloadable = 1;
+}
+
+static void GlShaderResolveInvoke(void* arg)
+{
+    GuliShader* shader = arg;
+    for (int i = 0; i < GULI_SHADER_LOC_COUNT; i++)
+        shader->locs[i] = glGetUniformLocation(shader->program, k_default_uniforms[i]);
+    GlUniformCache* cache = &shader->cold->uniformCache;
+    for (int i = 0; i < cache->count; i++)
+        cache->entries[i].location = glGetUniformLocation(shader->program, cache->entries[i].name);
+}
+
+void GlShaderReplaceProgram(GuliShader* dst, GuliShader* src)
+{
+    if (!dst || !src || !src->program) return;
+
+    /* Frames already recorded may still draw with the old program */
+    if (dst->program)
+    {
+        GuliMemoryUntrack(GULI_MEMORY_SHADER, dst->cold->bytes);
+        GlRetireObject(GL_RETIRE_PROGRAM, dst->program, NULL, GULI_HANDLE_NULL);
+    }
+    dst->program = src->program;
+    dst->cold->bytes = src->cold->bytes;
+
+    /* Cached names keep their slots; only the program locations behind them change */
+    if (GlRenderThreadIsRemote()) GlRenderThreadInvoke(GlShaderResolveInvoke, dst);
+    else GlShaderResolveInvoke(dst);
+
+    /* src never drew: its slot is free right away */
+    src->program = 0;
+    GuliPoolRelease(&g_gl_shader_pool, src->handle);
+    GuliPoolRecycle(&g_gl_shader_pool, src->handle);
 }
 
 int GlShaderIsValid(const GuliShader* shader)
@@ -264,12 +586,25 @@ int GlShaderIsValid(const GuliShader* shader)
 int GlShaderGetLocation(const GuliShader* shader, const char* uniformName)
 {
     if (!shader || !shader->program || !uniformName) return -1;
-    GlUniformCache* cache = (GlUniformCache*)&shader->uniformCache;
-    int loc = GlCacheLookup(cache, uniformName);
-    if (loc != GULI_GL_CACHE_MISS) return loc;
-    loc = glGetUniformLocation(shader->program, uniformName);
-    GlCacheInsert(cache, uniformName, loc);
-    return loc;
+    GlUniformCache* cache = &shader->cold->uniformCache;
+    const int ei = GlCacheFind(cache, uniformName);
+    if (ei != GULI_GL_CACHE_MISS) return shader->reloadable ? ei : cache->entries[ei].location;
+    int loc;
+    if (GlRenderThreadIsRemote())
+    {
+        GlUniformLocationCall call = { shader->program, uniformName, -1 };
+        GlRenderThreadInvoke(GlUniformLocationInvoke, &call);
+        loc = call.location;
+    }
+    else loc = glGetUniformLocation(shader->program, uniformName);
+    const int slot = GlCacheInsert(cache, uniformName, loc);
+    /* A reloadable shader hands out the slot, even for a uniform the current program lacks */
+    return shader->reloadable ? slot : loc;
+}
+
+int GlShaderResolveLocation(const GuliShader* shader, int loc)
+{
+    return shader ? GlShaderResolve(shader, loc) : -1;
 }
 
 int GlShaderGetVertexLocation(const GuliShader* shader, const char* uniformName)
@@ -280,59 +615,71 @@ int GlShaderGetVertexLocation(const GuliShader* shader, const char* uniformName)
 void GlShaderUse(GuliShader* shader)
 {
     unsigned int program = (shader && shader->program) ? shader->program : 0;
-    if (program != g_gl_current_program)
-    {
-        glUseProgram(program);
-        g_gl_current_program = program;
-    }
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) GlCmdUseProgram(cmd, program);
+    else GlBindProgram(program);
 }
 
 void GlShaderSetFloat(GuliShader* restrict shader, int loc, float value)
 {
-    if (!shader || !shader->program || loc < 0) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformFloats(cmd, shader->program, loc, &value, 1); return; }
+    GlBindProgram(shader->program);
     glUniform1f(loc, value);
 }
 
 void GlShaderSetVec2(GuliShader* restrict shader, int loc, const float* restrict v)
 {
-    if (!shader || !shader->program || loc < 0 || !v) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || !v || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformFloats(cmd, shader->program, loc, v, 2); return; }
+    GlBindProgram(shader->program);
     glUniform2fv(loc, 1, v);
 }
 
 void GlShaderSetVec3(GuliShader* restrict shader, int loc, const float* restrict v)
 {
-    if (!shader || !shader->program || loc < 0 || !v) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || !v || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformFloats(cmd, shader->program, loc, v, 3); return; }
+    GlBindProgram(shader->program);
     glUniform3fv(loc, 1, v);
 }
 
 void GlShaderSetVec4(GuliShader* restrict shader, int loc, const float* restrict v)
 {
-    if (!shader || !shader->program || loc < 0 || !v) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || !v || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformFloats(cmd, shader->program, loc, v, 4); return; }
+    GlBindProgram(shader->program);
     glUniform4fv(loc, 1, v);
 }
 
 void GlShaderSetInt(GuliShader* restrict shader, int loc, int value)
 {
-    if (!shader || !shader->program || loc < 0) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformInt(cmd, shader->program, loc, value); return; }
+    GlBindProgram(shader->program);
     glUniform1i(loc, value);
 }
 
 void GlShaderSetMatrix4(GuliShader* restrict shader, int loc, const float* restrict m)
 {
-    if (!shader || !shader->program || loc < 0 || !m) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || !m || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformMatrix4(cmd, shader->program, loc, m); return; }
+    GlBindProgram(shader->program);
     glUniformMatrix4fv(loc, 1, GL_FALSE, m);
 }
 
 void GlShaderSetColor(GuliShader* restrict shader, int loc, GULI_COLOR color)
 {
-    if (!shader || !shader->program || loc < 0) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdUniformFloats(cmd, shader->program, loc, color, 4); return; }
+    GlBindProgram(shader->program);
     glUniform4fv(loc, 1, color);
 }
 
@@ -343,8 +690,10 @@ void GlShaderSetTexture(GuliShader* shader, int loc, GuliTexture* texture)
 
 void GlShaderSetTextureEx(GuliShader* restrict shader, int loc, GuliTexture* texture, int slot)
 {
-    if (!shader || !shader->program || loc < 0 || !texture || !texture->_backend) return;
-    GlEnsureProgram(shader->program);
+    if (!shader || !shader->program || !texture || !texture->_backend || (loc = GlShaderResolve(shader, loc)) < 0) return;
+    GlCmdBuffer* cmd = GlRenderThreadRecorder();
+    if (cmd) { GlCmdBindTexture2D(cmd, shader->program, loc, slot, (unsigned int)(uintptr_t)texture->_backend); return; }
+    GlBindProgram(shader->program);
     glUniform1i(loc, slot);
     glActiveTexture(GL_TEXTURE0 + (unsigned int)slot);
     glBindTexture(GL_TEXTURE_2D, (unsigned int)(uintptr_t)texture->_backend);
@@ -353,7 +702,34 @@ void GlShaderSetTextureEx(GuliShader* restrict shader, int loc, GuliTexture* tex
 int GlShaderGetDefaultLocation(GuliShader* shader, GuliShaderLocationIndex idx)
 {
     if (!shader || idx < 0 || idx >= GULI_SHADER_LOC_COUNT) return -1;
-    return shader->locs[idx];
+    return shader->reloadable ? GlShaderGetLocation(shader, k_default_uniforms[idx]) : shader->locs[idx];
+}
+
+unsigned int GlShaderGetProgram(const GuliShader* shader)
+{
+    return shader ? shader->program : 0;
+}
+
+GuliShaderHandle GlShaderGetHandle(const GuliShader* shader)
+{
+    return shader ? shader->handle : GULI_HANDLE_NULL;
+}
+
+GuliShader* GlShaderFromHandle(GuliShaderHandle handle)
+{
+    return GuliPoolGet(&g_gl_shader_pool, handle);
+}
+
+void GlShaderSetName(GuliShader* shader, const char* name)
+{
+    if (!shader) return;
+    strncpy(shader->cold->name, name ? name : "", GULI_RESOURCE_NAME_MAX - 1);
+    shader->cold->name[GULI_RESOURCE_NAME_MAX - 1] = '\0';
+}
+
+const char* GlShaderGetName(const GuliShader* shader)
+{
+    return shader ? shader->cold->name : "";
 }
 
 const char* GlShaderGetCompileError(void)
@@ -0,0 +1,416 @@
+#include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_shader.h"
+#include "Graphics/guli_loader.h"
+#include "Graphics/guli_shader_preprocess.h"
+#include "Graphics/guli_shader_reload.h"
+#include "Core/guli_thread.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#define GL_RELOAD_INOTIFY 1
+#endif
+
+/* -----------------------------------------------------------------------------
+ * Shader hot reload. Each watched shader keeps the files it was built from;
+ * inotify watches their directories (editors often save by renaming over the
+ * file), and without inotify the files' modification times are compared every
+ * GL_RELOAD_STAT_INTERVAL frames. A changed shader is preprocessed again and
+ * queued on the loader; the finished program is swapped in by the per-frame poll.
+ * ----------------------------------------------------------------------------- */
+
+#define GL_RELOAD_STAT_INTERVAL 30
+
+typedef struct {
+    char* path;
+    int64_t mtime;            /* stat fallback: last seen st_mtime and size */
+    int64_t size;
+} GlReloadFile;
+
+typedef struct {
+    GuliShaderHandle handle;
+    char* vert_path;
+    char* frag_path;
+    GlReloadFile* files;      /* both stages' files, includes included */
+    int file_count;
+    GuliUpload* upload;       /* recompile in flight */
+    int dirty;
+} GlReloadEntry;
+
+typedef struct {
+    int wd;
+    char* dir;                /* as the file paths spell it, trailing '/' included ("" for the cwd) */
+} GlReloadWatch;
+
+struct GlShaderReload {
+    GuliMutex lock;           /* shaders may be loaded from files on any thread */
+    GlReloadEntry* entries;
+    int count;
+    int capacity;
+    GlReloadWatch* watches;
+    int watch_count;
+    int watch_capacity;
+    int fd;                   /* inotify; -1: stat polling */
+    unsigned int frame;
+    GuliShaderReloadStats stats;
+};
+
+static char* GlReloadStrdup(const char* s)
+{
+    if (!s) return NULL;
+    char* copy = GuliMalloc(strlen(s) + 1);
+    if (copy) strcpy(copy, s);
+    return copy;
+}
+
+static void GlReloadStat(const char* path, int64_t* mtime, int64_t* size)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+    {
+        *mtime = *size = -1;
+        return;
+    }
+    *mtime = (int64_t)st.st_mtime;
+    *size = (int64_t)st.st_size;
+}
+
+/* Directory part of path, trailing '/' kept; NULL on allocation failure */
+static char* GlReloadDirName(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    const size_t n = slash ? (size_t)(slash - path + 1) : 0;
+    char* dir = GuliMalloc(n + 1);
+    if (!dir) return NULL;
+    memcpy(dir, path, n);
+    dir[n] = '\0';
+    return dir;
+}
+
+static void GlReloadWatchDir(struct GlShaderReload* r, const char* path)
+{
+#ifdef GL_RELOAD_INOTIFY
+    if (r->fd < 0) return;
+    char* dir = GlReloadDirName(path);
+    if (!dir) return;
+    for (int i = 0; i < r->watch_count; i++)
+    {
+        if (strcmp(r->watches[i].dir, dir) == 0)
+        {
+            GuliFree(dir);
+            return;
+        }
+    }
+    if (r->watch_count == r->watch_capacity)
+    {
+        const int capacity = r->watch_capacity ? r->watch_capacity * 2 : 8;
+        GlReloadWatch* watches = GuliRealloc(r->watches, (size_t)capacity * sizeof(GlReloadWatch));
+        if (!watches)
+        {
+            GuliFree(dir);
+            return;
+        }
+        r->watches = watches;
+        r->watch_capacity = capacity;
+    }
+    const int wd = inotify_add_watch(r->fd, dir[0] ? dir : ".", IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        GuliLog(GULI_LOG_WARNING, GULI_ERROR_FAILED, "Cannot watch shader directory %s", dir[0] ? dir : ".");
+        GuliFree(dir);
+        return;
+    }
+    r->watches[r->watch_count++] = (GlReloadWatch){ wd, dir };
+#else
+    (void)r;
+    (void)path;
+#endif
+}
+
+typedef struct {
+    struct GlShaderReload* reload;
+    GlReloadEntry* entry;
+} GlReloadDependencyCall;
+
+static void GlReloadAddDependency(void* user, const char* file)
+{
+    GlReloadDependencyCall* call = user;
+    GlReloadEntry* e = call->entry;
+    for (int i = 0; i < e->file_count; i++)
+        if (strcmp(e->files[i].path, file) == 0) return;
+
+    GlReloadFile* files = GuliRealloc(e->files, (size_t)(e->file_count + 1) * sizeof(GlReloadFile));
+    if (!files) return;
+    e->files = files;
+    GlReloadFile* f = &files[e->file_count];
+    if (!(f->path = GlReloadStrdup(file))) return;
+    GlReloadStat(file, &f->mtime, &f->size);
+    e->file_count++;
+    GlReloadWatchDir(call->reload, file);
+}
+
+/* Rebuild the entry's file list from the preprocessor's last run of each stage. */
+static void GlReloadRefreshFiles(struct GlShaderReload* r, GlReloadEntry* e)
+{
+    for (int i = 0; i < e->file_count; i++)
+        GuliFree(e->files[i].path);
+    e->file_count = 0;
+
+    GlReloadDependencyCall call = { r, e };
+    if (!GuliShaderPreprocessForEachDependency(e->vert_path, NULL, GlReloadAddDependency, &call))
+        GlReloadAddDependency(&call, e->vert_path);
+    if (!GuliShaderPreprocessForEachDependency(e->frag_path, NULL, GlReloadAddDependency, &call))
+        GlReloadAddDependency(&call, e->frag_path);
+}
+
+static void GlReloadEntryFree(GlReloadEntry* e)
+{
+    if (e->upload) GuliUploadRelease(e->upload);
+    for (int i = 0; i < e->file_count; i++)
+        GuliFree(e->files[i].path);
+    GuliFree(e->files);
+    GuliFree(e->vert_path);
+    GuliFree(e->frag_path);
+}
+
+void GlShaderReloadWatch(GuliShader* shader, const char* vertPath, const char* fragPath)
+{
+    struct GLState* gl = G_State.gl_s;
+    struct GlShaderReload* r = gl ? gl->shader_reload : NULL;
+    if (!r || !shader) return;
+
+    GuliMutexLock(&r->lock);
+    if (r->count == r->capacity)
+    {
+        const int capacity = r->capacity ? r->capacity * 2 : 16;
+        GlReloadEntry* entries = GuliRealloc(r->entries, (size_t)capacity * sizeof(GlReloadEntry));
+        if (!entries)
+        {
+            GuliMutexUnlock(&r->lock);
+            return;
+        }
+        r->entries = entries;
+        r->capacity = capacity;
+    }
+    GlReloadEntry* e = &r->entries[r->count];
+    memset(e, 0, sizeof(*e));
+    e->handle = GlShaderGetHandle(shader);
+    e->vert_path = GlReloadStrdup(vertPath);
+    e->frag_path = GlReloadStrdup(fragPath);
+    if (!e->vert_path || !e->frag_path)
+    {
+        GlReloadEntryFree(e);
+        GuliMutexUnlock(&r->lock);
+        return;
+    }
+    GlReloadRefreshFiles(r, e);
+    GlShaderMakeReloadable(shader);
+    r->count++;
+    r->stats.watched = (uint32_t)r->count;
+    GuliMutexUnlock(&r->lock);
+}
+
+/* Mark every entry that depends on path. */
+static void GlReloadMarkPath(struct GlShaderReload* r, const char* path)
+{
+    for (int i = 0; i < r->count; i++)
+    {
+        GlReloadEntry* e = &r->entries[i];
+        for (int f = 0; f < e->file_count; f++)
+        {
+            if (strcmp(e->files[f].path, path) == 0)
+            {
+                e->dirty = 1;
+                break;
+            }
+        }
+    }
+}
+
+static void GlReloadDetectChanges(struct GlShaderReload* r)
+{
+#ifdef GL_RELOAD_INOTIFY
+    if (r->fd >= 0)
+    {
+        _Alignas(struct inotify_event) char buf[4096];
+        ssize_t n;
+        while ((n = read(r->fd, buf, sizeof(buf))) > 0)
+        {
+            for (char* p = buf; p < buf + n;)
+            {
+                const struct inotify_event* ev = (const struct inotify_event*)p;
+                p += sizeof(struct inotify_event) + ev->len;
+                if (ev->mask & IN_Q_OVERFLOW)
+                {
+                    for (int i = 0; i < r->count; i++) r->entries[i].dirty = 1;
+                    continue;
+                }
+                if (!ev->len) continue;
+                for (int w = 0; w < r->watch_count; w++)
+                {
+                    if (r->watches[w].wd != ev->wd) continue;
+                    char path[4096];
+                    const int len = snprintf(path, sizeof(path), "%s%s", r->watches[w].dir, ev->name);
+                    if (len > 0 && (size_t)len < sizeof(path)) GlReloadMarkPath(r, path);
+                    break;
+                }
+            }
+        }
+        return;
+    }
+#endif
+    if (++r->frame % GL_RELOAD_STAT_INTERVAL) return;
+    for (int i = 0; i < r->count; i++)
+    {
+        GlReloadEntry* e = &r->entries[i];
+        for (int f = 0; f < e->file_count; f++)
+        {
+            int64_t mtime, size;
+            GlReloadStat(e->files[f].path, &mtime, &size);
+            if (mtime != e->files[f].mtime || size != e->files[f].size)
+            {
+                e->files[f].mtime = mtime;
+                e->files[f].size = size;
+                e->dirty = 1;
+            }
+        }
+    }
+}
+
+/* Advance one entry; returns 0 once its shader is gone. */
+static int GlReloadUpdate(struct GlShaderReload* r, GlReloadEntry* e)
+{
+    GuliShader* shader = GlShaderFromHandle(e->handle);
+    if (!shader) return 0;
+
+    if (e->upload)
+    {
+        const GuliUploadStatus status = GuliUploadPoll(e->upload);
+        if (status == GULI_UPLOAD_PENDING) return 1;
+        if (status == GULI_UPLOAD_READY)
+        {
+            GlShaderReplaceProgram(shader, GuliUploadGetShader(e->upload));
+            r->stats.reloads++;
+            GuliLog(GULI_LOG_INFO, 0, "Reloaded shader %s + %s", e->vert_path, e->frag_path);
+        }
+        else
+        {
+            r->stats.failures++;
+            GuliLog(GULI_LOG_WARNING, GULI_ERROR_FAILED, "Shader %s + %s failed to rebuild; keeping the last good program",
+                e->vert_path, e->frag_path);
+        }
+        GuliUploadRelease(e->upload);
+        e->upload = NULL;
+    }
+    if (!e->dirty) return 1;
+
+    /* Edits that land while a compile runs are picked up when it finishes */
+    e->dirty = 0;
+    char* vs = GuliShaderPreprocess(e->vert_path, NULL, NULL, 0);
+    char* fs = GuliShaderPreprocess(e->frag_path, NULL, NULL, 0);
+    if (vs && fs) e->upload = GuliUploadShader(vs, fs);
+    GuliFree(vs);
+    GuliFree(fs);
+    if (!e->upload)
+    {
+        r->stats.failures++;
+        GuliLog(GULI_LOG_WARNING, GULI_ERROR_FAILED, "Shader %s + %s could not be reprocessed; keeping the last good program",
+            e->vert_path, e->frag_path);
+    }
+    /* #includes may have changed */
+    GlReloadRefreshFiles(r, e);
+    return 1;
+}
+
+void GlShaderReloadPoll(struct GLState* gl)
+{
+    struct GlShaderReload* r = gl ? gl->shader_reload : NULL;
+    if (!r) return;
+
+    GuliMutexLock(&r->lock);
+    GlReloadDetectChanges(r);
+    for (int i = 0; i < r->count;)
+    {
+        if (GlReloadUpdate(r, &r->entries[i]))
+        {
+            i++;
+            continue;
+        }
+        GlReloadEntryFree(&r->entries[i]);
+        r->entries[i] = r->entries[--r->count];
+    }
+    r->stats.watched = (uint32_t)r->count;
+    GuliMutexUnlock(&r->lock);
+}
+
+void GlShaderReloadFree(struct GLState* gl)
+{
+    struct GlShaderReload* r = gl ? gl->shader_reload : NULL;
+    if (!r) return;
+    gl->shader_reload = NULL;
+
+    for (int i = 0; i < r->count; i++)
+        GlReloadEntryFree(&r->entries[i]);
+    GuliFree(r->entries);
+    for (int i = 0; i < r->watch_count; i++)
+        GuliFree(r->watches[i].dir);
+    GuliFree(r->watches);
+#ifdef GL_RELOAD_INOTIFY
+    if (r->fd >= 0) close(r->fd);
+#endif
+    GuliMutexDestroy(&r->lock);
+    GuliFree(r);
+}
+
+/* -----------------------------------------------------------------------------
+ * Public API
+ * ----------------------------------------------------------------------------- */
+
+int GuliShaderHotReloadEnable(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    if (!gl) return 0;
+    if (gl->shader_reload) return 1;
+
+    struct GlShaderReload* r = GuliCalloc(1, sizeof(struct GlShaderReload));
+    if (!r) return 0;
+    if (!GuliMutexInit(&r->lock))
+    {
+        GuliFree(r);
+        return 0;
+    }
+    r->fd = -1;
+#ifdef GL_RELOAD_INOTIFY
+    r->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (r->fd < 0)
+        GuliLog(GULI_LOG_WARNING, 0, "inotify unavailable; shader hot reload polls modification times");
+#endif
+    gl->shader_reload = r;
+    return 1;
+}
+
+void GuliShaderHotReloadDisable(void)
+{
+    GlShaderReloadFree(G_State.gl_s);
+}
+
+int GuliShaderHotReloadIsEnabled(void)
+{
+    struct GLState* gl = G_State.gl_s;
+    return gl && gl->shader_reload;
+}
+
+void GuliShaderHotReloadGetStats(GuliShaderReloadStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    struct GLState* gl = G_State.gl_s;
+    struct GlShaderReload* r = gl ? gl->shader_reload : NULL;
+    if (!r) return;
+    GuliMutexLock(&r->lock);
+    *stats = r->stats;
+    GuliMutexUnlock(&r->lock);
+}
@@ -1,4 +1,5 @@
 #include "Graphics/OpenGL/guli_gl.h"
+#include "Graphics/OpenGL/guli_gl_commands.h"
 #include "Graphics/guli_texture.h"
 
 #include <glad/glad.h>
@@ -8,18 +9,47 @@
  * OpenGL texture backend
  * ----------------------------------------------------------------------------- */
 
-GuliTexture* GlTextureCreateFromPixels(int width, int height, const unsigned char* pixels)
+GuliTexture* GlTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels);
+
+/* Uploads run on the render thread in render-thread mode (pixels stay the caller's until it returns). */
+typedef struct {
+    int width, height, levels;
+    const unsigned char* const* pixels;
+    GuliTexture* texture;
+} GlTextureCreateCall;
+
+static void GlTextureCreateInvoke(void* arg)
+{
+    GlTextureCreateCall* call = arg;
+    call->texture = GlTextureCreateFromLevels(call->width, call->height, call->levels, call->pixels);
+}
+
+GuliTexture* GlTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels)
 {
-    if (width <= 0 || height <= 0) return NULL;
+    if (width <= 0 || height <= 0 || levels <= 0 || !pixels) return NULL;
+    if (GlRenderThreadIsRemote())
+    {
+        GlTextureCreateCall call = { width, height, levels, pixels, NULL };
+        GlRenderThreadInvoke(GlTextureCreateInvoke, &call);
+        return call.texture;
+    }
 
-    GuliTexture* tex = (GuliTexture*)calloc(1, sizeof(GuliTexture));
+    GuliTexture* tex = GuliTextureAlloc();
     if (!tex) return NULL;
 
     unsigned int id = 0;
+    size_t bytes = 0;
     glGenTextures(1, &id);
     glBindTexture(GL_TEXTURE_2D, id);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    for (int level = 0; level < levels; level++)
+    {
+        const int lw = (width >> level) > 0 ? (width >> level) : 1;
+        const int lh = (height >> level) > 0 ? (height >> level) : 1;
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, lw, lh, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels[level]);
+        bytes += (size_t)lw * (size_t)lh * 4;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -28,17 +58,23 @@ GuliTexture* GlTextureCreateFromPixels(int width, int height, const unsigned cha
     tex->_backend = (void*)(uintptr_t)id;
     tex->width = width;
     tex->height = height;
+    tex->_bytes = bytes;
+    GuliMemoryTrack(GULI_MEMORY_TEXTURE, bytes);
     return tex;
 }
 
+GuliTexture* GlTextureCreateFromPixels(int width, int height, const unsigned char* pixels)
+{
+    return GlTextureCreateFromLevels(width, height, 1, &pixels);
+}
+
 void GlTextureUnload(GuliTexture* texture)
 {
     if (!texture) return;
-    if (texture->_backend)
-    {
-        unsigned int id = (unsigned int)(uintptr_t)texture->_backend;
-        glDeleteTextures(1, &id);
-        texture->_backend = NULL;
-    }
+    if (texture->_backend) GuliMemoryUntrack(GULI_MEMORY_TEXTURE, texture->_bytes);
+    texture->_bytes = 0;
+    /* Deleted (and the slot recycled) once frames that may sample it have retired */
+    GlRetireObject(GL_RETIRE_TEXTURE, (unsigned int)(uintptr_t)texture->_backend, &G_TexturePool, texture->_handle);
+    texture->_backend = NULL;
     texture->width = texture->height = 0;
 }
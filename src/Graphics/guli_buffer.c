@@ -0,0 +1,114 @@
+#include "Graphics/guli_buffer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef GULI_BACKEND_METAL
+extern int MetalBufferCreate(GuliBuffer* buffer, const void* data);
+extern void MetalBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size);
+extern void MetalBufferUnload(GuliBuffer* buffer);
+#endif
+
+#ifdef GULI_BACKEND_OPENGL
+extern int GlBufferCreate(GuliBuffer* buffer, const void* data);
+extern void GlBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size);
+extern void GlBufferUnload(GuliBuffer* buffer);
+#endif
+
+GuliPool G_BufferPool = GULI_POOL_INIT(sizeof(GuliBuffer), GULI_RESOURCE_NAME_MAX);
+
+GuliBuffer* GuliBufferCreate(GuliBufferType type, const void* data, size_t size)
+{
+    if (size == 0) return NULL;
+
+    GuliHandle handle;
+    GuliBuffer* buffer = GuliPoolAlloc(&G_BufferPool, &handle);
+    if (!buffer) return NULL;
+    buffer->_handle = handle;
+    buffer->type = type;
+    buffer->size = size;
+
+    int ok = 0;
+#ifdef GULI_BACKEND_METAL
+    ok = MetalBufferCreate(buffer, data);
+#endif
+
+#ifdef GULI_BACKEND_OPENGL
+    ok = GlBufferCreate(buffer, data);
+#endif
+
+    (void)data;
+    if (!ok)
+    {
+        GuliPoolFree(&G_BufferPool, handle);
+        return NULL;
+    }
+    GuliMemoryTrack(GULI_MEMORY_BUFFER, size);
+    return buffer;
+}
+
+void GuliBufferUpdate(GuliBuffer* buffer, size_t offset, const void* data, size_t size)
+{
+    if (!buffer || !buffer->_backend || !data || size == 0) return;
+    if (offset > buffer->size || size > buffer->size - offset)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliBufferUpdate: range outside the buffer");
+        return;
+    }
+
+#ifdef GULI_BACKEND_METAL
+    MetalBufferUpdate(buffer, offset, data, size);
+#endif
+
+#ifdef GULI_BACKEND_OPENGL
+    GlBufferUpdate(buffer, offset, data, size);
+#endif
+}
+
+void GuliBufferUnload(GuliBuffer* buffer)
+{
+    if (!buffer) return;
+
+    /* Handles go stale now; the slot stays reserved until the backend retires the buffer */
+    const GuliHandle handle = buffer->_handle;
+    GuliPoolRelease(&G_BufferPool, handle);
+    if (buffer->_backend) GuliMemoryUntrack(GULI_MEMORY_BUFFER, buffer->size);
+
+#ifdef GULI_BACKEND_METAL
+    MetalBufferUnload(buffer);
+    GuliPoolRecycle(&G_BufferPool, handle);  /* in-flight command buffers retain the MTLBuffer */
+#endif
+
+#ifdef GULI_BACKEND_OPENGL
+    GlBufferUnload(buffer);  /* recycles the slot once its frames have retired */
+#endif
+}
+
+int GuliBufferIsValid(const GuliBuffer* buffer)
+{
+    return (buffer && buffer->_backend) ? 1 : 0;
+}
+
+GuliBufferHandle GuliBufferGetHandle(const GuliBuffer* buffer)
+{
+    return buffer ? buffer->_handle : GULI_HANDLE_NULL;
+}
+
+GuliBuffer* GuliBufferFromHandle(GuliBufferHandle handle)
+{
+    return GuliPoolGet(&G_BufferPool, handle);
+}
+
+void GuliBufferSetName(GuliBuffer* buffer, const char* name)
+{
+    char* cold = buffer ? GuliPoolGetCold(&G_BufferPool, buffer->_handle) : NULL;
+    if (!cold) return;
+    strncpy(cold, name ? name : "", GULI_RESOURCE_NAME_MAX - 1);
+    cold[GULI_RESOURCE_NAME_MAX - 1] = '\0';
+}
+
+const char* GuliBufferGetName(const GuliBuffer* buffer)
+{
+    const char* cold = buffer ? GuliPoolGetCold(&G_BufferPool, buffer->_handle) : NULL;
+    return cold ? cold : "";
+}
@@ -0,0 +1,537 @@
+#include "Graphics/guli_recorder.h"
+#include "Core/guli_thread.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef GULI_BACKEND_OPENGL
+extern int GlRecorderAttach(GuliRecorder* recorder);
+extern void GlRecorderDetach(void);
+#endif
+
+/* -----------------------------------------------------------------------------
+ * Frame recorder: bounded frame pool, encoder workers, QOI / Y4M writers
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_RECORD_DEFAULT_QUEUE 8
+#define GULI_RECORD_MAX_WORKERS 8
+#define GULI_RECORD_PATH_MAX 1024
+
+typedef struct {
+    unsigned char* pixels;
+    size_t capacity;
+    int width;
+    int height;
+    int flipY;
+    uint64_t index;
+} RecorderFrame;
+
+struct GuliRecorder {
+    GuliRecordFormat format;
+    char path[GULI_RECORD_PATH_MAX];
+    int fps;
+    int drop_when_full;
+
+    RecorderFrame* frames;
+    int frame_count;
+    int* free_list;
+    int free_count;
+    int* ready;          /* FIFO ring of frame indices waiting for an encoder */
+    int ready_head;
+    int ready_count;
+    int acquired;        /* slot held by the backend between Acquire and Submit, -1 if none */
+
+    GuliMutex lock;
+    GuliCond cond_ready;
+    GuliCond cond_free;
+    GuliCond cond_order;
+
+    GuliThread threads[GULI_RECORD_MAX_WORKERS];
+    int thread_count;
+    int stopping;
+
+    uint64_t next_index;
+    uint64_t next_write;  /* Y4M: next frame index allowed to write */
+    int stream_header;    /* Y4M: stream header written (with the first frame that was) */
+    FILE* stream;
+    int stream_width;
+    int stream_height;
+
+    GuliRecorderStats stats;
+};
+
+/* ---- QOI encoder (https://qoiformat.org) ---- */
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xc0
+#define QOI_OP_RGB   0xfe
+#define QOI_HASH(r, g, b, a) (((r) * 3 + (g) * 5 + (b) * 7 + (a) * 11) % 64)
+
+static void PutBE32(unsigned char* p, uint32_t v)
+{
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+/* Alpha is forced opaque (backbuffer alpha is meaningless), so channels=3 in the header. */
+static size_t QoiEncode(const RecorderFrame* f, unsigned char* out)
+{
+    unsigned char index[64][4];
+    memset(index, 0, sizeof(index));
+
+    size_t p = 0;
+    memcpy(out, "qoif", 4);
+    PutBE32(out + 4, (uint32_t)f->width);
+    PutBE32(out + 8, (uint32_t)f->height);
+    out[12] = 3;
+    out[13] = 0;
+    p = 14;
+
+    unsigned char pr = 0, pg = 0, pb = 0;
+    int run = 0;
+    const size_t stride = (size_t)f->width * 4;
+
+    for (int y = 0; y < f->height; y++)
+    {
+        const int row = f->flipY ? (f->height - 1 - y) : y;
+        const unsigned char* px = f->pixels + (size_t)row * stride;
+        for (int x = 0; x < f->width; x++, px += 4)
+        {
+            const unsigned char r = px[0], g = px[1], b = px[2];
+            if (r == pr && g == pg && b == pb)
+            {
+                if (++run == 62) { out[p++] = (unsigned char)(QOI_OP_RUN | (run - 1)); run = 0; }
+                continue;
+            }
+            if (run > 0) { out[p++] = (unsigned char)(QOI_OP_RUN | (run - 1)); run = 0; }
+
+            const int h = QOI_HASH(r, g, b, 255);
+            if (index[h][0] == r && index[h][1] == g && index[h][2] == b && index[h][3] == 255)
+            {
+                out[p++] = (unsigned char)(QOI_OP_INDEX | h);
+            }
+            else
+            {
+                index[h][0] = r; index[h][1] = g; index[h][2] = b; index[h][3] = 255;
+
+                const signed char vr = (signed char)(r - pr);
+                const signed char vg = (signed char)(g - pg);
+                const signed char vb = (signed char)(b - pb);
+                const signed char vg_r = (signed char)(vr - vg);
+                const signed char vg_b = (signed char)(vb - vg);
+
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+                {
+                    out[p++] = (unsigned char)(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                }
+                else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8)
+                {
+                    out[p++] = (unsigned char)(QOI_OP_LUMA | (vg + 32));
+                    out[p++] = (unsigned char)((vg_r + 8) << 4 | (vg_b + 8));
+                }
+                else
+                {
+                    out[p++] = QOI_OP_RGB;
+                    out[p++] = r; out[p++] = g; out[p++] = b;
+                }
+            }
+            pr = r; pg = g; pb = b;
+        }
+    }
+    if (run > 0) out[p++] = (unsigned char)(QOI_OP_RUN | (run - 1));
+
+    static const unsigned char padding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    memcpy(out + p, padding, sizeof(padding));
+    return p + sizeof(padding);
+}
+
+static size_t QoiMaxSize(int width, int height)
+{
+    return (size_t)width * (size_t)height * 4 + 14 + 8;
+}
+
+/* ---- Y4M (BT.601 limited range, 4:4:4 planar) ---- */
+
+static size_t Y4mEncode(const RecorderFrame* f, unsigned char* out)
+{
+    memcpy(out, "FRAME\n", 6);
+    const size_t plane = (size_t)f->width * (size_t)f->height;
+    unsigned char* py = out + 6;
+    unsigned char* pu = py + plane;
+    unsigned char* pv = pu + plane;
+    const size_t stride = (size_t)f->width * 4;
+
+    for (int y = 0; y < f->height; y++)
+    {
+        const int row = f->flipY ? (f->height - 1 - y) : y;
+        const unsigned char* px = f->pixels + (size_t)row * stride;
+        for (int x = 0; x < f->width; x++, px += 4)
+        {
+            const int r = px[0], g = px[1], b = px[2];
+            *py++ = (unsigned char)(16 + ((66 * r + 129 * g + 25 * b + 128) >> 8));
+            *pu++ = (unsigned char)(128 + ((-38 * r - 74 * g + 112 * b + 128) >> 8));
+            *pv++ = (unsigned char)(128 + ((112 * r - 94 * g - 18 * b + 128) >> 8));
+        }
+    }
+    return 6 + plane * 3;
+}
+
+/* ---- Workers ---- */
+
+static size_t RecorderWriteQoi(GuliRecorder* rec, const RecorderFrame* f, const unsigned char* data, size_t size)
+{
+    char name[GULI_RECORD_PATH_MAX + 32];
+    snprintf(name, sizeof(name), "%s/frame_%06llu.qoi", rec->path, (unsigned long long)f->index);
+    FILE* out = fopen(name, "wb");
+    if (!out) return 0;
+    size_t n = fwrite(data, 1, size, out);
+    fclose(out);
+    return (n == size) ? n : 0;
+}
+
+static size_t RecorderWriteY4m(GuliRecorder* rec, const RecorderFrame* f, const unsigned char* data, size_t size)
+{
+    /* Encoding is parallel; writes are serialized in frame order. */
+    GuliMutexLock(&rec->lock);
+    while (rec->next_write != f->index)
+        GuliCondWait(&rec->cond_order, &rec->lock);
+    GuliMutexUnlock(&rec->lock);
+
+    /* Writers run one at a time in frame order, so the header flag needs no lock. A frame is only
+       written after a header, so a failed first frame cannot leave the stream headerless. */
+    size_t n = 0;
+    if (!rec->stream_header)
+    {
+        const int header = fprintf(rec->stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", f->width, f->height, rec->fps);
+        if (header > 0)
+        {
+            rec->stream_header = 1;
+            n = (size_t)header;
+        }
+    }
+    if (rec->stream_header)
+    {
+        const size_t frame = fwrite(data, 1, size, rec->stream);
+        n = (frame == size) ? n + frame : 0;
+    }
+
+    GuliMutexLock(&rec->lock);
+    rec->next_write++;
+    GuliCondBroadcast(&rec->cond_order);
+    GuliMutexUnlock(&rec->lock);
+    return n;
+}
+
+static void* RecorderWorker(void* arg)
+{
+    GuliRecorder* rec = (GuliRecorder*)arg;
+    unsigned char* scratch = NULL;
+    size_t scratchCap = 0;
+
+    GuliMutexLock(&rec->lock);
+    for (;;)
+    {
+        while (rec->ready_count == 0 && !rec->stopping)
+            GuliCondWait(&rec->cond_ready, &rec->lock);
+        if (rec->ready_count == 0)
+            break;
+
+        const int slot = rec->ready[rec->ready_head];
+        rec->ready_head = (rec->ready_head + 1) % rec->frame_count;
+        rec->ready_count--;
+        GuliMutexUnlock(&rec->lock);
+
+        RecorderFrame* f = &rec->frames[slot];
+        const size_t need = (rec->format == GULI_RECORD_QOI)
+            ? QoiMaxSize(f->width, f->height)
+            : 6 + (size_t)f->width * (size_t)f->height * 3;
+        if (need > scratchCap)
+        {
+            unsigned char* grown = (unsigned char*)GuliRealloc(scratch, need);
+            if (grown) { scratch = grown; scratchCap = need; }
+        }
+
+        size_t written = 0;
+        if (scratch && need <= scratchCap)
+        {
+            if (rec->format == GULI_RECORD_QOI)
+                written = RecorderWriteQoi(rec, f, scratch, QoiEncode(f, scratch));
+            else
+                written = RecorderWriteY4m(rec, f, scratch, Y4mEncode(f, scratch));
+        }
+        else if (rec->format == GULI_RECORD_Y4M)
+        {
+            /* Keep the ordering chain moving even when this frame is lost. */
+            GuliMutexLock(&rec->lock);
+            while (rec->next_write != f->index)
+                GuliCondWait(&rec->cond_order, &rec->lock);
+            rec->next_write++;
+            GuliCondBroadcast(&rec->cond_order);
+            GuliMutexUnlock(&rec->lock);
+        }
+
+        GuliMutexLock(&rec->lock);
+        if (written)
+        {
+            rec->stats.frames_written++;
+            rec->stats.bytes_written += written;
+        }
+        else
+        {
+            rec->stats.frames_dropped++;
+        }
+        rec->free_list[rec->free_count++] = slot;
+        GuliCondSignal(&rec->cond_free);
+    }
+    GuliMutexUnlock(&rec->lock);
+
+    GuliFree(scratch);
+    return NULL;
+}
+
+/* ---- Backend interface ---- */
+
+unsigned char* GuliRecorderAcquireFrame(GuliRecorder* rec, int width, int height)
+{
+    if (!rec || width <= 0 || height <= 0) return NULL;
+
+    GuliMutexLock(&rec->lock);
+    rec->stats.frames_captured++;
+
+    if (rec->format == GULI_RECORD_Y4M && rec->stream_width &&
+        (rec->stream_width != width || rec->stream_height != height))
+    {
+        rec->stats.frames_dropped++;
+        GuliMutexUnlock(&rec->lock);
+        return NULL;
+    }
+
+    if (rec->free_count == 0)
+    {
+        if (rec->drop_when_full)
+        {
+            rec->stats.frames_dropped++;
+            GuliMutexUnlock(&rec->lock);
+            return NULL;
+        }
+        const double t0 = GuliGetTime();
+        while (rec->free_count == 0)
+            GuliCondWait(&rec->cond_free, &rec->lock);
+        rec->stats.stall_seconds += GuliGetTime() - t0;
+    }
+
+    const int slot = rec->free_list[--rec->free_count];
+    RecorderFrame* f = &rec->frames[slot];
+    const size_t need = (size_t)width * (size_t)height * 4;
+    if (need > f->capacity)
+    {
+        unsigned char* grown = (unsigned char*)GuliRealloc(f->pixels, need);
+        if (!grown)
+        {
+            rec->free_list[rec->free_count++] = slot;
+            rec->stats.frames_dropped++;
+            GuliMutexUnlock(&rec->lock);
+            return NULL;
+        }
+        f->pixels = grown;
+        f->capacity = need;
+    }
+
+    if (rec->format == GULI_RECORD_Y4M && !rec->stream_width)
+    {
+        rec->stream_width = width;
+        rec->stream_height = height;
+    }
+
+    f->width = width;
+    f->height = height;
+    rec->acquired = slot;
+    GuliMutexUnlock(&rec->lock);
+    return f->pixels;
+}
+
+void GuliRecorderSubmitFrame(GuliRecorder* rec, unsigned char* pixels, int flipY)
+{
+    if (!rec || rec->acquired < 0) return;
+
+    GuliMutexLock(&rec->lock);
+    const int slot = rec->acquired;
+    rec->acquired = -1;
+    if (!pixels || rec->frames[slot].pixels != pixels)
+    {
+        /* Readback failed: return the slot without consuming a frame index. */
+        rec->free_list[rec->free_count++] = slot;
+        rec->stats.frames_dropped++;
+        GuliCondSignal(&rec->cond_free);
+        GuliMutexUnlock(&rec->lock);
+        return;
+    }
+    rec->frames[slot].flipY = flipY;
+    rec->frames[slot].index = rec->next_index++;
+
+    const int tail = (rec->ready_head + rec->ready_count) % rec->frame_count;
+    rec->ready[tail] = slot;
+    rec->ready_count++;
+    if ((uint32_t)rec->ready_count > rec->stats.queue_high_water)
+        rec->stats.queue_high_water = (uint32_t)rec->ready_count;
+    GuliCondSignal(&rec->cond_ready);
+    GuliMutexUnlock(&rec->lock);
+}
+
+/* ---- Public API ---- */
+
+static void RecorderFree(GuliRecorder* rec)
+{
+    if (!rec) return;
+    if (rec->frames)
+    {
+        for (int i = 0; i < rec->frame_count; i++)
+            GuliFree(rec->frames[i].pixels);
+    }
+    GuliFree(rec->frames);
+    GuliFree(rec->free_list);
+    GuliFree(rec->ready);
+    if (rec->stream) fclose(rec->stream);
+    GuliFree(rec);
+}
+
+static void RecorderJoinWorkers(GuliRecorder* rec)
+{
+    GuliMutexLock(&rec->lock);
+    rec->stopping = 1;
+    GuliCondBroadcast(&rec->cond_ready);
+    GuliMutexUnlock(&rec->lock);
+
+    for (int i = 0; i < rec->thread_count; i++)
+        GuliThreadJoin(rec->threads[i]);
+    rec->thread_count = 0;
+
+    GuliCondDestroy(&rec->cond_order);
+    GuliCondDestroy(&rec->cond_free);
+    GuliCondDestroy(&rec->cond_ready);
+    GuliMutexDestroy(&rec->lock);
+}
+
+GuliRecorder* GuliRecorderStart(const GuliRecorderDesc* desc)
+{
+    if (!desc || !desc->path || !desc->path[0]) return NULL;
+    if (strlen(desc->path) >= GULI_RECORD_PATH_MAX)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Recorder path too long");
+        return NULL;
+    }
+
+#ifdef GULI_BACKEND_METAL
+    /* CAMetalLayer drawables are framebufferOnly; there is no readback path yet. */
+    GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Frame recording is not supported on the Metal backend");
+    return NULL;
+#endif
+
+    GuliRecorder* rec = (GuliRecorder*)GuliCalloc(1, sizeof(GuliRecorder));
+    if (!rec) return NULL;
+
+    rec->format = desc->format;
+    rec->fps = desc->fps > 0 ? desc->fps : 60;
+    rec->drop_when_full = desc->drop_when_full;
+    rec->acquired = -1;
+    strcpy(rec->path, desc->path);
+
+    rec->frame_count = desc->queue_frames > 0 ? desc->queue_frames : GULI_RECORD_DEFAULT_QUEUE;
+    rec->frames = (RecorderFrame*)GuliCalloc((size_t)rec->frame_count, sizeof(RecorderFrame));
+    rec->free_list = (int*)GuliCalloc((size_t)rec->frame_count, sizeof(int));
+    rec->ready = (int*)GuliCalloc((size_t)rec->frame_count, sizeof(int));
+    if (!rec->frames || !rec->free_list || !rec->ready)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate recorder frame queue");
+        RecorderFree(rec);
+        return NULL;
+    }
+    for (int i = 0; i < rec->frame_count; i++)
+        rec->free_list[i] = rec->frame_count - 1 - i;
+    rec->free_count = rec->frame_count;
+
+    if (rec->format == GULI_RECORD_QOI)
+    {
+        if (mkdir(rec->path, 0755) != 0 && errno != EEXIST)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create recorder output directory");
+            RecorderFree(rec);
+            return NULL;
+        }
+    }
+    else
+    {
+        rec->stream = fopen(rec->path, "wb");
+        if (!rec->stream)
+        {
+            GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to open recorder output file");
+            RecorderFree(rec);
+            return NULL;
+        }
+    }
+
+    if (!GuliMutexInit(&rec->lock) || !GuliCondInit(&rec->cond_ready) ||
+        !GuliCondInit(&rec->cond_free) || !GuliCondInit(&rec->cond_order))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create recorder locks");
+        RecorderFree(rec);
+        return NULL;
+    }
+
+    int workers = desc->workers > 0 ? desc->workers : GuliGetCpuCount() / 2;
+    if (workers < 1) workers = 1;
+    if (workers > GULI_RECORD_MAX_WORKERS) workers = GULI_RECORD_MAX_WORKERS;
+    for (int i = 0; i < workers; i++)
+    {
+        if (!GuliThreadCreate(&rec->threads[i], RecorderWorker, rec)) break;
+        rec->thread_count++;
+    }
+    if (rec->thread_count == 0)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to start recorder threads");
+        RecorderJoinWorkers(rec);
+        RecorderFree(rec);
+        return NULL;
+    }
+
+#ifdef GULI_BACKEND_OPENGL
+    if (!GlRecorderAttach(rec))
+    {
+        RecorderJoinWorkers(rec);
+        RecorderFree(rec);
+        return NULL;
+    }
+#endif
+
+    return rec;
+}
+
+void GuliRecorderStop(GuliRecorder* recorder)
+{
+    if (!recorder) return;
+
+#ifdef GULI_BACKEND_OPENGL
+    GlRecorderDetach();
+#endif
+
+    RecorderJoinWorkers(recorder);
+    RecorderFree(recorder);
+}
+
+void GuliRecorderGetStats(GuliRecorder* recorder, GuliRecorderStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!recorder) return;
+
+    GuliMutexLock(&recorder->lock);
+    *stats = recorder->stats;
+    GuliMutexUnlock(&recorder->lock);
+}
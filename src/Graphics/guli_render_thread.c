@@ -0,0 +1,34 @@
+#include "Graphics/guli_render_thread.h"
+#include "Core/guli_core.h"
+
+#ifdef GULI_BACKEND_OPENGL
+extern int GlRenderThreadStart(void);
+extern void GlRenderThreadStop(void);
+extern int GlRenderThreadIsActive(void);
+#endif
+
+int GuliRenderThreadStart(void)
+{
+#ifdef GULI_BACKEND_OPENGL
+    return GlRenderThreadStart();
+#else
+    GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Render-thread mode is only available with the OpenGL backend");
+    return 0;
+#endif
+}
+
+void GuliRenderThreadStop(void)
+{
+#ifdef GULI_BACKEND_OPENGL
+    GlRenderThreadStop();
+#endif
+}
+
+int GuliRenderThreadIsActive(void)
+{
+#ifdef GULI_BACKEND_OPENGL
+    return GlRenderThreadIsActive();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,404 @@
+#include "Graphics/guli_resource_cache.h"
+#include "Graphics/guli_graphics.h"
+#include "Core/guli_hash.h"
+#include "Core/guli_thread.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* -----------------------------------------------------------------------------
+ * Entries live in two chained hash tables: by key (acquire) and by object
+ * pointer (retain/release). Loads and unloads call the graphics backend, so they
+ * only run on the thread that created the cache, and an entry is inserted once
+ * its object has loaded. The mutex guards the tables against retains and
+ * releases from other threads; it is not held while loading. A release on
+ * another thread leaves eviction to the owner's next call.
+ * ----------------------------------------------------------------------------- */
+
+#define GULI_RC_INITIAL_BUCKETS 64
+#define GULI_RC_KEY_MAX (2 * PATH_MAX + 16)  /* tag, flags and up to two paths */
+
+typedef enum {
+    GULI_RC_TEXTURE = 0,
+    GULI_RC_SHADER,
+} GuliResourceKind;
+
+typedef struct GuliCacheEntry {
+    struct GuliCacheEntry* next_key;      /* chain in the key table */
+    struct GuliCacheEntry* next_object;   /* chain in the object table */
+    struct GuliCacheEntry* lru_prev;      /* on the LRU list while unreferenced */
+    struct GuliCacheEntry* lru_next;
+    void* object;
+    size_t bytes;
+    uint32_t hash;
+    int refs;
+    GuliResourceKind kind;
+    char key[];                           /* kind tag, parameters and path(s) */
+} GuliCacheEntry;
+
+struct GuliResourceCache {
+    GuliMutex lock;
+    GuliCacheEntry** by_key;
+    GuliCacheEntry** by_object;
+    size_t bucket_count;                  /* power of two, shared by both tables */
+    GuliCacheEntry* lru_head;             /* least recently released */
+    GuliCacheEntry* lru_tail;
+    GuliResourceCacheStats stats;
+    GuliThread owner;                     /* drawing thread: the only one that loads or unloads */
+};
+
+/* Loads and unloads create and delete backend objects, which the owner's context must be current for */
+static int GuliRcOnOwner(const GuliResourceCache* cache, const char* func)
+{
+    if (GuliThreadEqual(GuliThreadSelf(), cache->owner)) return 1;
+    GuliLog(GULI_LOG_ERROR, GULI_ERROR_ASSERTION_FAILED, "%s: called off the thread that created the cache", func);
+    return 0;
+}
+
+static uint32_t GuliRcHashPointer(const void* p)
+{
+    uint64_t x = (uint64_t)(uintptr_t)p;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static GuliCacheEntry** GuliRcKeySlot(GuliResourceCache* cache, uint32_t hash, const char* key)
+{
+    GuliCacheEntry** slot = &cache->by_key[hash & (cache->bucket_count - 1)];
+    while (*slot && ((*slot)->hash != hash || strcmp((*slot)->key, key) != 0))
+        slot = &(*slot)->next_key;
+    return slot;
+}
+
+static GuliCacheEntry** GuliRcObjectSlot(GuliResourceCache* cache, const void* object)
+{
+    GuliCacheEntry** slot = &cache->by_object[GuliRcHashPointer(object) & (cache->bucket_count - 1)];
+    while (*slot && (*slot)->object != object)
+        slot = &(*slot)->next_object;
+    return slot;
+}
+
+/* Double both tables once entries outnumber buckets. */
+static void GuliRcGrow(GuliResourceCache* cache)
+{
+    if (cache->stats.entries < cache->bucket_count) return;
+
+    const size_t count = cache->bucket_count * 2;
+    GuliCacheEntry** by_key = GuliCalloc(count, sizeof(GuliCacheEntry*));
+    GuliCacheEntry** by_object = GuliCalloc(count, sizeof(GuliCacheEntry*));
+    if (!by_key || !by_object)
+    {
+        /* Longer chains, still correct */
+        GuliFree(by_key);
+        GuliFree(by_object);
+        return;
+    }
+    for (size_t i = 0; i < cache->bucket_count; i++)
+    {
+        for (GuliCacheEntry* e = cache->by_key[i]; e;)
+        {
+            GuliCacheEntry* next = e->next_key;
+            GuliCacheEntry** slot = &by_key[e->hash & (count - 1)];
+            e->next_key = *slot;
+            *slot = e;
+            e = next;
+        }
+        for (GuliCacheEntry* e = cache->by_object[i]; e;)
+        {
+            GuliCacheEntry* next = e->next_object;
+            GuliCacheEntry** slot = &by_object[GuliRcHashPointer(e->object) & (count - 1)];
+            e->next_object = *slot;
+            *slot = e;
+            e = next;
+        }
+    }
+    GuliFree(cache->by_key);
+    GuliFree(cache->by_object);
+    cache->by_key = by_key;
+    cache->by_object = by_object;
+    cache->bucket_count = count;
+}
+
+static void GuliRcLruRemove(GuliResourceCache* cache, GuliCacheEntry* e)
+{
+    if (e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+    else cache->lru_head = e->lru_next;
+    if (e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+    else cache->lru_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = NULL;
+}
+
+static void GuliRcLruPush(GuliResourceCache* cache, GuliCacheEntry* e)
+{
+    e->lru_prev = cache->lru_tail;
+    e->lru_next = NULL;
+    if (cache->lru_tail) cache->lru_tail->lru_next = e;
+    else cache->lru_head = e;
+    cache->lru_tail = e;
+}
+
+static void GuliRcUnloadObject(GuliResourceKind kind, void* object)
+{
+    if (kind == GULI_RC_TEXTURE) GuliTextureUnload(object);
+    else GuliShaderUnload(object);
+}
+
+/* Unlink an entry from both tables and free it; returns the object to unload. */
+static void* GuliRcRemove(GuliResourceCache* cache, GuliCacheEntry* e)
+{
+    GuliCacheEntry** slot = GuliRcKeySlot(cache, e->hash, e->key);
+    if (*slot == e) *slot = e->next_key;
+    slot = GuliRcObjectSlot(cache, e->object);
+    if (*slot == e) *slot = e->next_object;
+
+    void* object = e->object;
+    cache->stats.entries--;
+    cache->stats.bytes -= e->bytes;
+    GuliFree(e);
+    return object;
+}
+
+/* Evict unreferenced entries, oldest first, until bytes <= target. target 0 empties the LRU list.
+   Objects are unloaded with the lock held: unloads only queue deletions and never re-enter the cache. */
+static void GuliRcEvict(GuliResourceCache* cache, size_t target)
+{
+    GuliCacheEntry* e = cache->lru_head;
+    while (e && (target == 0 || cache->stats.bytes > target))
+    {
+        GuliCacheEntry* next = e->lru_next;
+        if (target == 0 || e->bytes)
+        {
+            const GuliResourceKind kind = e->kind;
+            GuliRcLruRemove(cache, e);
+            GuliRcUnloadObject(kind, GuliRcRemove(cache, e));
+            cache->stats.evictions++;
+        }
+        e = next;
+    }
+}
+
+GuliResourceCache* GuliResourceCacheCreate(size_t budget_bytes)
+{
+    GuliResourceCache* cache = GuliCalloc(1, sizeof(GuliResourceCache));
+    if (!cache)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate resource cache");
+        return NULL;
+    }
+    cache->bucket_count = GULI_RC_INITIAL_BUCKETS;
+    cache->by_key = GuliCalloc(cache->bucket_count, sizeof(GuliCacheEntry*));
+    cache->by_object = GuliCalloc(cache->bucket_count, sizeof(GuliCacheEntry*));
+    if (!cache->by_key || !cache->by_object || !GuliMutexInit(&cache->lock))
+    {
+        GuliFree(cache->by_key);
+        GuliFree(cache->by_object);
+        GuliFree(cache);
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate resource cache");
+        return NULL;
+    }
+    cache->stats.budget = budget_bytes;
+    cache->owner = GuliThreadSelf();
+    return cache;
+}
+
+void GuliResourceCacheDestroy(GuliResourceCache* cache)
+{
+    if (!cache || !GuliRcOnOwner(cache, "GuliResourceCacheDestroy")) return;
+
+    GuliMutexLock(&cache->lock);
+    if (cache->stats.referenced)
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "Resource cache destroyed with %u referenced objects", cache->stats.referenced);
+    for (size_t i = 0; i < cache->bucket_count; i++)
+    {
+        for (GuliCacheEntry* e = cache->by_object[i]; e;)
+        {
+            GuliCacheEntry* next = e->next_object;
+            GuliRcUnloadObject(e->kind, e->object);
+            GuliFree(e);
+            e = next;
+        }
+    }
+    GuliMutexUnlock(&cache->lock);
+
+    GuliMutexDestroy(&cache->lock);
+    GuliFree(cache->by_key);
+    GuliFree(cache->by_object);
+    GuliFree(cache);
+}
+
+void GuliResourceCacheSetBudget(GuliResourceCache* cache, size_t budget_bytes)
+{
+    if (!cache || !GuliRcOnOwner(cache, "GuliResourceCacheSetBudget")) return;
+    GuliMutexLock(&cache->lock);
+    cache->stats.budget = budget_bytes;
+    if (budget_bytes) GuliRcEvict(cache, budget_bytes);
+    GuliMutexUnlock(&cache->lock);
+}
+
+/* Look the key up, loading on a miss. The caller's reference is counted on success. */
+static void* GuliRcAcquire(GuliResourceCache* cache, GuliResourceKind kind, const char* key,
+    const char* path_a, const char* path_b, unsigned int flags)
+{
+    const uint32_t hash = GuliHashFNV1a(key);
+
+    GuliMutexLock(&cache->lock);
+    /* Catch up on evictions deferred by releases from other threads */
+    if (cache->stats.budget) GuliRcEvict(cache, cache->stats.budget);
+    GuliCacheEntry* e = *GuliRcKeySlot(cache, hash, key);
+    if (e)
+    {
+        cache->stats.hits++;
+        if (e->refs++ == 0)
+        {
+            GuliRcLruRemove(cache, e);
+            cache->stats.referenced++;
+        }
+        void* object = e->object;
+        GuliMutexUnlock(&cache->lock);
+        return object;
+    }
+    cache->stats.misses++;
+    GuliMutexUnlock(&cache->lock);
+
+    /* Only the owner inserts, so the key cannot appear while this loads */
+    const size_t key_size = strlen(key) + 1;
+    e = GuliCalloc(1, sizeof(GuliCacheEntry) + key_size);
+    if (!e)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate resource cache entry");
+        return NULL;
+    }
+
+    void* object = NULL;
+    size_t bytes = 0;
+    if (kind == GULI_RC_TEXTURE)
+    {
+        GuliTexture* texture = GuliTextureLoadFromFileEx(path_a, flags);
+        if (texture) bytes = texture->_bytes;
+        object = texture;
+    }
+    else object = GuliShaderLoadFromFile(path_a, path_b);
+    if (!object)
+    {
+        GuliFree(e);
+        return NULL;
+    }
+
+    memcpy(e->key, key, key_size);
+    e->hash = hash;
+    e->kind = kind;
+    e->object = object;
+    e->bytes = bytes;
+    e->refs = 1;
+
+    GuliMutexLock(&cache->lock);
+    cache->stats.entries++;
+    GuliRcGrow(cache);
+    GuliCacheEntry** slot = &cache->by_key[hash & (cache->bucket_count - 1)];
+    e->next_key = *slot;
+    *slot = e;
+    slot = &cache->by_object[GuliRcHashPointer(object) & (cache->bucket_count - 1)];
+    e->next_object = *slot;
+    *slot = e;
+    cache->stats.bytes += bytes;
+    cache->stats.referenced++;
+    if (cache->stats.budget) GuliRcEvict(cache, cache->stats.budget);
+    GuliMutexUnlock(&cache->lock);
+    return object;
+}
+
+/* Canonical spelling of path, so "a.png", "./a.png" and an absolute path share an entry.
+   A path that does not resolve is kept as given; its load fails anyway. */
+static const char* GuliRcCanonicalPath(const char* path, char out[PATH_MAX])
+{
+    return realpath(path, out) ? out : path;
+}
+
+GuliTexture* GuliResourceAcquireTexture(GuliResourceCache* cache, const char* path, unsigned int flags)
+{
+    if (!cache || !path || !GuliRcOnOwner(cache, "GuliResourceAcquireTexture")) return NULL;
+    char resolved[PATH_MAX];
+    path = GuliRcCanonicalPath(path, resolved);
+    char key[GULI_RC_KEY_MAX];
+    if (snprintf(key, sizeof(key), "T%08x:%s", flags, path) >= (int)sizeof(key))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliResourceAcquireTexture: path too long");
+        return NULL;
+    }
+    return GuliRcAcquire(cache, GULI_RC_TEXTURE, key, path, NULL, flags);
+}
+
+GuliShader* GuliResourceAcquireShader(GuliResourceCache* cache, const char* vertPath, const char* fragPath)
+{
+    if (!cache || !vertPath || !fragPath || !GuliRcOnOwner(cache, "GuliResourceAcquireShader")) return NULL;
+    char resolved_vert[PATH_MAX];
+    char resolved_frag[PATH_MAX];
+    vertPath = GuliRcCanonicalPath(vertPath, resolved_vert);
+    fragPath = GuliRcCanonicalPath(fragPath, resolved_frag);
+    char key[GULI_RC_KEY_MAX];
+    if (snprintf(key, sizeof(key), "S%s\n%s", vertPath, fragPath) >= (int)sizeof(key))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliResourceAcquireShader: path too long");
+        return NULL;
+    }
+    return GuliRcAcquire(cache, GULI_RC_SHADER, key, vertPath, fragPath, 0);
+}
+
+void GuliResourceRetain(GuliResourceCache* cache, const void* object)
+{
+    if (!cache || !object) return;
+    GuliMutexLock(&cache->lock);
+    GuliCacheEntry* e = *GuliRcObjectSlot(cache, object);
+    if (e && e->refs++ == 0)
+    {
+        GuliRcLruRemove(cache, e);
+        cache->stats.referenced++;
+    }
+    GuliMutexUnlock(&cache->lock);
+}
+
+void GuliResourceRelease(GuliResourceCache* cache, const void* object)
+{
+    if (!cache || !object) return;
+    GuliMutexLock(&cache->lock);
+    GuliCacheEntry* e = *GuliRcObjectSlot(cache, object);
+    if (!e || e->refs <= 0)
+    {
+        GuliMutexUnlock(&cache->lock);
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "GuliResourceRelease: object not referenced by this cache");
+        return;
+    }
+    if (--e->refs == 0)
+    {
+        cache->stats.referenced--;
+        GuliRcLruPush(cache, e);
+        if (cache->stats.budget && GuliThreadEqual(GuliThreadSelf(), cache->owner))
+            GuliRcEvict(cache, cache->stats.budget);
+    }
+    GuliMutexUnlock(&cache->lock);
+}
+
+void GuliResourceCacheTrim(GuliResourceCache* cache, size_t target_bytes)
+{
+    if (!cache || !GuliRcOnOwner(cache, "GuliResourceCacheTrim")) return;
+    GuliMutexLock(&cache->lock);
+    GuliRcEvict(cache, target_bytes);
+    GuliMutexUnlock(&cache->lock);
+}
+
+void GuliResourceCacheGetStats(GuliResourceCache* cache, GuliResourceCacheStats* stats)
+{
+    if (!stats) return;
+    if (!cache)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    GuliMutexLock(&cache->lock);
+    *stats = cache->stats;
+    GuliMutexUnlock(&cache->lock);
+}
@@ -0,0 +1,906 @@
+#include "Graphics/guli_shader_preprocess.h"
+#include "Graphics/guli_graphics.h"
+#include "Core/guli_file.h"
+#include "Core/guli_hash.h"
+#include "Core/guli_thread.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define GULI_PP_PATH_MAX 4096
+#define GULI_PP_CACHE_BUCKETS 64
+
+/* -----------------------------------------------------------------------------
+ * Output buffer
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    int failed;
+} GuliPPText;
+
+static void GuliPPAppend(GuliPPText* t, const char* s, size_t n)
+{
+    if (t->failed) return;
+    if (t->len + n + 1 > t->cap)
+    {
+        size_t cap = t->cap ? t->cap : 1024;
+        while (t->len + n + 1 > cap) cap *= 2;
+        char* data = GuliRealloc(t->data, cap);
+        if (!data)
+        {
+            t->failed = 1;
+            return;
+        }
+        t->data = data;
+        t->cap = cap;
+    }
+    memcpy(t->data + t->len, s, n);
+    t->len += n;
+    t->data[t->len] = '\0';
+}
+
+static void GuliPPAppendStr(GuliPPText* t, const char* s)
+{
+    GuliPPAppend(t, s, strlen(s));
+}
+
+static void GuliPPAppendInt(GuliPPText* t, long v)
+{
+    char num[24];
+    const int n = snprintf(num, sizeof(num), "%ld", v);
+    GuliPPAppend(t, num, (size_t)n);
+}
+
+static char* GuliPPStrdup(const char* s)
+{
+    if (!s) return NULL;
+    char* copy = GuliMalloc(strlen(s) + 1);
+    if (copy) strcpy(copy, s);
+    return copy;
+}
+
+/* -----------------------------------------------------------------------------
+ * Dependencies: every file read, in include order (index = #line source number)
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    char* path;
+    int64_t mtime_ns;
+    int64_t size;
+    int once;                 /* saw #pragma once */
+} GuliPPFile;
+
+typedef struct {
+    GuliPPFile* files;
+    int count;
+    int capacity;
+    int glsl;                 /* emit #line markers */
+    char* version;            /* #version argument found in the root */
+    GuliPPText body;
+} GuliPPContext;
+
+static int GuliPPStat(const char* path, int64_t* mtime_ns, int64_t* size)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) return 0;
+#if defined(__APPLE__)
+    *mtime_ns = (int64_t)st.st_mtimespec.tv_sec * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    *mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    *size = (int64_t)st.st_size;
+    return 1;
+}
+
+static int GuliPPFindFile(const GuliPPContext* ctx, const char* path)
+{
+    for (int i = 0; i < ctx->count; i++)
+        if (strcmp(ctx->files[i].path, path) == 0) return i;
+    return -1;
+}
+
+static int GuliPPAddFile(GuliPPContext* ctx, const char* path)
+{
+    if (ctx->count == ctx->capacity)
+    {
+        const int capacity = ctx->capacity ? ctx->capacity * 2 : 8;
+        GuliPPFile* files = GuliRealloc(ctx->files, (size_t)capacity * sizeof(GuliPPFile));
+        if (!files) return -1;
+        ctx->files = files;
+        ctx->capacity = capacity;
+    }
+    GuliPPFile* f = &ctx->files[ctx->count];
+    memset(f, 0, sizeof(*f));
+    f->path = GuliMalloc(strlen(path) + 1);
+    if (!f->path) return -1;
+    strcpy(f->path, path);
+    GuliPPStat(path, &f->mtime_ns, &f->size);
+    return ctx->count++;
+}
+
+static void GuliPPContextFree(GuliPPContext* ctx)
+{
+    for (int i = 0; i < ctx->count; i++)
+        GuliFree(ctx->files[i].path);
+    GuliFree(ctx->files);
+    GuliFree(ctx->version);
+    GuliFree(ctx->body.data);
+}
+
+/* -----------------------------------------------------------------------------
+ * Line processing
+ * ----------------------------------------------------------------------------- */
+
+static const char* GuliPPSkipSpace(const char* s, const char* end)
+{
+    while (s < end && (*s == ' ' || *s == '\t')) s++;
+    return s;
+}
+
+/* Matches "#<directive>" (spaces allowed after '#'); returns the text after it or NULL. */
+static const char* GuliPPDirective(const char* line, const char* end, const char* directive)
+{
+    const char* s = GuliPPSkipSpace(line, end);
+    if (s == end || *s != '#') return NULL;
+    s = GuliPPSkipSpace(s + 1, end);
+    const size_t n = strlen(directive);
+    if ((size_t)(end - s) < n || memcmp(s, directive, n) != 0) return NULL;
+    s += n;
+    if (s < end && *s != ' ' && *s != '\t' && *s != '"' && *s != '<') return NULL;
+    return GuliPPSkipSpace(s, end);
+}
+
+/* dir of path, with trailing '/', into out ("" for a bare file name) */
+static void GuliPPDirName(const char* path, char* out, size_t size)
+{
+    const char* slash = strrchr(path, '/');
+    size_t n = slash ? (size_t)(slash - path + 1) : 0;
+    if (n >= size) n = size - 1;
+    memcpy(out, path, n);
+    out[n] = '\0';
+}
+
+static int GuliPPJoin(char* out, size_t size, const char* dir, const char* name, size_t name_len)
+{
+    if (name[0] == '/') dir = "";
+    const size_t dir_len = strlen(dir);
+    if (dir_len + name_len + 1 > size) return 0;
+    memcpy(out, dir, dir_len);
+    memcpy(out + dir_len, name, name_len);
+    out[dir_len + name_len] = '\0';
+    return 1;
+}
+
+static int GuliPPProcess(GuliPPContext* ctx, const char* source, const char* dir, int file_index, int depth);
+
+/* Expand one #include. Returns 1 if handled (spliced or skipped), 0 to pass the line through, -1 on error. */
+static int GuliPPInclude(GuliPPContext* ctx, const char* args, const char* end, const char* dir, int depth)
+{
+    const char open = *args;
+    const char close = open == '"' ? '"' : open == '<' ? '>' : 0;
+    const char* name = args + 1;
+    const char* name_end = close ? memchr(name, close, (size_t)(end - name)) : NULL;
+    if (!name_end || name_end == name)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Malformed #include in shader source");
+        return -1;
+    }
+
+    char path[GULI_PP_PATH_MAX];
+    if (!GuliPPJoin(path, sizeof(path), dir, name, (size_t)(name_end - name)))
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Shader #include path too long");
+        return -1;
+    }
+
+    const int existing = GuliPPFindFile(ctx, path);
+    if (existing >= 0 && ctx->files[existing].once) return 1;
+
+    char* text = GuliLoadFileText(path);
+    if (!text)
+    {
+        if (open == '<') return 0;  /* system header for the compiler */
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "Shader #include not found: %s", path);
+        return -1;
+    }
+    if (depth + 1 >= GULI_SHADER_INCLUDE_DEPTH_MAX)
+    {
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "Shader #include nested too deeply (cycle?): %s", path);
+        GuliFree(text);
+        return -1;
+    }
+
+    const int index = existing >= 0 ? existing : GuliPPAddFile(ctx, path);
+    int result = -1;
+    if (index >= 0)
+    {
+        char child_dir[GULI_PP_PATH_MAX];
+        GuliPPDirName(path, child_dir, sizeof(child_dir));
+        result = GuliPPProcess(ctx, text, child_dir, index, depth + 1) ? 1 : -1;
+    }
+    GuliFree(text);
+    return result;
+}
+
+static void GuliPPLineMarker(GuliPPContext* ctx, long line, int file_index)
+{
+    if (!ctx->glsl) return;
+    GuliPPAppendStr(&ctx->body, "#line ");
+    GuliPPAppendInt(&ctx->body, line);
+    GuliPPAppendStr(&ctx->body, " ");
+    GuliPPAppendInt(&ctx->body, file_index);
+    GuliPPAppendStr(&ctx->body, "\n");
+}
+
+static int GuliPPProcess(GuliPPContext* ctx, const char* source, const char* dir, int file_index, int depth)
+{
+    /* The root's marker is written by GuliPPAssemble, once it is known whether the source is GLSL */
+    if (depth > 0) GuliPPLineMarker(ctx, 1, file_index);
+
+    long line_no = 1;
+    for (const char* line = source; *line; line_no++)
+    {
+        const char* eol = strchr(line, '\n');
+        const char* end = eol ? eol : line + strlen(line);
+        const char* next = eol ? eol + 1 : end;
+        const char* args;
+
+        if ((args = GuliPPDirective(line, end, "version")))
+        {
+            /* The root's #version moves to the top (a blank keeps line numbers); includes lose theirs */
+            if (depth == 0 && !ctx->version)
+            {
+                const char* v_end = end;
+                while (v_end > args && (v_end[-1] == '\r' || v_end[-1] == ' ' || v_end[-1] == '\t')) v_end--;
+                ctx->version = GuliMalloc((size_t)(v_end - args) + 1);
+                if (!ctx->version) return 0;
+                memcpy(ctx->version, args, (size_t)(v_end - args));
+                ctx->version[v_end - args] = '\0';
+                ctx->glsl = 1;
+            }
+            GuliPPAppendStr(&ctx->body, "\n");
+        }
+        else if ((args = GuliPPDirective(line, end, "pragma")) && (size_t)(end - args) >= 4 && memcmp(args, "once", 4) == 0)
+        {
+            ctx->files[file_index].once = 1;
+            GuliPPAppendStr(&ctx->body, "\n");
+        }
+        else if ((args = GuliPPDirective(line, end, "include")))
+        {
+            const int handled = GuliPPInclude(ctx, args, end, dir, depth);
+            if (handled < 0) return 0;
+            if (handled)
+                GuliPPLineMarker(ctx, line_no + 1, file_index);
+            else
+                GuliPPAppend(&ctx->body, line, (size_t)(next - line));
+            if (!handled && !eol) GuliPPAppendStr(&ctx->body, "\n");
+        }
+        else
+        {
+            GuliPPAppend(&ctx->body, line, (size_t)(next - line));
+            if (!eol) GuliPPAppendStr(&ctx->body, "\n");
+        }
+        line = next;
+    }
+    return !ctx->body.failed;
+}
+
+static int GuliPPCompareDefines(const void* a, const void* b)
+{
+    const GuliShaderDefine* da = *(const GuliShaderDefine* const*)a;
+    const GuliShaderDefine* db = *(const GuliShaderDefine* const*)b;
+    return strcmp(da->name, db->name);
+}
+
+/* Canonical "NAME=VALUE\n" list: same set, same text, whatever the order given. Unnamed entries are skipped. */
+static char* GuliPPDefineKey(const GuliShaderDefine* defines, int count)
+{
+    const GuliShaderDefine** sorted = GuliMalloc((size_t)(count > 0 ? count : 1) * sizeof(*sorted));
+    if (!sorted) return NULL;
+    int n = 0;
+    for (int i = 0; i < count; i++)
+        if (defines[i].name && defines[i].name[0]) sorted[n++] = &defines[i];
+    qsort(sorted, (size_t)n, sizeof(*sorted), GuliPPCompareDefines);
+
+    GuliPPText key = {0};
+    GuliPPAppendStr(&key, "");
+    for (int i = 0; i < n; i++)
+    {
+        GuliPPAppendStr(&key, sorted[i]->name);
+        GuliPPAppendStr(&key, "=");
+        GuliPPAppendStr(&key, sorted[i]->value ? sorted[i]->value : "1");
+        GuliPPAppendStr(&key, "\n");
+    }
+    GuliFree(sorted);
+    if (key.failed)
+    {
+        GuliFree(key.data);
+        return NULL;
+    }
+    return key.data;
+}
+
+static int GuliPPIsIdentChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/* Whether name appears in text as a whole identifier */
+static int GuliPPMentions(const char* text, const char* name, size_t name_len)
+{
+    for (const char* p = text; (p = strstr(p, name)); p += name_len)
+        if ((p == text || !GuliPPIsIdentChar(p[-1])) && !GuliPPIsIdentChar(p[name_len])) return 1;
+    return 0;
+}
+
+/* #version, then the defines, then the body. Defines the source never mentions are left out,
+   so define sets that differ only in those produce identical text. */
+static char* GuliPPAssemble(GuliPPContext* ctx, const char* version, const char* define_key)
+{
+    GuliPPText out = {0};
+    const char* v = version ? version : ctx->version;
+    if (v)
+    {
+        GuliPPAppendStr(&out, "#version ");
+        GuliPPAppendStr(&out, v);
+        GuliPPAppendStr(&out, "\n");
+    }
+    for (const char* d = define_key; d && *d;)
+    {
+        const char* eq = strchr(d, '=');
+        const char* nl = strchr(eq, '\n');
+        char name[128];
+        const size_t name_len = (size_t)(eq - d);
+        if (name_len < sizeof(name))
+        {
+            memcpy(name, d, name_len);
+            name[name_len] = '\0';
+            if (!ctx->body.data || !GuliPPMentions(ctx->body.data, name, name_len))
+            {
+                d = nl + 1;
+                continue;
+            }
+        }
+        GuliPPAppendStr(&out, "#define ");
+        GuliPPAppend(&out, d, (size_t)(eq - d));
+        GuliPPAppendStr(&out, " ");
+        GuliPPAppend(&out, eq + 1, (size_t)(nl - eq));
+        d = nl + 1;
+    }
+    if (ctx->glsl) GuliPPAppendStr(&out, "#line 1 0\n");
+    GuliPPAppend(&out, ctx->body.data ? ctx->body.data : "", ctx->body.len);
+    if (out.failed)
+    {
+        GuliFree(out.data);
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate preprocessed shader source");
+        return NULL;
+    }
+    return out.data;
+}
+
+static char* GuliPPRun(GuliPPContext* ctx, const char* source, const char* root_path, const char* dir,
+    const char* version, const char* define_key)
+{
+    ctx->glsl = version != NULL;
+    if (GuliPPAddFile(ctx, root_path) < 0 || !GuliPPProcess(ctx, source, dir, 0, 0))
+    {
+        if (ctx->body.failed) GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to allocate preprocessed shader source");
+        return NULL;
+    }
+    return GuliPPAssemble(ctx, version, define_key);
+}
+
+/* -----------------------------------------------------------------------------
+ * Processed-file cache. The lock is a spin lock held only for table access and
+ * reference counts: readers pin an entry, then stat its files and copy its text
+ * unlocked. Preprocessing runs unlocked and a racing duplicate insert replaces
+ * the entry; an unlinked entry is freed by whoever drops its last reference.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct GuliPPCacheEntry {
+    struct GuliPPCacheEntry* next;
+    uint64_t hash;
+    char* key;                /* version, path and define key */
+    char* text;
+    size_t text_len;
+    GuliPPFile* files;        /* root first; revalidated on lookup */
+    int file_count;
+    int refs;                 /* readers holding it outside the lock; guarded by the lock */
+    int unlinked;             /* out of the table: freed at refs == 0 */
+} GuliPPCacheEntry;
+
+static struct {
+    atomic_flag lock;
+    GuliPPCacheEntry* buckets[GULI_PP_CACHE_BUCKETS];
+} g_pp_cache = { ATOMIC_FLAG_INIT, {0} };
+
+static void GuliPPCacheLock(void)
+{
+    while (atomic_flag_test_and_set_explicit(&g_pp_cache.lock, memory_order_acquire))
+        GuliThreadPause();
+}
+
+static void GuliPPCacheUnlock(void)
+{
+    atomic_flag_clear_explicit(&g_pp_cache.lock, memory_order_release);
+}
+
+static void GuliPPCacheEntryFree(GuliPPCacheEntry* e)
+{
+    for (int i = 0; i < e->file_count; i++)
+        GuliFree(e->files[i].path);
+    GuliFree(e->files);
+    GuliFree(e->text);
+    GuliFree(e->key);
+    GuliFree(e);
+}
+
+static int GuliPPCacheEntryFresh(const GuliPPCacheEntry* e)
+{
+    for (int i = 0; i < e->file_count; i++)
+    {
+        int64_t mtime_ns, size;
+        if (!GuliPPStat(e->files[i].path, &mtime_ns, &size)) return 0;
+        if (mtime_ns != e->files[i].mtime_ns || size != e->files[i].size) return 0;
+    }
+    return 1;
+}
+
+/* Pinned entry for key, or NULL. Release with GuliPPCacheRelease. */
+static GuliPPCacheEntry* GuliPPCacheAcquire(uint64_t hash, const char* key)
+{
+    GuliPPCacheLock();
+    GuliPPCacheEntry* e = g_pp_cache.buckets[hash % GULI_PP_CACHE_BUCKETS];
+    while (e && (e->hash != hash || strcmp(e->key, key) != 0))
+        e = e->next;
+    if (e) e->refs++;
+    GuliPPCacheUnlock();
+    return e;
+}
+
+/* Mark e unlinked (lock held). Returns 1 if the caller must free it once unlocked. */
+static int GuliPPCacheUnlinkLocked(GuliPPCacheEntry* e)
+{
+    e->unlinked = 1;
+    return e->refs == 0;
+}
+
+/* Drop a pin; stale also unlinks e if it is still in the table. */
+static void GuliPPCacheRelease(GuliPPCacheEntry* e, int stale)
+{
+    GuliPPCacheLock();
+    if (stale && !e->unlinked)
+    {
+        GuliPPCacheEntry** slot = &g_pp_cache.buckets[e->hash % GULI_PP_CACHE_BUCKETS];
+        while (*slot && *slot != e)
+            slot = &(*slot)->next;
+        if (*slot) *slot = e->next;
+        e->unlinked = 1;
+    }
+    const int free_entry = --e->refs == 0 && e->unlinked;
+    GuliPPCacheUnlock();
+    if (free_entry) GuliPPCacheEntryFree(e);
+}
+
+/* Copy of the cached text for key, or NULL (missing or stale: a stale entry is dropped) */
+static char* GuliPPCacheGet(uint64_t hash, const char* key)
+{
+    GuliPPCacheEntry* e = GuliPPCacheAcquire(hash, key);
+    if (!e) return NULL;
+    char* copy = NULL;
+    const int fresh = GuliPPCacheEntryFresh(e);
+    if (fresh)
+    {
+        copy = GuliMalloc(e->text_len + 1);
+        if (copy) memcpy(copy, e->text, e->text_len + 1);
+    }
+    GuliPPCacheRelease(e, !fresh);
+    return copy;
+}
+
+/* Takes ownership of key; copies text and ctx's file list. */
+static void GuliPPCachePut(uint64_t hash, char* key, const char* text, GuliPPContext* ctx)
+{
+    GuliPPCacheEntry* e = GuliCalloc(1, sizeof(GuliPPCacheEntry));
+    if (!e)
+    {
+        GuliFree(key);
+        return;
+    }
+    e->hash = hash;
+    e->key = key;
+    e->text_len = strlen(text);
+    e->text = GuliMalloc(e->text_len + 1);
+    /* Ownership of the path strings moves to the entry */
+    e->files = ctx->files;
+    e->file_count = ctx->count;
+    ctx->files = NULL;
+    ctx->count = ctx->capacity = 0;
+    if (!e->text)
+    {
+        GuliPPCacheEntryFree(e);
+        return;
+    }
+    memcpy(e->text, text, e->text_len + 1);
+
+    GuliPPCacheLock();
+    GuliPPCacheEntry** slot = &g_pp_cache.buckets[hash % GULI_PP_CACHE_BUCKETS];
+    while (*slot && ((*slot)->hash != hash || strcmp((*slot)->key, key) != 0))
+        slot = &(*slot)->next;
+    GuliPPCacheEntry* old = *slot;
+    e->next = old ? old->next : NULL;
+    *slot = e;
+    const int free_old = old && GuliPPCacheUnlinkLocked(old);
+    GuliPPCacheUnlock();
+    if (free_old) GuliPPCacheEntryFree(old);
+}
+
+void GuliShaderPreprocessClearCache(void)
+{
+    GuliPPCacheLock();
+    GuliPPCacheEntry* all = NULL;
+    for (int i = 0; i < GULI_PP_CACHE_BUCKETS; i++)
+    {
+        for (GuliPPCacheEntry* e = g_pp_cache.buckets[i]; e;)
+        {
+            GuliPPCacheEntry* next = e->next;
+            if (GuliPPCacheUnlinkLocked(e))
+            {
+                e->next = all;
+                all = e;
+            }
+            e = next;
+        }
+        g_pp_cache.buckets[i] = NULL;
+    }
+    GuliPPCacheUnlock();
+    while (all)
+    {
+        GuliPPCacheEntry* next = all->next;
+        GuliPPCacheEntryFree(all);
+        all = next;
+    }
+}
+
+/* -----------------------------------------------------------------------------
+ * Public entry points
+ * ----------------------------------------------------------------------------- */
+
+/* Cache key for (path, version, define key); data NULL on allocation failure */
+static GuliPPText GuliPPCacheKey(const char* path, const char* version, const char* define_key)
+{
+    GuliPPText key = {0};
+    GuliPPAppendStr(&key, version ? version : "");
+    GuliPPAppend(&key, "\n", 1);
+    GuliPPAppendStr(&key, path);
+    GuliPPAppend(&key, "\n", 1);
+    GuliPPAppendStr(&key, define_key);
+    if (key.failed)
+    {
+        GuliFree(key.data);
+        key.data = NULL;
+    }
+    return key;
+}
+
+char* GuliShaderPreprocess(const char* path, const char* version, const GuliShaderDefine* defines, int define_count)
+{
+    if (!path || define_count < 0 || (define_count && !defines)) return NULL;
+
+    char* define_key = GuliPPDefineKey(defines, define_count);
+    if (!define_key) return NULL;
+
+    GuliPPText key = GuliPPCacheKey(path, version, define_key);
+    if (!key.data)
+    {
+        GuliFree(define_key);
+        return NULL;
+    }
+    const uint64_t hash = GuliHashFNV1a64(key.data, key.len);
+
+    char* text = GuliPPCacheGet(hash, key.data);
+    if (text)
+    {
+        GuliFree(key.data);
+        GuliFree(define_key);
+        return text;
+    }
+
+    char* source = GuliLoadFileText(path);
+    if (!source)
+    {
+        GuliLog(GULI_LOG_ERROR, GULI_ERROR_FAILED, "Failed to load shader file: %s", path);
+        GuliFree(key.data);
+        GuliFree(define_key);
+        return NULL;
+    }
+
+    char dir[GULI_PP_PATH_MAX];
+    GuliPPDirName(path, dir, sizeof(dir));
+    GuliPPContext ctx = {0};
+    text = GuliPPRun(&ctx, source, path, dir, version, define_key);
+    if (text)
+    {
+        GuliPPCachePut(hash, key.data, text, &ctx);
+        key.data = NULL;
+    }
+    GuliPPContextFree(&ctx);
+    GuliFree(key.data);
+    GuliFree(define_key);
+    GuliFree(source);
+    return text;
+}
+
+char* GuliShaderPreprocessSource(const char* source, const char* include_dir, const char* version,
+    const GuliShaderDefine* defines, int define_count)
+{
+    if (!source || define_count < 0 || (define_count && !defines)) return NULL;
+
+    char dir[GULI_PP_PATH_MAX] = "";
+    if (include_dir && include_dir[0])
+    {
+        size_t n = strlen(include_dir);
+        if (n + 2 > sizeof(dir)) return NULL;
+        memcpy(dir, include_dir, n);
+        if (include_dir[n - 1] != '/') dir[n++] = '/';
+        dir[n] = '\0';
+    }
+
+    char* define_key = GuliPPDefineKey(defines, define_count);
+    if (!define_key) return NULL;
+    GuliPPContext ctx = {0};
+    char* text = GuliPPRun(&ctx, source, "<memory>", dir, version, define_key);
+    GuliPPContextFree(&ctx);
+    GuliFree(define_key);
+    return text;
+}
+
+int GuliShaderPreprocessForEachDependency(const char* path, const char* version,
+    void (*fn)(void* user, const char* file), void* user)
+{
+    if (!path || !fn) return 0;
+    GuliPPText key = GuliPPCacheKey(path, version, "");
+    if (!key.data) return 0;
+    const uint64_t hash = GuliHashFNV1a64(key.data, key.len);
+
+    /* Copy the list out so fn runs unlocked */
+    char** files = NULL;
+    int count = 0;
+    GuliPPCacheEntry* e = GuliPPCacheAcquire(hash, key.data);
+    GuliFree(key.data);
+    if (e)
+    {
+        if ((files = GuliMalloc((size_t)e->file_count * sizeof(char*))))
+        {
+            for (; count < e->file_count; count++)
+                if (!(files[count] = GuliPPStrdup(e->files[count].path))) break;
+        }
+        GuliPPCacheRelease(e, 0);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        fn(user, files[i]);
+        GuliFree(files[i]);
+    }
+    GuliFree(files);
+    return count;
+}
+
+char* GuliShaderPreprocessSpecConstants(const char* source, const GuliShaderSpecConstant* constants, int count)
+{
+    if (!source || count < 0 || (count && !constants)) return NULL;
+
+    char (*text)[2][24] = GuliMalloc((size_t)(count > 0 ? count : 1) * sizeof(*text));
+    GuliShaderDefine* defines = GuliMalloc((size_t)(count > 0 ? count : 1) * sizeof(GuliShaderDefine));
+    char* result = NULL;
+    if (text && defines)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            snprintf(text[i][0], sizeof(text[i][0]), "GULI_SPEC_CONSTANT_%u", (unsigned)constants[i].id);
+            snprintf(text[i][1], sizeof(text[i][1]), "%uu", (unsigned)constants[i].value);
+            defines[i] = (GuliShaderDefine){ text[i][0], text[i][1] };
+        }
+        result = GuliShaderPreprocessSource(source, NULL, NULL, defines, count);
+    }
+    GuliFree(defines);
+    GuliFree(text);
+    return result;
+}
+
+/* -----------------------------------------------------------------------------
+ * Variant sets. Both tables are small (one entry per define set / distinct
+ * source) and only searched when a variant is first requested or looked up by
+ * the caller, so they are flat arrays.
+ * ----------------------------------------------------------------------------- */
+
+typedef struct {
+    char* define_key;
+    uint64_t hash;
+    GuliShader* shader;       /* NULL: failed */
+} GuliShaderVariant;
+
+typedef struct {
+    uint64_t source_hash;     /* over both processed stages */
+    char* vs;                 /* processed sources, compared on a hash match */
+    char* fs;                 /* NULL: default fragment stage */
+    size_t vs_len;
+    size_t fs_len;
+    GuliShader* shader;
+} GuliShaderProgram;
+
+struct GuliShaderVariants {
+    GuliMutex lock;           /* guards the tables against GuliShaderVariantsGetStats */
+    GuliThread owner;         /* builds compile here: the only thread with the graphics context */
+    char* vert_path;
+    char* frag_path;
+    char* version;
+    GuliShaderVariant* variants;
+    uint32_t variant_count;
+    uint32_t variant_capacity;
+    GuliShaderProgram* programs;
+    uint32_t program_count;
+    uint32_t program_capacity;
+    uint32_t failures;
+};
+
+GuliShaderVariants* GuliShaderVariantsCreate(const char* vertPath, const char* fragPath, const char* version)
+{
+    if (!vertPath) return NULL;
+    GuliShaderVariants* v = GuliCalloc(1, sizeof(GuliShaderVariants));
+    if (!v) return NULL;
+    v->vert_path = GuliPPStrdup(vertPath);
+    v->frag_path = GuliPPStrdup(fragPath);
+    v->version = GuliPPStrdup(version);
+    if (!v->vert_path || (fragPath && !v->frag_path) || (version && !v->version) || !GuliMutexInit(&v->lock))
+    {
+        GuliFree(v->vert_path);
+        GuliFree(v->frag_path);
+        GuliFree(v->version);
+        GuliFree(v);
+        GULI_PRINT_ERROR(GULI_ERROR_ALLOCATION_FAILED, "Failed to create shader variant set");
+        return NULL;
+    }
+    v->owner = GuliThreadSelf();
+    return v;
+}
+
+/* Builds and unloads need the owner's graphics context */
+static int GuliShaderVariantsOnOwner(const GuliShaderVariants* v, const char* func)
+{
+    if (GuliThreadEqual(GuliThreadSelf(), v->owner)) return 1;
+    GuliLog(GULI_LOG_ERROR, GULI_ERROR_ASSERTION_FAILED, "%s: called off the thread that created the variant set", func);
+    return 0;
+}
+
+void GuliShaderVariantsDestroy(GuliShaderVariants* v)
+{
+    if (!v || !GuliShaderVariantsOnOwner(v, "GuliShaderVariantsDestroy")) return;
+    for (uint32_t i = 0; i < v->program_count; i++)
+    {
+        GuliShaderUnload(v->programs[i].shader);
+        GuliFree(v->programs[i].vs);
+        GuliFree(v->programs[i].fs);
+    }
+    for (uint32_t i = 0; i < v->variant_count; i++)
+        GuliFree(v->variants[i].define_key);
+    GuliFree(v->programs);
+    GuliFree(v->variants);
+    GuliFree(v->vert_path);
+    GuliFree(v->frag_path);
+    GuliFree(v->version);
+    GuliMutexDestroy(&v->lock);
+    GuliFree(v);
+}
+
+/* Shader for the processed sources: an existing one if identical, else compiled. NULL on failure.
+   Takes ownership of vs and fs (kept with a new program, freed otherwise). */
+static GuliShader* GuliShaderVariantsBuild(GuliShaderVariants* v, char* vs, char* fs)
+{
+    const size_t vs_len = strlen(vs);
+    const size_t fs_len = fs ? strlen(fs) : 0;
+    const uint64_t h = GuliHashFNV1a64(vs, vs_len) ^ (GuliHashFNV1a64(fs ? fs : "", fs_len) * 31);
+    GuliShader* shader = NULL;
+    for (uint32_t i = 0; i < v->program_count && !shader; i++)
+    {
+        const GuliShaderProgram* p = &v->programs[i];
+        if (p->source_hash == h && p->vs_len == vs_len && p->fs_len == fs_len && !p->fs == !fs &&
+            memcmp(p->vs, vs, vs_len) == 0 && (!fs || memcmp(p->fs, fs, fs_len) == 0))
+            shader = p->shader;
+    }
+
+    if (!shader && v->program_count == v->program_capacity)
+    {
+        const uint32_t capacity = v->program_capacity ? v->program_capacity * 2 : 8;
+        GuliShaderProgram* programs = GuliRealloc(v->programs, capacity * sizeof(GuliShaderProgram));
+        if (!programs)
+        {
+            GuliFree(vs);
+            GuliFree(fs);
+            return NULL;
+        }
+        v->programs = programs;
+        v->program_capacity = capacity;
+    }
+    if (!shader && (shader = GuliShaderLoadFromMemory(vs, fs)) != NULL)
+    {
+        v->programs[v->program_count++] = (GuliShaderProgram){ h, vs, fs, vs_len, fs_len, shader };
+        return shader;
+    }
+
+    GuliFree(vs);
+    GuliFree(fs);
+    return shader;
+}
+
+GuliShader* GuliShaderVariantsGet(GuliShaderVariants* v, const GuliShaderDefine* defines, int define_count)
+{
+    if (!v || define_count < 0 || (define_count && !defines)) return NULL;
+    if (!GuliShaderVariantsOnOwner(v, "GuliShaderVariantsGet")) return NULL;
+
+    char* define_key = GuliPPDefineKey(defines, define_count);
+    if (!define_key) return NULL;
+    const uint64_t hash = GuliHashFNV1a64(define_key, strlen(define_key));
+
+    GuliMutexLock(&v->lock);
+    for (uint32_t i = 0; i < v->variant_count; i++)
+    {
+        const GuliShaderVariant* var = &v->variants[i];
+        if (var->hash == hash && strcmp(var->define_key, define_key) == 0)
+        {
+            GuliShader* shader = var->shader;
+            GuliMutexUnlock(&v->lock);
+            GuliFree(define_key);
+            return shader;
+        }
+    }
+
+    if (v->variant_count == v->variant_capacity)
+    {
+        const uint32_t capacity = v->variant_capacity ? v->variant_capacity * 2 : 8;
+        GuliShaderVariant* variants = GuliRealloc(v->variants, capacity * sizeof(GuliShaderVariant));
+        if (!variants)
+        {
+            GuliMutexUnlock(&v->lock);
+            GuliFree(define_key);
+            return NULL;
+        }
+        v->variants = variants;
+        v->variant_capacity = capacity;
+    }
+
+    char* vs = GuliShaderPreprocess(v->vert_path, v->version, defines, define_count);
+    char* fs = v->frag_path ? GuliShaderPreprocess(v->frag_path, v->version, defines, define_count) : NULL;
+    GuliShader* shader = NULL;
+    if (vs && (fs || !v->frag_path)) shader = GuliShaderVariantsBuild(v, vs, fs);
+    else
+    {
+        GuliFree(vs);
+        GuliFree(fs);
+    }
+
+    /* Failures are remembered too, so a broken variant is not recompiled on every request */
+    if (!shader) v->failures++;
+    v->variants[v->variant_count++] = (GuliShaderVariant){ define_key, hash, shader };
+    GuliMutexUnlock(&v->lock);
+    return shader;
+}
+
+void GuliShaderVariantsGetStats(GuliShaderVariants* v, GuliShaderVariantStats* stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!v) return;
+    GuliMutexLock(&v->lock);
+    stats->variants = v->variant_count;
+    stats->shaders = v->program_count;
+    stats->failures = v->failures;
+    GuliMutexUnlock(&v->lock);
+}
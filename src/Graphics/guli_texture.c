@@ -3,17 +3,30 @@
 #include "Core/guli_core.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #ifdef GULI_BACKEND_METAL
 extern GuliTexture* MetalTextureCreateFromPixels(int width, int height, const unsigned char* pixels);
+extern GuliTexture* MetalTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels);
 extern void MetalTextureUnload(GuliTexture* texture);
 #endif
 
 #ifdef GULI_BACKEND_OPENGL
 extern GuliTexture* GlTextureCreateFromPixels(int width, int height, const unsigned char* pixels);
+extern GuliTexture* GlTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels);
 extern void GlTextureUnload(GuliTexture* texture);
 #endif
 
+GuliPool G_TexturePool = GULI_POOL_INIT(sizeof(GuliTexture), GULI_RESOURCE_NAME_MAX);
+
+GuliTexture* GuliTextureAlloc(void)
+{
+    GuliHandle handle;
+    GuliTexture* texture = GuliPoolAlloc(&G_TexturePool, &handle);
+    if (texture) texture->_handle = handle;
+    return texture;
+}
+
 GuliTexture* GuliTextureCreateFromPixels(int width, int height, const unsigned char* pixels)
 {
     if (width <= 0 || height <= 0) return NULL;
@@ -30,11 +43,31 @@ GuliTexture* GuliTextureCreateFromPixels(int width, int height, const unsigned c
     return NULL;
 }
 
+GuliTexture* GuliTextureCreateFromLevels(int width, int height, int levels, const unsigned char* const* pixels)
+{
+    if (width <= 0 || height <= 0 || levels <= 0 || !pixels) return NULL;
+
+#ifdef GULI_BACKEND_METAL
+    return MetalTextureCreateFromLevels(width, height, levels, pixels);
+#endif
+
+#ifdef GULI_BACKEND_OPENGL
+    return GlTextureCreateFromLevels(width, height, levels, pixels);
+#endif
+
+    return NULL;
+}
+
 GuliTexture* GuliTextureLoadFromFile(const char* path)
+{
+    return GuliTextureLoadFromFileEx(path, 0);
+}
+
+GuliTexture* GuliTextureLoadFromFileEx(const char* path, unsigned int flags)
 {
     if (!path) return NULL;
 
-    GuliImage img = GuliImageLoadFromFile(path);
+    GuliImage img = GuliImageLoadFromFileEx(path, flags);
     if (!img.data || img.width <= 0 || img.height <= 0)
     {
         GuliImageFree(&img);
@@ -46,19 +79,39 @@ GuliTexture* GuliTextureLoadFromFile(const char* path)
     return tex;
 }
 
+GuliTexture* GuliTextureLoadFromMemory(const void* data, size_t size, unsigned int flags)
+{
+    GuliImage img = GuliImageLoadFromMemoryEx(data, size, flags);
+    if (!img.data) return NULL;
+
+    GuliTexture* tex = GuliTextureCreateFromPixels(img.width, img.height, img.data);
+    GuliImageFree(&img);
+    return tex;
+}
+
+GuliTexture* GuliTextureLoadFromArchive(GuliArchive* archive, const char* name, unsigned int flags)
+{
+    GuliAssetView view;
+    if (!GuliArchiveFind(archive, name, &view)) return NULL;
+    return GuliTextureLoadFromMemory(view.data, view.size, flags);
+}
+
 void GuliTextureUnload(GuliTexture* texture)
 {
     if (!texture) return;
 
+    /* Handles go stale now; the slot stays reserved until the backend retires the texture */
+    const GuliHandle handle = texture->_handle;
+    GuliPoolRelease(&G_TexturePool, handle);
+
 #ifdef GULI_BACKEND_METAL
     MetalTextureUnload(texture);
+    GuliPoolRecycle(&G_TexturePool, handle);  /* in-flight command buffers retain the MTLTexture */
 #endif
 
 #ifdef GULI_BACKEND_OPENGL
-    GlTextureUnload(texture);
+    GlTextureUnload(texture);  /* recycles the slot once its frames have retired */
 #endif
-
-    free(texture);
 }
 
 void GuliTextureGetSize(const GuliTexture* texture, int* width, int* height)
@@ -71,3 +124,27 @@ int GuliTextureIsValid(const GuliTexture* texture)
 {
     return (texture && texture->_backend) ? 1 : 0;
 }
+
+GuliTextureHandle GuliTextureGetHandle(const GuliTexture* texture)
+{
+    return texture ? texture->_handle : GULI_HANDLE_NULL;
+}
+
+GuliTexture* GuliTextureFromHandle(GuliTextureHandle handle)
+{
+    return GuliPoolGet(&G_TexturePool, handle);
+}
+
+void GuliTextureSetName(GuliTexture* texture, const char* name)
+{
+    char* cold = texture ? GuliPoolGetCold(&G_TexturePool, texture->_handle) : NULL;
+    if (!cold) return;
+    strncpy(cold, name ? name : "", GULI_RESOURCE_NAME_MAX - 1);
+    cold[GULI_RESOURCE_NAME_MAX - 1] = '\0';
+}
+
+const char* GuliTextureGetName(const GuliTexture* texture)
+{
+    const char* cold = texture ? GuliPoolGetCold(&G_TexturePool, texture->_handle) : NULL;
+    return cold ? cold : "";
+}
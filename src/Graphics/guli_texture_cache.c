@@ -0,0 +1,328 @@
+#include "Graphics/guli_texture_cache.h"
+#include "Core/guli_image.h"
+#include "Core/guli_hash.h"
+#include "Core/guli_job.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* -----------------------------------------------------------------------------
+ * Texture cache container (.gtc)
+ *
+ *   [GtcHeader][source path bytes] ... pad ... [level 0 @ 4 KiB][level 1 @ 64 B] ...
+ *
+ * Level 0 starts on a page boundary so uploads read directly from mapped pages.
+ * ----------------------------------------------------------------------------- */
+
+#define GTC_MAGIC 0x31435447u  /* "GTC1" */
+#define GTC_VERSION 1u
+#define GTC_PAGE_ALIGN 4096u
+#define GTC_LEVEL_ALIGN 64u
+#define GTC_MAX_LEVELS 16
+#define GTC_MAX_DIMENSION 65536u  /* bounds level sizes so the layout arithmetic cannot overflow */
+#define GTC_FORMAT_RGBA8 0u
+#define GTC_PATH_MAX 4096
+#define GTC_PARALLEL_MIN_PIXELS (256 * 256)
+
+#if defined(__APPLE__)
+#define GTC_MTIME_NSEC(st) ((int64_t)(st).st_mtimespec.tv_nsec)
+#else
+#define GTC_MTIME_NSEC(st) ((int64_t)(st).st_mtim.tv_nsec)
+#endif
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t levels;
+    uint32_t flags;
+    uint32_t path_length;
+    uint64_t source_size;
+    int64_t source_mtime_sec;
+    int64_t source_mtime_nsec;
+    uint64_t file_size;
+    uint64_t level_offset[GTC_MAX_LEVELS];
+    uint64_t level_size[GTC_MAX_LEVELS];
+} GtcHeader;
+
+struct GuliTextureCache {
+    char dir[GTC_PATH_MAX];
+    GuliTextureCacheStats stats;
+};
+
+static uint64_t GtcAlignUp(uint64_t v, uint64_t a)
+{
+    return (v + a - 1) & ~(a - 1);
+}
+
+static int GtcLevelCount(int width, int height, unsigned int flags)
+{
+    if (!(flags & GULI_TEXTURE_CACHE_MIPMAPS)) return 1;
+    int levels = 1;
+    while ((width > 1 || height > 1) && levels < GTC_MAX_LEVELS)
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels++;
+    }
+    return levels;
+}
+
+/* Fill header level table and return the total file size. */
+static uint64_t GtcLayout(GtcHeader* h)
+{
+    uint64_t offset = GtcAlignUp(sizeof(GtcHeader) + h->path_length, GTC_PAGE_ALIGN);
+    for (uint32_t i = 0; i < h->levels; i++)
+    {
+        const uint64_t lw = (h->width >> i) > 0 ? (h->width >> i) : 1;
+        const uint64_t lh = (h->height >> i) > 0 ? (h->height >> i) : 1;
+        h->level_offset[i] = offset;
+        h->level_size[i] = lw * lh * 4;
+        offset = GtcAlignUp(offset + h->level_size[i], GTC_LEVEL_ALIGN);
+    }
+    return offset;
+}
+
+typedef struct {
+    const unsigned char* src;
+    int sw, sh;
+    unsigned char* dst;
+    int dw;
+} GtcDownsampleJob;
+
+/* 2x2 box filter over rows [begin, end), clamping at odd edges. */
+static void GtcDownsampleRows(void* user, size_t begin, size_t end)
+{
+    const GtcDownsampleJob* j = (const GtcDownsampleJob*)user;
+    const unsigned char* src = j->src;
+    const int sw = j->sw, sh = j->sh, dw = j->dw;
+    for (int y = (int)begin; y < (int)end; y++)
+    {
+        const int y0 = y * 2 < sh ? y * 2 : sh - 1;
+        const int y1 = y * 2 + 1 < sh ? y * 2 + 1 : sh - 1;
+        for (int x = 0; x < dw; x++)
+        {
+            const int x0 = x * 2 < sw ? x * 2 : sw - 1;
+            const int x1 = x * 2 + 1 < sw ? x * 2 + 1 : sw - 1;
+            const unsigned char* a = src + ((size_t)y0 * sw + x0) * 4;
+            const unsigned char* b = src + ((size_t)y0 * sw + x1) * 4;
+            const unsigned char* c = src + ((size_t)y1 * sw + x0) * 4;
+            const unsigned char* d = src + ((size_t)y1 * sw + x1) * 4;
+            unsigned char* o = j->dst + ((size_t)y * dw + x) * 4;
+            for (int ch = 0; ch < 4; ch++)
+                o[ch] = (unsigned char)((a[ch] + b[ch] + c[ch] + d[ch] + 2) >> 2);
+        }
+    }
+}
+
+static void GtcDownsample(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh)
+{
+    GtcDownsampleJob j = { src, sw, sh, dst, dw };
+    /* Small levels are cheaper to filter inline than to fan out. */
+    if ((size_t)dw * (size_t)dh < GTC_PARALLEL_MIN_PIXELS)
+        GtcDownsampleRows(&j, 0, (size_t)dh);
+    else
+        GuliParallelFor((size_t)dh, 0, GtcDownsampleRows, &j);
+}
+
+static void GtcEntryPath(const GuliTextureCache* cache, const char* key, unsigned int flags, char* out, size_t size)
+{
+    const uint64_t h = GuliHashFNV1a64(key, strlen(key));
+    snprintf(out, size, "%s/%016llx_%x.gtc", cache->dir, (unsigned long long)h, flags);
+}
+
+/* Map a cache entry and upload it if it matches the source. Returns NULL on miss or stale entry. */
+static GuliTexture* GtcTryLoad(GuliTextureCache* cache, const char* entryPath, const char* key,
+    const struct stat* src, unsigned int flags, int* stale)
+{
+    int fd = open(entryPath, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GtcHeader))
+    {
+        close(fd);
+        *stale = 1;
+        return NULL;
+    }
+
+    const size_t mapSize = (size_t)st.st_size;
+    void* map = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return NULL;
+
+    const GtcHeader* h = (const GtcHeader*)map;
+    const size_t keyLen = strlen(key);
+    int valid = h->magic == GTC_MAGIC && h->version == GTC_VERSION && h->format == GTC_FORMAT_RGBA8 &&
+        h->flags == flags && h->levels >= 1 && h->levels <= GTC_MAX_LEVELS &&
+        h->file_size == mapSize && h->path_length == keyLen &&
+        sizeof(GtcHeader) + keyLen <= mapSize &&
+        memcmp((const char*)map + sizeof(GtcHeader), key, keyLen) == 0 &&
+        h->source_size == (uint64_t)src->st_size &&
+        h->source_mtime_sec == (int64_t)src->st_mtime &&
+        h->source_mtime_nsec == GTC_MTIME_NSEC(*src);
+
+    /* The level table must be exactly the layout GtcBuild writes for these dimensions */
+    valid = valid && h->width >= 1 && h->width <= GTC_MAX_DIMENSION &&
+        h->height >= 1 && h->height <= GTC_MAX_DIMENSION &&
+        h->levels == (uint32_t)GtcLevelCount((int)h->width, (int)h->height, flags);
+    GtcHeader expect;
+    if (valid)
+    {
+        memcpy(&expect, h, sizeof(expect));
+        valid = GtcLayout(&expect) == mapSize;
+    }
+
+    const unsigned char* levels[GTC_MAX_LEVELS];
+    for (uint32_t i = 0; valid && i < h->levels; i++)
+    {
+        if (h->level_offset[i] != expect.level_offset[i] || h->level_size[i] != expect.level_size[i] ||
+            h->level_offset[i] + h->level_size[i] > mapSize)
+            valid = 0;
+        levels[i] = (const unsigned char*)map + h->level_offset[i];
+    }
+
+    GuliTexture* tex = NULL;
+    if (valid)
+    {
+        madvise(map, mapSize, MADV_WILLNEED);
+        tex = GuliTextureCreateFromLevels((int)h->width, (int)h->height, (int)h->levels, levels);
+        if (tex) cache->stats.bytes_mapped += mapSize;
+    }
+    else
+    {
+        *stale = 1;
+    }
+
+    munmap(map, mapSize);
+    return tex;
+}
+
+/* Decode the source, write a new entry (atomically via rename) and upload from the built image. */
+static GuliTexture* GtcBuild(const char* entryPath, const char* key, const struct stat* src, unsigned int flags)
+{
+    GuliImage img = GuliImageLoadFromFile(key);
+    if (!img.data) return NULL;
+
+    GtcHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = GTC_MAGIC;
+    h.version = GTC_VERSION;
+    h.width = (uint32_t)img.width;
+    h.height = (uint32_t)img.height;
+    h.format = GTC_FORMAT_RGBA8;
+    h.levels = (uint32_t)GtcLevelCount(img.width, img.height, flags);
+    h.flags = flags;
+    h.path_length = (uint32_t)strlen(key);
+    h.source_size = (uint64_t)src->st_size;
+    h.source_mtime_sec = (int64_t)src->st_mtime;
+    h.source_mtime_nsec = GTC_MTIME_NSEC(*src);
+    h.file_size = GtcLayout(&h);
+
+    unsigned char* file = (unsigned char*)GuliCalloc(1, (size_t)h.file_size);
+    if (!file)
+    {
+        GuliImageFree(&img);
+        return NULL;
+    }
+
+    memcpy(file, &h, sizeof(h));
+    memcpy(file + sizeof(h), key, h.path_length);
+    memcpy(file + h.level_offset[0], img.data, (size_t)h.level_size[0]);
+    GuliImageFree(&img);
+
+    const unsigned char* levels[GTC_MAX_LEVELS];
+    levels[0] = file + h.level_offset[0];
+    for (uint32_t i = 1; i < h.levels; i++)
+    {
+        const int sw = (int)(h.width >> (i - 1)) > 0 ? (int)(h.width >> (i - 1)) : 1;
+        const int sh = (int)(h.height >> (i - 1)) > 0 ? (int)(h.height >> (i - 1)) : 1;
+        const int dw = (int)(h.width >> i) > 0 ? (int)(h.width >> i) : 1;
+        const int dh = (int)(h.height >> i) > 0 ? (int)(h.height >> i) : 1;
+        GtcDownsample(levels[i - 1], sw, sh, file + h.level_offset[i], dw, dh);
+        levels[i] = file + h.level_offset[i];
+    }
+
+    char tmpPath[GTC_PATH_MAX + 128];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%ld.tmp", entryPath, (long)getpid());
+    FILE* out = fopen(tmpPath, "wb");
+    if (out)
+    {
+        const size_t n = fwrite(file, 1, (size_t)h.file_size, out);
+        const int closed = fclose(out) == 0;
+        if (n != h.file_size || !closed || rename(tmpPath, entryPath) != 0)
+            remove(tmpPath);
+    }
+
+    GuliTexture* tex = GuliTextureCreateFromLevels((int)h.width, (int)h.height, (int)h.levels, levels);
+    GuliFree(file);
+    return tex;
+}
+
+GuliTextureCache* GuliTextureCacheOpen(const char* dir)
+{
+    if (!dir || !dir[0] || strlen(dir) >= GTC_PATH_MAX - 64) return NULL;
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+    {
+        GULI_PRINT_ERROR(GULI_ERROR_FAILED, "Failed to create texture cache directory");
+        return NULL;
+    }
+
+    GuliTextureCache* cache = (GuliTextureCache*)GuliCalloc(1, sizeof(GuliTextureCache));
+    if (!cache) return NULL;
+    strcpy(cache->dir, dir);
+    return cache;
+}
+
+void GuliTextureCacheClose(GuliTextureCache* cache)
+{
+    GuliFree(cache);
+}
+
+GuliTexture* GuliTextureCacheLoad(GuliTextureCache* cache, const char* path, unsigned int flags)
+{
+    if (!path) return NULL;
+    if (!cache) return GuliTextureLoadFromFile(path);
+
+    char key[PATH_MAX];
+    if (!realpath(path, key)) return NULL;
+
+    struct stat src;
+    if (stat(key, &src) != 0) return NULL;
+
+    char entryPath[GTC_PATH_MAX + 64];
+    GtcEntryPath(cache, key, flags, entryPath, sizeof(entryPath));
+
+    int stale = 0;
+    GuliTexture* tex = GtcTryLoad(cache, entryPath, key, &src, flags, &stale);
+    if (tex)
+    {
+        cache->stats.hits++;
+        return tex;
+    }
+
+    if (stale) cache->stats.stale++;
+    else cache->stats.misses++;
+    return GtcBuild(entryPath, key, &src, flags);
+}
+
+void GuliTextureCacheGetStats(const GuliTextureCache* cache, GuliTextureCacheStats* stats)
+{
+    if (!stats) return;
+    if (!cache)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = cache->stats;
+}